@@ -0,0 +1,76 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "cache/cache.hpp"
+#include "cache/gdfs_cache.hpp"
+#include "cache/lru_k_cache.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Mimics the SQLPhysicalPlanCache: query strings map to shared plans. There are more distinct queries than the cache
+// can hold, so that the lookups are a mix of hits and misses (followed by a set()).
+constexpr auto CACHE_CAPACITY = size_t{1'024};
+constexpr auto QUERY_COUNT = size_t{1'536};
+
+using BenchmarkValue = std::shared_ptr<int>;
+using BenchmarkCache = Cache<BenchmarkValue, std::string>;
+
+}  // namespace
+
+namespace opossum {
+
+/**
+ * Measures the throughput of concurrent cache lookups. Each thread looks up queries in a different order and adds the
+ * missing ones. With a single shard, all threads contend for one mutex, as they did before the Cache was sharded.
+ */
+template <typename CacheImpl, size_t max_shard_count>
+static void BM_CacheConcurrentLookup(benchmark::State& state) {  // NOLINT
+  static auto cache = std::unique_ptr<BenchmarkCache>{};
+  static auto queries = std::vector<std::string>{};
+  static const auto value = std::make_shared<int>(42);
+
+  if (state.thread_index == 0) {
+    cache = std::make_unique<BenchmarkCache>(CACHE_CAPACITY, max_shard_count);
+    cache->replace_cache_impl<CacheImpl>(CACHE_CAPACITY);
+
+    queries.clear();
+    for (auto query_id = size_t{0}; query_id < QUERY_COUNT; ++query_id) {
+      queries.emplace_back("SELECT * FROM table_" + std::to_string(query_id % 16) + " WHERE a = " +
+                           std::to_string(query_id));
+      if (query_id < CACHE_CAPACITY) cache->set(queries.back(), value);
+    }
+  }
+
+  // All threads wait for the setup before entering the loop
+  auto query_id = static_cast<size_t>(state.thread_index) * 7'919;
+  for (auto _ : state) {
+    const auto& query = queries[query_id % QUERY_COUNT];
+    query_id += 31;
+
+    auto cached_value = cache->try_get(query);
+    if (!cached_value) cache->set(query, value);
+    benchmark::DoNotOptimize(cached_value);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_CacheConcurrentLookup, GDFSCache<std::string, BenchmarkValue>, 1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CacheConcurrentLookup, GDFSCache<std::string, BenchmarkValue>, 16)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CacheConcurrentLookup, LRUKCache<2, std::string, BenchmarkValue>, 1)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CacheConcurrentLookup, LRUKCache<2, std::string, BenchmarkValue>, 16)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace opossum
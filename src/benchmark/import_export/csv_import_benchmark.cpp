@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "../micro_benchmark_basic_fixture.hpp"
+#include "benchmark/benchmark.h"
+#include "import_export/csv_meta.hpp"
+#include "import_export/csv_parser.hpp"
+#include "operators/export_csv.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+void benchmark_csv_import_impl(benchmark::State& state, const std::shared_ptr<const AbstractOperator>& in) {
+  // Write the input table to a temporary file, so that the benchmark only measures the import
+  const auto filename = std::string{"csv_import_benchmark.csv"};
+  std::make_shared<ExportCsv>(in, filename)->execute();
+
+  std::ifstream file{filename, std::ios::binary | std::ios::ate};
+  const auto file_size = static_cast<int64_t>(file.tellg());
+  file.close();
+
+  for (auto _ : state) {
+    const auto table = CsvParser{}.parse(filename);
+    benchmark::DoNotOptimize(table);
+  }
+
+  // Reports the throughput in bytes per second
+  state.SetBytesProcessed(state.iterations() * file_size);
+
+  std::remove(filename.c_str());
+  std::remove((filename + CsvMeta::META_FILE_EXTENSION).c_str());
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_CsvImport_Ints)(benchmark::State& state) {
+  _clear_cache();
+  benchmark_csv_import_impl(state, _table_wrapper_a);
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_CsvImport_Lineitem)(benchmark::State& state) {
+  _clear_cache();
+
+  // lineitem contains quoted strings, floats, and ints
+  const auto lineitem_wrapper =
+      std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/tpch/sf-0.001/lineitem.tbl"));
+  lineitem_wrapper->execute();
+
+  benchmark_csv_import_impl(state, lineitem_wrapper);
+}
+
+}  // namespace opossum
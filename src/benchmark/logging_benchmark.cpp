@@ -0,0 +1,106 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "tpcc/tpcc_table_generator.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+const auto LOG_FILE_PATH = std::string{"logging_benchmark.log"};
+
+// Each New-Order transaction inserts one NEW_ORDER row and (on average) ten ORDER_LINE rows
+constexpr auto ORDER_LINES_PER_ORDER = size_t{10};
+
+// Returns a TableWrapper for the first @param row_count rows of @param table
+std::shared_ptr<TableWrapper> create_rows_to_insert(const std::shared_ptr<const Table>& table, const size_t row_count) {
+  const auto rows = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+  const auto chunk = table->get_chunk(ChunkID{0});
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    auto values = std::vector<AllTypeVariant>{};
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      values.emplace_back((*chunk->get_segment(column_id))[chunk_offset]);
+    }
+    rows->append(values);
+  }
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(rows);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+}  // namespace
+
+namespace opossum {
+
+/**
+ * Measures the throughput of the inserts of TPC-C's New-Order transaction with and without the redo log. As each
+ * thread waits for its commit, the time per iteration is the commit latency. With more threads, more transactions
+ * share an fsync (group commit).
+ */
+static void BM_TpccNewOrderInserts(benchmark::State& state) {  // NOLINT
+  static auto new_order_rows = std::shared_ptr<TableWrapper>{};
+  static auto order_line_rows = std::shared_ptr<TableWrapper>{};
+  const auto use_logging = state.range(0) != 0;
+
+  if (state.thread_index == 0) {
+    auto& storage_manager = StorageManager::get();
+    if (!storage_manager.has_table("NEW_ORDER")) {
+      auto table_generator = TpccTableGenerator{};
+      const auto order_line_counts = table_generator.generate_order_line_counts();
+      storage_manager.add_table("NEW_ORDER", table_generator.generate_new_order_table());
+      storage_manager.add_table("ORDER_LINE", table_generator.generate_order_line_table(order_line_counts));
+
+      new_order_rows = create_rows_to_insert(storage_manager.get_table("NEW_ORDER"), 1);
+      order_line_rows = create_rows_to_insert(storage_manager.get_table("ORDER_LINE"), ORDER_LINES_PER_ORDER);
+    }
+
+    if (use_logging) {
+      std::remove(LOG_FILE_PATH.c_str());
+      Logger::get().enable(LOG_FILE_PATH);
+    }
+  }
+
+  // All threads wait for the setup before entering the loop
+  for (auto _ : state) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+
+    const auto new_order_insert = std::make_shared<Insert>("NEW_ORDER", new_order_rows);
+    new_order_insert->set_transaction_context(transaction_context);
+    new_order_insert->execute();
+
+    const auto order_line_insert = std::make_shared<Insert>("ORDER_LINE", order_line_rows);
+    order_line_insert->set_transaction_context(transaction_context);
+    order_line_insert->execute();
+
+    transaction_context->commit();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index == 0 && use_logging) {
+    auto& logger = Logger::get();
+    state.counters["log_bytes"] = benchmark::Counter(static_cast<double>(logger.written_bytes()),
+                                                     benchmark::Counter::kIsRate);
+    state.counters["fsyncs"] = benchmark::Counter(static_cast<double>(logger.flush_count()),
+                                                  benchmark::Counter::kIsRate);
+
+    logger.disable();
+    std::remove(LOG_FILE_PATH.c_str());
+  }
+}
+
+BENCHMARK(BM_TpccNewOrderInserts)->Arg(0)->Arg(1)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace opossum
@@ -5,7 +5,9 @@
 #include "expression/expression_functional.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 #include "table_generator.hpp"
 #include "utils/load_table.hpp"
 
@@ -13,6 +15,36 @@ using namespace opossum::expression_functional;  // NOLINT
 
 namespace opossum {
 
+namespace {
+
+/**
+ * Creates a single integer column of 1'000'000 rows in chunks of 100'000 rows. The values form runs of RUN_LENGTH
+ * rows and ascend within each chunk, so that run-length encoding has runs to exploit and frame-of-reference blocks
+ * have distinct minima.
+ */
+std::shared_ptr<TableWrapper> create_table_with_runs(const EncodingType encoding_type) {
+  constexpr auto ROW_COUNT = 1'000'000;
+  constexpr auto CHUNK_SIZE = 100'000;
+  constexpr auto RUN_LENGTH = 16;
+
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  for (auto chunk_begin = 0; chunk_begin < ROW_COUNT; chunk_begin += CHUNK_SIZE) {
+    auto values = pmr_concurrent_vector<int32_t>(CHUNK_SIZE);
+    for (auto row = 0; row < CHUNK_SIZE; ++row) {
+      values[row] = row / RUN_LENGTH;
+    }
+    table->append_chunk({std::make_shared<ValueSegment<int32_t>>(std::move(values))});
+  }
+
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{encoding_type});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+}  // namespace
+
 void benchmark_tablescan_impl(benchmark::State& state, const std::shared_ptr<const AbstractOperator> in,
                               ColumnID left_column_id, const PredicateCondition predicate_condition,
                               const AllParameterVariant right_parameter) {
@@ -58,6 +90,24 @@ BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScanVariable_OnDict)(benchmark::
   benchmark_tablescan_impl(state, _table_dict_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, ColumnID{1});
 }
 
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScanConstant_OnRunLength)(benchmark::State& state) {
+  _clear_cache();
+  const auto table_wrapper = create_table_with_runs(EncodingType::RunLength);
+  benchmark_tablescan_impl(state, table_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, 3'125);
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScanConstant_OnFrameOfReference)(benchmark::State& state) {
+  _clear_cache();
+  const auto table_wrapper = create_table_with_runs(EncodingType::FrameOfReference);
+  benchmark_tablescan_impl(state, table_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, 3'125);
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScanConstant_OnRunsUnencoded)(benchmark::State& state) {
+  _clear_cache();
+  const auto table_wrapper = create_table_with_runs(EncodingType::Unencoded);
+  benchmark_tablescan_impl(state, table_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, 3'125);
+}
+
 BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScan_Like)(benchmark::State& state) {
   const auto lineitem_table = load_table("resources/test_data/tbl/tpch/sf-0.001/lineitem.tbl");
 
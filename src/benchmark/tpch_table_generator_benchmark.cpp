@@ -1,5 +1,11 @@
+#include <memory>
+
 #include "benchmark/benchmark.h"
 
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/storage_manager.hpp"
 #include "tpch/tpch_table_generator.hpp"
 
@@ -18,4 +24,31 @@ static void BM_TpchTableGenerator(benchmark::State& state) {  // NOLINT
 }
 BENCHMARK(BM_TpchTableGenerator);
 
+/**
+ * Measures how fast the generated (unencoded) TPC-H tables are dictionary-encoded by ChunkEncoder::encode_all_chunks.
+ * The generation itself is not timed. The throughput is reported in rows per second.
+ */
+static void BM_TpchTableEncoding(benchmark::State& state) {  // NOLINT
+  Topology::use_default_topology();
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto row_count = int64_t{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    const auto table_info_by_name = TpchTableGenerator(0.5f, 100'000).generate();
+    state.ResumeTiming();
+
+    for (const auto& [table_name, table_info] : table_info_by_name) {
+      ChunkEncoder::encode_all_chunks(table_info.table, SegmentEncodingSpec{EncodingType::Dictionary});
+      row_count += static_cast<int64_t>(table_info.table->row_count());
+    }
+  }
+
+  state.SetItemsProcessed(row_count);
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+BENCHMARK(BM_TpchTableEncoding)->UseRealTime();
+
 }  // namespace opossum
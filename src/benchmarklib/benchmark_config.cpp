@@ -7,7 +7,8 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode benchmark_mode, const Chunk
                                  const Duration& max_duration, const Duration& warmup_duration, const UseMvcc use_mvcc,
                                  const std::optional<std::string>& output_file_path, const bool enable_scheduler,
                                  const uint32_t cores, const uint32_t clients, const bool enable_visualization,
-                                 const bool verify, const bool cache_binary_tables)
+                                 const bool verify, const bool cache_binary_tables, const bool output_time_series,
+                                 const bool use_jit, const bool use_morsel_pipelines)
     : benchmark_mode(benchmark_mode),
       chunk_size(chunk_size),
       encoding_config(encoding_config),
@@ -21,7 +22,10 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode benchmark_mode, const Chunk
       clients(clients),
       enable_visualization(enable_visualization),
       verify(verify),
-      cache_binary_tables(cache_binary_tables) {}
+      cache_binary_tables(cache_binary_tables),
+      output_time_series(output_time_series),
+      use_jit(use_jit),
+      use_morsel_pipelines(use_morsel_pipelines) {}
 
 BenchmarkConfig BenchmarkConfig::get_default_config() { return BenchmarkConfig(); }
 
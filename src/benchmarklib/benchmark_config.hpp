@@ -24,7 +24,8 @@ class BenchmarkConfig {
                   const Duration& warmup_duration, const UseMvcc use_mvcc,
                   const std::optional<std::string>& output_file_path, const bool enable_scheduler, const uint32_t cores,
                   const uint32_t clients, const bool enable_visualization, const bool verify,
-                  const bool cache_binary_tables);
+                  const bool cache_binary_tables, const bool output_time_series, const bool use_jit,
+                  const bool use_morsel_pipelines);
 
   static BenchmarkConfig get_default_config();
 
@@ -42,6 +43,9 @@ class BenchmarkConfig {
   bool enable_visualization = false;
   bool verify = false;
   bool cache_binary_tables = false;
+  bool output_time_series = false;
+  bool use_jit = false;
+  bool use_morsel_pipelines = false;
 
   static const char* description;
 
@@ -9,6 +9,8 @@
 #include "benchmark_runner.hpp"
 #include "benchmark_state.hpp"
 #include "constant_mappings.hpp"
+#include "logical_query_plan/jit_aware_lqp_translator.hpp"
+#include "logical_query_plan/morsel_aware_lqp_translator.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "sql/create_sql_parser_error_message.hpp"
 #include "sql/sql_pipeline_builder.hpp"
@@ -97,6 +99,14 @@ void BenchmarkRunner::run() {
   _query_plans.resize(available_queries_count);
   _query_results.resize(available_queries_count);
 
+  if (_config.output_time_series) {
+    // Queries only add their results while the benchmark (of the query) has not exceeded its maximum duration
+    const auto max_duration_seconds = std::chrono::ceil<std::chrono::seconds>(_config.max_duration).count() + 1;
+    for (auto& query_result : _query_results) {
+      query_result.iterations_per_second = std::vector<std::atomic<size_t>>(max_duration_seconds);
+    }
+  }
+
   auto benchmark_start = std::chrono::steady_clock::now();
 
   // Run the queries in the selected mode
@@ -193,7 +203,7 @@ void BenchmarkRunner::_benchmark_permuted_query_set() {
 
         // The on_query_done callback will be appended to the last Task of the query,
         // to measure its duration as well as signal that the query was finished
-        const auto query_run_begin = std::chrono::steady_clock::now();
+        const auto query_run_begin = std::chrono::high_resolution_clock::now();
         auto on_query_done = [pipeline, query_id, number_of_queries, query_run_begin, &currently_running_clients,
                               &finished_query_set_runs, &finished_queries_total, &state, this]() {
           if (finished_queries_total++ % number_of_queries == 0) {
@@ -202,10 +212,11 @@ void BenchmarkRunner::_benchmark_permuted_query_set() {
           }
 
           if (!state.is_done()) {  // To prevent queries to add their results after the time is up
-            const auto duration = std::chrono::steady_clock::now() - query_run_begin;
+            const auto duration = std::chrono::high_resolution_clock::now() - query_run_begin;
             auto& result = _query_results[query_id];
             result.duration_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
             result.metrics.push_back(pipeline->metrics());
+            _record_query_run(result, *pipeline, query_run_begin, state);
             result.num_iterations++;
           }
         };
@@ -250,11 +261,13 @@ void BenchmarkRunner::_benchmark_individual_queries() {
 
         // The on_query_done callback will be appended to the last Task of the query,
         // to measure its duration as well as signal that the query was finished
-        auto on_query_done = [pipeline, &currently_running_clients, &result, &state]() {
+        const auto query_run_begin = std::chrono::high_resolution_clock::now();
+        auto on_query_done = [pipeline, query_run_begin, &currently_running_clients, &result, &state, this]() {
           currently_running_clients--;
           if (!state.is_done()) {  // To prevent queries to add their results after the time is up
             result.num_iterations++;
             result.metrics.push_back(pipeline->metrics());
+            _record_query_run(result, *pipeline, query_run_begin, state);
           }
         };
 
@@ -272,6 +285,9 @@ void BenchmarkRunner::_benchmark_individual_queries() {
 
     std::cout << "  -> Executed " << result.num_iterations << " times in " << duration_seconds << " seconds ("
               << items_per_second << " iter/s)" << std::endl;
+    std::cout << "  -> Latency p50: " << format_duration(result.latency_histogram.percentile(50))
+              << ", p99: " << format_duration(result.latency_histogram.percentile(99))
+              << ", p99.9: " << format_duration(result.latency_histogram.percentile(99.9)) << std::endl;
 
     // Wait for the rest of the tasks that didn't make it in time - they will not count toward the results
     // TODO(leander/anyone): To be replaced with something like CurrentScheduler::abort(),
@@ -339,6 +355,10 @@ std::vector<std::shared_ptr<AbstractTask>> BenchmarkRunner::_schedule_query(
   auto tasks_per_statement = pipeline->get_tasks();
   tasks_per_statement.back().back()->set_done_callback(done_callback);
 
+  // The plans are read by the done_callback (see _record_query_run()), which might run on another thread. Thus, the
+  // pipeline's lazily initialized list of plans has to be initialized before the tasks are scheduled.
+  pipeline->get_physical_plans();
+
   for (auto tasks : tasks_per_statement) {
     CurrentScheduler::schedule_tasks(tasks);
     query_tasks.insert(query_tasks.end(), tasks.begin(), tasks.end());
@@ -397,6 +417,20 @@ void BenchmarkRunner::_execute_query(const QueryID query_id, const std::shared_p
   _store_plan(query_id, *pipeline);
 }
 
+void BenchmarkRunner::_record_query_run(QueryBenchmarkResult& result, SQLPipeline& pipeline,
+                                        const TimePoint query_run_begin, const BenchmarkState& state) const {
+  const auto query_run_end = std::chrono::high_resolution_clock::now();
+  const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(query_run_end - query_run_begin);
+  result.latency_histogram.record(latency);
+  result.add_operator_walltimes(pipeline.get_physical_plans());
+
+  if (_config.output_time_series) {
+    const auto second = static_cast<size_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(query_run_end - state.benchmark_begin).count());
+    if (second < result.iterations_per_second.size()) ++result.iterations_per_second[second];
+  }
+}
+
 void BenchmarkRunner::_store_plan(const QueryID query_id, SQLPipeline& pipeline) {
   if (_config.enable_visualization) {
     if (_query_plans[query_id].lqps.empty()) {
@@ -447,11 +481,37 @@ void BenchmarkRunner::_create_report(std::ostream& stream) const {
       all_pipeline_metrics_json.push_back(pipeline_metrics_json);
     }
 
+    const auto& latency_histogram = query_result.latency_histogram;
+    // clang-format off
+    const auto latency_percentiles_json = nlohmann::json{
+      {"p50", latency_histogram.percentile(50).count()},
+      {"p90", latency_histogram.percentile(90).count()},
+      {"p99", latency_histogram.percentile(99).count()},
+      {"p999", latency_histogram.percentile(99.9).count()},
+      {"max", latency_histogram.max().count()}
+    };
+    // clang-format on
+
+    auto operator_walltimes_json = nlohmann::json::object();
+    for (const auto& [operator_name, walltime] : query_result.operator_walltimes) {
+      operator_walltimes_json[operator_name] = walltime.count();
+    }
+
     nlohmann::json benchmark{{"name", name},
                              {"iterations", query_result.num_iterations.load()},
                              {"metrics", all_pipeline_metrics_json},
                              {"avg_real_time_per_iteration", time_per_query},
-                             {"items_per_second", items_per_second}};
+                             {"items_per_second", items_per_second},
+                             {"latency_percentiles", latency_percentiles_json},
+                             {"operator_walltimes", operator_walltimes_json}};
+
+    if (_config.output_time_series) {
+      // Omit the seconds after the last iteration finished
+      auto iterations_per_second = std::vector<size_t>(query_result.iterations_per_second.begin(),
+                                                       query_result.iterations_per_second.end());
+      while (!iterations_per_second.empty() && iterations_per_second.back() == 0) iterations_per_second.pop_back();
+      benchmark["iterations_per_second"] = iterations_per_second;
+    }
 
     if (_config.verify) {
       Assert(query_result.verification_passed, "Verification should have been performed");
@@ -486,6 +546,14 @@ std::shared_ptr<SQLPipeline> BenchmarkRunner::_build_sql_pipeline(const QueryID
   if (_config.enable_visualization) {
     pipeline_builder.dont_cleanup_temporaries();
   }
+#if HYRISE_JIT_SUPPORT
+  if (_config.use_jit) {
+    pipeline_builder.with_lqp_translator(std::make_shared<JitAwareLQPTranslator>());
+  }
+#endif
+  if (_config.use_morsel_pipelines) {
+    pipeline_builder.with_lqp_translator(std::make_shared<MorselAwareLQPTranslator>());
+  }
 
   return std::make_shared<SQLPipeline>(pipeline_builder.create_pipeline());
 }
@@ -519,7 +587,10 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
     ("mvcc", "Enable MVCC", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("visualize", "Create a visualization image of one LQP and PQP for each query", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("verify", "Verify each query by comparing it with the SQLite result", cxxopts::value<bool>()->default_value("false")) // NOLINT
-    ("cache_binary_tables", "Cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("cache_binary_tables", "Cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("time_series", "Add the number of executions per second of each query to the output", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("jit", "Execute the queries with JIT operator pipelines (requires JIT support)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("morsel_pipelines", "Execute chains of scans, validates and projections morsel by morsel", cxxopts::value<bool>()->default_value("false")); // NOLINT
   // clang-format on
 
   return cli_options;
@@ -560,6 +631,9 @@ nlohmann::json BenchmarkRunner::create_context(const BenchmarkConfig& config) {
       {"cores", config.cores},
       {"clients", config.clients},
       {"verify", config.verify},
+      {"time_series", config.output_time_series},
+      {"using_jit", config.use_jit},
+      {"using_morsel_pipelines", config.use_morsel_pipelines},
       {"time_unit", "ns"},
       {"GIT-HASH", GIT_HEAD_SHA1 + std::string(GIT_IS_DIRTY ? "-dirty" : "")}};
 }
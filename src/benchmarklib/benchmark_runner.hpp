@@ -13,6 +13,7 @@
 
 #include "abstract_query_generator.hpp"
 #include "abstract_table_generator.hpp"
+#include "benchmark_state.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "operators/abstract_operator.hpp"
 #include "query_benchmark_result.hpp"
@@ -65,6 +66,10 @@ class BenchmarkRunner {
   void _execute_query(const QueryID query_id, const std::shared_ptr<SQLPipeline>& pipeline,
                       const std::function<void()>& done_callback);
 
+  // Records the latency, the operator walltimes, and (if enabled) the completion time of a finished query run
+  void _record_query_run(QueryBenchmarkResult& result, SQLPipeline& pipeline, const TimePoint query_run_begin,
+                         const BenchmarkState& state) const;
+
   // If visualization is enabled, stores an executed plan
   void _store_plan(const QueryID query_id, SQLPipeline& pipeline);
 
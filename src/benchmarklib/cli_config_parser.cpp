@@ -130,10 +130,25 @@ BenchmarkConfig CLIConfigParser::parse_basic_options_json_config(const nlohmann:
     std::cout << "- Not caching tables as binary files" << std::endl;
   }
 
+  const auto output_time_series = json_config.value("time_series", default_config.output_time_series);
+  if (output_time_series) {
+    std::cout << "- Writing the number of executions per second to the results" << std::endl;
+  }
+
+  const auto use_jit = json_config.value("jit", default_config.use_jit);
+#if !HYRISE_JIT_SUPPORT
+  Assert(!use_jit, "'--jit' specified, but Hyrise was built without JIT support");
+#endif
+  std::cout << "- JIT is " << (use_jit ? "enabled" : "disabled") << std::endl;
+
+  const auto use_morsel_pipelines = json_config.value("morsel_pipelines", default_config.use_morsel_pipelines);
+  Assert(!use_jit || !use_morsel_pipelines, "'--jit' and '--morsel_pipelines' cannot be combined");
+  std::cout << "- Morsel pipelines are " << (use_morsel_pipelines ? "enabled" : "disabled") << std::endl;
+
   return BenchmarkConfig{
-      benchmark_mode, chunk_size,         *encoding_config, max_runs, timeout_duration, warmup_duration,
-      use_mvcc,       output_file_path,   enable_scheduler, cores,    clients,          enable_visualization,
-      verify,         cache_binary_tables};
+      benchmark_mode, chunk_size,          *encoding_config,   max_runs, timeout_duration, warmup_duration,
+      use_mvcc,       output_file_path,    enable_scheduler,   cores,    clients,          enable_visualization,
+      verify,         cache_binary_tables, output_time_series, use_jit,  use_morsel_pipelines};
 }
 
 BenchmarkConfig CLIConfigParser::parse_basic_cli_options(const cxxopts::ParseResult& parse_result) {
@@ -158,6 +173,9 @@ nlohmann::json CLIConfigParser::basic_cli_options_to_json(const cxxopts::ParseRe
   json_config.emplace("output", parse_result["output"].as<std::string>());
   json_config.emplace("verify", parse_result["verify"].as<bool>());
   json_config.emplace("cache_binary_tables", parse_result["cache_binary_tables"].as<bool>());
+  json_config.emplace("time_series", parse_result["time_series"].as<bool>());
+  json_config.emplace("jit", parse_result["jit"].as<bool>());
+  json_config.emplace("morsel_pipelines", parse_result["morsel_pipelines"].as<bool>());
 
   return json_config;
 }
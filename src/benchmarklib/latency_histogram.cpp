@@ -0,0 +1,75 @@
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Values below SUB_BUCKET_COUNT get one bucket each. Above, each of the remaining powers of two gets SUB_BUCKET_COUNT
+// buckets.
+LatencyHistogram::LatencyHistogram() : _bucket_counts(SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS + 1)) {}
+
+void LatencyHistogram::record(const std::chrono::nanoseconds latency) {
+  const auto value = static_cast<uint64_t>(std::max(latency.count(), std::chrono::nanoseconds::rep{0}));
+  _bucket_counts[_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const {
+  auto count = uint64_t{0};
+  for (const auto& bucket_count : _bucket_counts) {
+    count += bucket_count.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(const double percentile) const {
+  Assert(percentile >= 0.0 && percentile <= 100.0, "Percentile must be in [0, 100]");
+
+  const auto total_count = count();
+  if (total_count == 0) return std::chrono::nanoseconds{0};
+
+  // The rank of the latency at the percentile, starting at 1
+  const auto rank =
+      std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count))));
+
+  auto seen_count = uint64_t{0};
+  for (auto bucket_index = size_t{0}; bucket_index < _bucket_counts.size(); ++bucket_index) {
+    seen_count += _bucket_counts[bucket_index].load(std::memory_order_relaxed);
+    if (seen_count >= rank) return std::chrono::nanoseconds{_bucket_upper_bound(bucket_index)};
+  }
+
+  // Latencies were recorded concurrently after count() was called
+  return max();
+}
+
+std::chrono::nanoseconds LatencyHistogram::max() const {
+  for (auto bucket_index = _bucket_counts.size(); bucket_index > 0; --bucket_index) {
+    if (_bucket_counts[bucket_index - 1].load(std::memory_order_relaxed) > 0) {
+      return std::chrono::nanoseconds{_bucket_upper_bound(bucket_index - 1)};
+    }
+  }
+  return std::chrono::nanoseconds{0};
+}
+
+size_t LatencyHistogram::_bucket_index(const uint64_t value) {
+  if (value < SUB_BUCKET_COUNT) return value;
+
+  // For values in [2^(SUB_BUCKET_BITS + shift), 2^(SUB_BUCKET_BITS + shift + 1)), the lowest `shift` bits are dropped
+  const auto highest_bit = static_cast<uint64_t>(63 - __builtin_clzll(value));
+  const auto shift = highest_bit - SUB_BUCKET_BITS;
+  const auto sub_bucket = (value >> shift) - SUB_BUCKET_COUNT;
+  return SUB_BUCKET_COUNT * (shift + 1) + sub_bucket;
+}
+
+uint64_t LatencyHistogram::_bucket_upper_bound(const size_t bucket_index) {
+  if (bucket_index < SUB_BUCKET_COUNT) return bucket_index;
+
+  const auto shift = bucket_index / SUB_BUCKET_COUNT - 1;
+  const auto sub_bucket = bucket_index % SUB_BUCKET_COUNT;
+  const auto lower_bound = (SUB_BUCKET_COUNT + sub_bucket) << shift;
+  return lower_bound + ((uint64_t{1} << shift) - 1);
+}
+
+}  // namespace opossum
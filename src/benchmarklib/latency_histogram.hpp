@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Records latencies in a histogram with logarithmically growing buckets, similar to an HDR histogram. Each power of
+ * two is split into 2^SUB_BUCKET_BITS linear sub-buckets, so that percentiles are reported with a relative error of
+ * less than 2^-SUB_BUCKET_BITS (< 1%), independent of the magnitude of the latencies and with constant memory.
+ *
+ * record() is thread-safe, so that concurrently running clients can record their latencies. Reading percentiles while
+ * latencies are recorded is safe, but might not include the latest values.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr auto SUB_BUCKET_BITS = uint64_t{7};
+  static constexpr auto SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+
+  LatencyHistogram();
+
+  void record(const std::chrono::nanoseconds latency);
+
+  uint64_t count() const;
+
+  /**
+   * @param percentile  in [0, 100], e.g., 99.9
+   * @return the upper bound of the bucket that holds the latency at @param percentile, or 0 if nothing was recorded
+   */
+  std::chrono::nanoseconds percentile(const double percentile) const;
+
+  std::chrono::nanoseconds max() const;
+
+ private:
+  friend class LatencyHistogramTest;
+
+  static size_t _bucket_index(const uint64_t value);
+  static uint64_t _bucket_upper_bound(const size_t bucket_index);
+
+  std::vector<std::atomic<uint64_t>> _bucket_counts;
+};
+
+}  // namespace opossum
@@ -1,14 +1,44 @@
 #include "query_benchmark_result.hpp"
 
+#include <unordered_set>
+
+#include "operators/abstract_operator.hpp"
+
 namespace opossum {
 
 QueryBenchmarkResult::QueryBenchmarkResult() { metrics.reserve(1'000'000); }
 
-QueryBenchmarkResult::QueryBenchmarkResult(QueryBenchmarkResult&& other) noexcept {
+QueryBenchmarkResult::QueryBenchmarkResult(QueryBenchmarkResult&& other) noexcept
+    : latency_histogram(std::move(other.latency_histogram)),
+      operator_walltimes(std::move(other.operator_walltimes)),
+      iterations_per_second(std::move(other.iterations_per_second)) {
   num_iterations.store(other.num_iterations);
   duration_ns.store(other.duration_ns);
   metrics = other.metrics;
   verification_passed = other.verification_passed;
 }
 
+void QueryBenchmarkResult::add_operator_walltimes(
+    const std::vector<std::shared_ptr<AbstractOperator>>& physical_plans) {
+  auto walltimes = std::map<std::string, std::chrono::nanoseconds>{};
+
+  // Operators can be the input of multiple operators (e.g., in diamond-shaped plans), but were only executed once
+  auto visited_operators = std::unordered_set<const AbstractOperator*>{};
+  auto operators = std::vector<std::shared_ptr<const AbstractOperator>>{physical_plans.begin(), physical_plans.end()};
+  while (!operators.empty()) {
+    const auto op = operators.back();
+    operators.pop_back();
+    if (!op || !visited_operators.emplace(op.get()).second) continue;
+
+    walltimes[op->name()] += op->performance_data().walltime;
+    operators.emplace_back(op->input_left());
+    operators.emplace_back(op->input_right());
+  }
+
+  std::lock_guard<std::mutex> lock(_operator_walltimes_mutex);
+  for (const auto& [name, walltime] : walltimes) {
+    operator_walltimes[name] += walltime;
+  }
+}
+
 }  // namespace opossum
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "sql/sql_pipeline.hpp"
 
 #include "benchmark_config.hpp"
+#include "latency_histogram.hpp"
 
 namespace opossum {
 
@@ -14,6 +20,9 @@ struct QueryBenchmarkResult {
   QueryBenchmarkResult(QueryBenchmarkResult&& other) noexcept;
   QueryBenchmarkResult& operator=(QueryBenchmarkResult&&) = default;
 
+  // Adds the walltimes of the operators in the executed plans to operator_walltimes. Thread-safe.
+  void add_operator_walltimes(const std::vector<std::shared_ptr<AbstractOperator>>& physical_plans);
+
   std::atomic<size_t> num_iterations = 0;
 
   // Using uint64_t instead of std::chrono to be able to use fetch_add()
@@ -21,7 +30,20 @@ struct QueryBenchmarkResult {
 
   tbb::concurrent_vector<SQLPipelineMetrics> metrics;
 
+  // Latency of each iteration, from scheduling the query until its last task finished
+  LatencyHistogram latency_histogram;
+
+  // Summed walltimes of all iterations per operator name (e.g., "JoinHash")
+  std::map<std::string, std::chrono::nanoseconds> operator_walltimes;
+
+  // Number of iterations that finished in each second since the start of the benchmark (of this query in
+  // IndividualQueries mode). Only filled if BenchmarkConfig::output_time_series is set.
+  std::vector<std::atomic<size_t>> iterations_per_second;
+
   std::optional<bool> verification_passed;
+
+ private:
+  std::mutex _operator_walltimes_mutex;
 };
 
 }  // namespace opossum
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -16,73 +18,205 @@ namespace opossum {
 inline constexpr size_t DefaultCacheCapacity = 1024;
 
 // Per-default, uses the GDFS cache as underlying storage.
+//
+// To allow concurrent accesses (e.g., by many clients looking up their query plans) without contending for a single
+// mutex, the entries are distributed across shards by the hash of their keys. Each shard is an independent cache
+// (using the same policy) with its own mutex and an equal share of the capacity. Thus, the eviction policy is applied
+// per shard, which approximates applying it to the entire cache. Small caches are not sharded, so that they behave
+// exactly like their underlying policy.
+//
+// set(), try_get(), has(), get_entry(), clear(), and size() are thread-safe. resize(), replace_cache_impl(), and
+// iterating over the cache must not be called concurrently to any other method.
 template <typename Value, typename Key = std::string>
 class Cache : public Singleton<Cache<Value, Key>> {
  public:
   using Iterator = typename AbstractCacheImpl<Key, Value>::ErasedIterator;
 
-  explicit Cache(size_t capacity = DefaultCacheCapacity)
-      : _impl(std::move(std::make_unique<GDFSCache<Key, Value>>(capacity))) {}
+  // Each shard holds at least this many entries. Caches with a smaller capacity have a single shard.
+  static constexpr auto MIN_SHARD_CAPACITY = size_t{64};
+  static constexpr auto DEFAULT_MAX_SHARD_COUNT = size_t{16};
+
+  explicit Cache(size_t capacity = DefaultCacheCapacity, size_t max_shard_count = DEFAULT_MAX_SHARD_COUNT)
+      : _max_shard_count(max_shard_count),
+        _make_impl([](const size_t shard_capacity) {
+          return std::make_unique<GDFSCache<Key, Value>>(shard_capacity);
+        }) {
+    _create_shards(capacity);
+  }
 
   virtual ~Cache() {}
 
-  // Adds or refreshes the cache entry [query, value].
-  void set(const Key& query, const Value& value) {
-    if (_impl->capacity() == 0) return;
+  // Adds or refreshes the cache entry [query, value]. Cost and size are used by cost-aware policies (e.g., GDFS) to
+  // prefer evicting entries that are cheap to recreate or large.
+  void set(const Key& query, const Value& value, double cost = 1.0, double size = 1.0) {
+    auto& shard = _shard(query);
+    if (shard.impl->capacity() == 0) return;
 
-    std::lock_guard<std::mutex> lock(_mutex);
-    _impl->set(query, value);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.impl->set(query, value, cost, size);
   }
 
   // Tries to fetch the cache entry for the query into the result object.
   // Returns true if the entry was found, false otherwise.
   std::optional<Value> try_get(const Key& query) {
-    if (_impl->capacity() == 0) return {};
+    auto& shard = _shard(query);
+    if (shard.impl->capacity() == 0) return {};
 
-    std::lock_guard<std::mutex> lock(_mutex);
-    if (!_impl->has(query)) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!shard.impl->has(query)) {
       return {};
     }
-    return _impl->get(query);
+    return shard.impl->get(query);
   }
 
   // Checks whether an entry for the query exists.
-  bool has(const Key& query) const { return _impl->has(query); }
+  bool has(const Key& query) const {
+    const auto& shard = _shard(query);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.impl->has(query);
+  }
 
   // Returns and refreshes the cache entry for the given query.
   // Causes undefined behavior if the query is not in the cache.
   Value get_entry(const Key& query) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _impl->get(query);
+    auto& shard = _shard(query);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.impl->get(query);
   }
 
   // Purges all entries from the cache.
-  void clear() { _impl->clear(); }
+  void clear() {
+    for (auto& shard : _shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->impl->clear();
+    }
+  }
 
-  void resize(size_t capacity) { _impl->resize(capacity); }
+  // Resizes the cache. If the number of shards changes, the entries are moved to the new shards, but their access
+  // statistics (e.g., the frequencies in GDFS) are lost.
+  void resize(size_t capacity) {
+    if (_shard_count(capacity) == _shards.size()) {
+      for (auto shard_id = size_t{0}; shard_id < _shards.size(); ++shard_id) {
+        _shards[shard_id]->impl->resize(_shard_capacity(capacity, shard_id));
+      }
+      _capacity = capacity;
+      return;
+    }
 
-  size_t size() const { return _impl->size(); }
+    auto old_shards = std::move(_shards);
+    _create_shards(capacity);
 
-  // Returns a reference to the underlying cache.
-  AbstractCacheImpl<Key, Value>& cache() { return *_impl; }
-  const AbstractCacheImpl<Key, Value>& cache() const { return *_impl; }
+    for (const auto& old_shard : old_shards) {
+      for (auto iter = old_shard->impl->begin(), end = old_shard->impl->end(); iter != end; ++iter) {
+        set(iter->first, iter->second);
+      }
+    }
+  }
 
-  // Replaces the underlying cache by creating a new object
+  size_t size() const {
+    auto size = size_t{0};
+    for (const auto& shard : _shards) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->impl->size();
+    }
+    return size;
+  }
+
+  size_t capacity() const { return _capacity; }
+
+  size_t shard_count() const { return _shards.size(); }
+
+  // Replaces the underlying caches by creating new objects
   // of the given cache type.
   template <class cache_t>
   void replace_cache_impl(size_t capacity) {
-    _impl = std::make_unique<cache_t>(capacity);
+    _make_impl = [](const size_t shard_capacity) { return std::make_unique<cache_t>(shard_capacity); };
+    _create_shards(capacity);
   }
 
-  Iterator begin() { return _impl->begin(); }
+  Iterator begin() { return Iterator{std::make_unique<ShardedIterator>(_shards, 0)}; }
 
-  Iterator end() { return _impl->end(); }
+  Iterator end() { return Iterator{std::make_unique<ShardedIterator>(_shards, _shards.size())}; }
 
  protected:
-  // Underlying cache eviction strategy.
-  std::unique_ptr<AbstractCacheImpl<Key, Value>> _impl;
+  struct Shard {
+    // Underlying cache eviction strategy.
+    std::unique_ptr<AbstractCacheImpl<Key, Value>> impl;
+
+    mutable std::mutex mutex;
+  };
+
+  using Shards = std::vector<std::unique_ptr<Shard>>;
+
+  // Iterates over the entries of all shards
+  class ShardedIterator : public AbstractCacheImpl<Key, Value>::AbstractIterator {
+   public:
+    using KeyValuePair = typename AbstractCacheImpl<Key, Value>::KeyValuePair;
+    using AbstractIterator = typename AbstractCacheImpl<Key, Value>::AbstractIterator;
+
+    ShardedIterator(const Shards& shards, const size_t shard_id) : _shards(shards), _shard_id(shard_id) {
+      _skip_exhausted_shards();
+    }
+
+    void increment() override {
+      ++*_shard_iterator;
+      _skip_exhausted_shards();
+    }
+
+    bool equal(const AbstractIterator& other) const override {
+      const auto& other_iterator = static_cast<const ShardedIterator&>(other);
+      if (_shard_id != other_iterator._shard_id) return false;
+      return _shard_id == _shards.size() || *_shard_iterator == *other_iterator._shard_iterator;
+    }
+
+    const KeyValuePair& dereference() const override { return **_shard_iterator; }
+
+   private:
+    void _skip_exhausted_shards() {
+      while (_shard_id < _shards.size()) {
+        if (!_shard_iterator) _shard_iterator.emplace(_shards[_shard_id]->impl->begin());
+        if (*_shard_iterator != _shards[_shard_id]->impl->end()) return;
+
+        ++_shard_id;
+        _shard_iterator.reset();
+      }
+    }
+
+    const Shards& _shards;
+    size_t _shard_id;
+    std::optional<Iterator> _shard_iterator;
+  };
+
+  size_t _shard_count(const size_t capacity) const {
+    return std::clamp(capacity / MIN_SHARD_CAPACITY, size_t{1}, std::max(_max_shard_count, size_t{1}));
+  }
+
+  // Distributes the capacity evenly across the shards
+  size_t _shard_capacity(const size_t capacity, const size_t shard_id) const {
+    return capacity / _shards.size() + (shard_id < capacity % _shards.size() ? 1 : 0);
+  }
+
+  void _create_shards(const size_t capacity) {
+    _capacity = capacity;
+    _shards.clear();
+    _shards.resize(_shard_count(capacity));
+    for (auto shard_id = size_t{0}; shard_id < _shards.size(); ++shard_id) {
+      _shards[shard_id] = std::make_unique<Shard>();
+      _shards[shard_id]->impl = _make_impl(_shard_capacity(capacity, shard_id));
+    }
+  }
+
+  Shard& _shard(const Key& key) { return *_shards[std::hash<Key>{}(key) % _shards.size()]; }
+
+  const Shard& _shard(const Key& key) const { return *_shards[std::hash<Key>{}(key) % _shards.size()]; }
+
+  const size_t _max_shard_count;
+  size_t _capacity{0};
+
+  // Creates the underlying cache of a shard with the given capacity
+  std::function<std::unique_ptr<AbstractCacheImpl<Key, Value>>(size_t)> _make_impl;
 
-  std::mutex _mutex;
+  Shards _shards;
 };
 
 }  // namespace opossum
@@ -10,6 +10,7 @@
 namespace opossum {
 
 // Generic cache implementation using the GDFS policy.
+// The priority of an entry is inflation + frequency * cost / size.
 // Note: This implementation is not thread-safe.
 template <typename Key, typename Value>
 class GDFSCache : public AbstractCacheImpl<Key, Value> {
@@ -19,6 +20,7 @@ class GDFSCache : public AbstractCacheImpl<Key, Value> {
     Key key;
     Value value;
     size_t frequency;
+    double cost;
     double size;
     double priority;
 
@@ -69,9 +71,10 @@ class GDFSCache : public AbstractCacheImpl<Key, Value> {
 
       GDFSCacheEntry& entry = (*handle);
       entry.value = value;
+      entry.cost = cost;
       entry.size = size;
       entry.frequency++;
-      entry.priority = _inflation + entry.frequency / entry.size;
+      entry.priority = _inflation + entry.frequency * entry.cost / entry.size;
       _queue.update(handle);
 
       return;
@@ -87,8 +90,8 @@ class GDFSCache : public AbstractCacheImpl<Key, Value> {
     }
 
     // Insert new item in cache.
-    GDFSCacheEntry entry{key, value, 1, size, 0.0};
-    entry.priority = _inflation + entry.frequency / entry.size;
+    GDFSCacheEntry entry{key, value, 1, cost, size, 0.0};
+    entry.priority = _inflation + entry.frequency * entry.cost / entry.size;
     Handle handle = _queue.push(entry);
     _map[key] = handle;
   }
@@ -98,7 +101,7 @@ class GDFSCache : public AbstractCacheImpl<Key, Value> {
     Handle handle = it->second;
     GDFSCacheEntry& entry = (*handle);
     entry.frequency++;
-    entry.priority = _inflation + entry.frequency / entry.size;
+    entry.priority = _inflation + entry.frequency * entry.cost / entry.size;
     _queue.update(handle);
     return entry.value;
   }
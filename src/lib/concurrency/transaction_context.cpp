@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "commit_context.hpp"
+#include "logging/logger.hpp"
 #include "operators/abstract_read_write_operator.hpp"
 #include "transaction_manager.hpp"
 #include "utils/assert.hpp"
@@ -11,12 +12,16 @@
 namespace opossum {
 
 TransactionContext::TransactionContext(const TransactionID transaction_id, const CommitID snapshot_commit_id)
+    : TransactionContext{transaction_id, snapshot_commit_id,
+                         TransactionManager::get()._register_transaction(snapshot_commit_id)} {}
+
+TransactionContext::TransactionContext(const TransactionID transaction_id, const CommitID snapshot_commit_id,
+                                       const size_t snapshot_slot_id)
     : _transaction_id{transaction_id},
       _snapshot_commit_id{snapshot_commit_id},
+      _snapshot_slot_id{snapshot_slot_id},
       _phase{TransactionPhase::Active},
-      _num_active_operators{0} {
-  TransactionManager::get()._register_transaction(snapshot_commit_id);
-}
+      _num_active_operators{0} {}
 
 TransactionContext::~TransactionContext() {
   DebugAssert(([this]() {
@@ -46,7 +51,7 @@ TransactionContext::~TransactionContext() {
    * Tell the TransactionManager, which keeps track of active snapshot-commit-ids,
    * that this transaction has finished.
    */
-  TransactionManager::get()._deregister_transaction(_snapshot_commit_id);
+  TransactionManager::get()._deregister_transaction(_snapshot_slot_id, _snapshot_commit_id);
 }
 
 TransactionID TransactionContext::transaction_id() const { return _transaction_id; }
@@ -87,6 +92,15 @@ bool TransactionContext::commit_async(const std::function<void(TransactionID)>&
     op->commit_records(commit_id());
   }
 
+  // With logging, the transaction only becomes visible (and its callback is only called) once its changes are durable
+  auto& logger = Logger::get();
+  if (logger.is_enabled() && !_rw_operators.empty()) {
+    logger.log_commit(_transaction_id, commit_id(), [context = shared_from_this(), callback]() {
+      context->_mark_as_pending_and_try_commit(callback);
+    });
+    return true;
+  }
+
   _mark_as_pending_and_try_commit(callback);
 
   return true;
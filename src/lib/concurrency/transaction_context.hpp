@@ -52,6 +52,12 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
 
  public:
   TransactionContext(TransactionID transaction_id, CommitID snapshot_commit_id);
+
+  /**
+   * Used by the TransactionManager, which has already registered the snapshot-commit-id in the slot
+   * @param snapshot_slot_id. The slot is released when the context is destroyed.
+   */
+  TransactionContext(TransactionID transaction_id, CommitID snapshot_commit_id, size_t snapshot_slot_id);
   ~TransactionContext();
 
   /**
@@ -92,7 +98,8 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
   /**
    * Commits the transaction.
    *
-   * @param callback called when transaction is actually committed
+   * @param callback called when transaction is actually committed (if the Logger is enabled, this is after its changes
+   *                 were written to the log)
    * @return false if called a second time
    */
   bool commit_async(const std::function<void(TransactionID)>& callback);
@@ -174,6 +181,7 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
  private:
   const TransactionID _transaction_id;
   const CommitID _snapshot_commit_id;
+  const size_t _snapshot_slot_id;
 
   std::vector<std::shared_ptr<AbstractReadWriteOperator>> _rw_operators;
 
@@ -1,5 +1,7 @@
 #include "transaction_manager.hpp"
 
+#include <algorithm>
+
 #include "commit_context.hpp"
 #include "storage/mvcc_data.hpp"
 #include "transaction_context.hpp"
@@ -12,7 +14,7 @@ void TransactionManager::reset() {
   manager._next_transaction_id = INITIAL_TRANSACTION_ID;
   manager._last_commit_id = INITIAL_COMMIT_ID;
   manager._last_commit_context = std::make_shared<CommitContext>(INITIAL_COMMIT_ID);
-  Assert(manager._active_snapshot_commit_ids.empty(),
+  Assert(manager._active_transaction_count() == 0,
          "Some transactions do not seem to have finished yet as they are still registered as active.")
 }
 
@@ -23,41 +25,89 @@ TransactionManager::TransactionManager()
 
 CommitID TransactionManager::last_commit_id() const { return _last_commit_id; }
 
-std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context() {
-  const TransactionID snapshot_commit_id = _last_commit_id;
-  return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id);
+void TransactionManager::restore_last_commit_id(const CommitID last_commit_id) {
+  Assert(_active_transaction_count() == 0, "Cannot restore the last commit id while transactions are active");
+  _last_commit_id = last_commit_id;
+  _last_commit_context = std::make_shared<CommitContext>(last_commit_id);
 }
 
-void TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-  _active_snapshot_commit_ids.insert(snapshot_commit_id);
+std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context() {
+  auto snapshot_commit_id = CommitID{_last_commit_id};
+  auto snapshot_slot_id = _register_transaction(snapshot_commit_id);
+
+  // If a transaction committed between reading the last commit id and publishing it as our snapshot-commit-id, a
+  // concurrent call to get_lowest_active_snapshot_commit_id() might have missed our snapshot and considered data that
+  // it still needs to be obsolete. Once the last commit id did not change after publishing, this cannot happen.
+  while (_last_commit_id != snapshot_commit_id) {
+    _deregister_transaction(snapshot_slot_id, snapshot_commit_id);
+    snapshot_commit_id = _last_commit_id;
+    snapshot_slot_id = _register_transaction(snapshot_commit_id);
+  }
+
+  return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id, snapshot_slot_id);
 }
 
-void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+size_t TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
+  DebugAssert(snapshot_commit_id != FREE_SNAPSHOT_SLOT, "Invalid snapshot-commit-id");
+
+  // Each thread prefers a different slot, so that the slots are (usually) not shared between threads
+  thread_local const auto preferred_snapshot_slot_id = _next_preferred_snapshot_slot_id++ % SNAPSHOT_SLOT_COUNT;
 
-  auto it = std::find(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end(), snapshot_commit_id);
+  for (auto probe_count = size_t{0}; probe_count < SNAPSHOT_SLOT_COUNT; ++probe_count) {
+    const auto snapshot_slot_id = (preferred_snapshot_slot_id + probe_count) % SNAPSHOT_SLOT_COUNT;
+    auto& slot = _snapshot_slots[snapshot_slot_id].snapshot_commit_id;
 
-  if (it != _active_snapshot_commit_ids.end()) {
-    _active_snapshot_commit_ids.erase(it);
+    auto expected = FREE_SNAPSHOT_SLOT;
+    if (slot.load(std::memory_order_relaxed) == expected && slot.compare_exchange_strong(expected, snapshot_commit_id)) {
+      return snapshot_slot_id;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+  _overflow_snapshot_commit_ids.insert(snapshot_commit_id);
+  ++_overflow_snapshot_commit_id_count;
+  return OVERFLOW_SNAPSHOT_SLOT_ID;
+}
+
+void TransactionManager::_deregister_transaction(const size_t snapshot_slot_id, const CommitID snapshot_commit_id) {
+  if (snapshot_slot_id != OVERFLOW_SNAPSHOT_SLOT_ID) {
+    auto& slot = _snapshot_slots[snapshot_slot_id].snapshot_commit_id;
+    Assert(slot.load() == snapshot_commit_id, "Snapshot slot is not used by the deregistered transaction");
+    slot = FREE_SNAPSHOT_SLOT;
     return;
   }
 
-  Assert(
-      it == _active_snapshot_commit_ids.end(),
-      "Could not find snapshot_commit_id in TransactionManager's _active_snapshot_commit_ids. Therefore, the removal "
-      "failed and the function should not have been called.");
+  std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+  const auto iter = _overflow_snapshot_commit_ids.find(snapshot_commit_id);
+  Assert(iter != _overflow_snapshot_commit_ids.end(),
+         "Could not find snapshot_commit_id in TransactionManager's _overflow_snapshot_commit_ids. Therefore, the "
+         "removal failed and the function should not have been called.");
+  _overflow_snapshot_commit_ids.erase(iter);
+  --_overflow_snapshot_commit_id_count;
+}
+
+size_t TransactionManager::_active_transaction_count() const {
+  const auto active_slot_count = std::count_if(_snapshot_slots.cbegin(), _snapshot_slots.cend(), [](const auto& slot) {
+    return slot.snapshot_commit_id != FREE_SNAPSHOT_SLOT;
+  });
+  return static_cast<size_t>(active_slot_count) + _overflow_snapshot_commit_id_count;
 }
 
 std::optional<CommitID> TransactionManager::get_lowest_active_snapshot_commit_id() const {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+  auto lowest_snapshot_commit_id = FREE_SNAPSHOT_SLOT;
+  for (const auto& slot : _snapshot_slots) {
+    lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, slot.snapshot_commit_id.load());
+  }
 
-  if (_active_snapshot_commit_ids.empty()) {
-    return std::nullopt;
+  if (_overflow_snapshot_commit_id_count > 0) {
+    std::lock_guard<std::mutex> lock(_mutex_overflow_snapshot_commit_ids);
+    for (const auto snapshot_commit_id : _overflow_snapshot_commit_ids) {
+      lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, snapshot_commit_id);
+    }
   }
 
-  auto it = std::min_element(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end());
-  return *it;
+  if (lowest_snapshot_commit_id == FREE_SNAPSHOT_SLOT) return std::nullopt;
+  return lowest_snapshot_commit_id;
 }
 
 /**
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 
 #include "types.hpp"
@@ -56,13 +59,20 @@ class TransactionManager : public Singleton<TransactionManager> {
 
   CommitID last_commit_id() const;
 
+  /**
+   * Used when the database is recovered from a checkpoint or log, so that the following transactions commit after the
+   * recovered ones. No transaction may be active.
+   */
+  void restore_last_commit_id(const CommitID last_commit_id);
+
   /**
    * Creates a new transaction context
    */
   std::shared_ptr<TransactionContext> new_transaction_context();
 
   /**
-   * Returns the lowest snapshot-commit-id currently used by a transaction.
+   * Returns the lowest snapshot-commit-id currently used by a transaction. This scans all snapshot slots (see below),
+   * so it is meant to be called by background tasks like the garbage collection, not once per transaction.
    */
   std::optional<CommitID> get_lowest_active_snapshot_commit_id() const;
 
@@ -82,13 +92,30 @@ class TransactionManager : public Singleton<TransactionManager> {
   void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
 
   /**
-   * The TransactionManager keeps track of issued snapshot-commit-ids,
-   * which are in use by unfinished transactions.
-   * The following two functions are used to keep the multiset of active
-   * snapshot-commit-ids up to date.
+   * The TransactionManager keeps track of issued snapshot-commit-ids, which are in use by unfinished transactions.
+   *
+   * Every transaction begins and ends by updating this information. To avoid a global point of contention, each
+   * snapshot-commit-id is published in one of many slots, each of which has its own cache line. A thread starts looking
+   * for a free slot at its preferred slot, so that threads do not compete for the same slots unless they run more
+   * transactions than there are slots. In the unlikely case that all slots are taken, the snapshot-commit-id is stored
+   * in a mutex-protected multiset instead.
+   *
+   * _register_transaction() returns the ID of the slot, which has to be passed to _deregister_transaction().
    */
-  void _register_transaction(CommitID snapshot_commit_id);
-  void _deregister_transaction(CommitID snapshot_commit_id);
+  size_t _register_transaction(CommitID snapshot_commit_id);
+  void _deregister_transaction(size_t snapshot_slot_id, CommitID snapshot_commit_id);
+
+  size_t _active_transaction_count() const;
+
+  static constexpr auto SNAPSHOT_SLOT_COUNT = size_t{1'024};
+  static constexpr auto OVERFLOW_SNAPSHOT_SLOT_ID = std::numeric_limits<size_t>::max();
+  // Marks a slot that is not used by any transaction. Being larger than any actual commit id, free slots do not have
+  // to be skipped when computing the lowest active snapshot-commit-id.
+  static constexpr auto FREE_SNAPSHOT_SLOT = std::numeric_limits<CommitID>::max();
+
+  struct alignas(64) SnapshotSlot {
+    std::atomic<CommitID> snapshot_commit_id{FREE_SNAPSHOT_SLOT};
+  };
 
   std::atomic<TransactionID> _next_transaction_id;
 
@@ -99,7 +126,11 @@ class TransactionManager : public Singleton<TransactionManager> {
 
   std::shared_ptr<CommitContext> _last_commit_context;
 
-  mutable std::mutex _mutex_active_snapshot_commit_ids;
-  std::unordered_multiset<CommitID> _active_snapshot_commit_ids;
+  std::array<SnapshotSlot, SNAPSHOT_SLOT_COUNT> _snapshot_slots;
+  std::atomic<size_t> _next_preferred_snapshot_slot_id{0};
+
+  mutable std::mutex _mutex_overflow_snapshot_commit_ids;
+  std::unordered_multiset<CommitID> _overflow_snapshot_commit_ids;
+  std::atomic<size_t> _overflow_snapshot_commit_id_count{0};
 };
 }  // namespace opossum
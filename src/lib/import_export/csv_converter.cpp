@@ -1,6 +1,7 @@
 #include "csv_converter.hpp"
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace opossum {
@@ -9,27 +10,26 @@ void BaseCsvConverter::unescape(std::string& field, const ParseConfig& config) {
   // String does not contain escaping if it is not surrounded with quotes
   if (field.empty() || field.front() != config.quote) return;
 
+  // The surrounding quotes are left out
+  const auto content = std::string_view{field}.substr(1, field.size() - 2);
+
   std::string unescaped_string;
-  unescaped_string.reserve(field.size());
-
-  // 'escaped' holds the information whether the previous character was the config.escape character
-  bool escaped = false;
-  // The start and end ranges leave out the surrounding quotes.
-  std::copy_if(field.begin() + 1, field.end() - 1, std::back_inserter(unescaped_string),
-               [&escaped, &config](const char c) {
-                 bool do_copy = true;
-
-                 // If escape character is found the first time, don't copy,
-                 // and set 'escaped' to true for the next character
-                 if (c == config.escape && !escaped) {
-                   do_copy = false;
-                   escaped = true;
-                 } else {
-                   escaped = false;
-                 }
-
-                 return do_copy;
-               });
+  unescaped_string.reserve(content.size());
+
+  // Instead of looking at each character, copy everything up to the next escape character at once. The escape
+  // character itself is dropped, the character following it is copied even if it is another escape character.
+  auto begin = size_t{0};
+  while (begin < content.size()) {
+    const auto escape_pos = content.find(config.escape, begin);
+    if (escape_pos == std::string_view::npos) {
+      unescaped_string.append(content.substr(begin));
+      break;
+    }
+
+    unescaped_string.append(content.substr(begin, escape_pos - begin));
+    if (escape_pos + 1 < content.size()) unescaped_string.push_back(content[escape_pos + 1]);
+    begin = escape_pos + 2;
+  }
 
   unescaped_string.shrink_to_fit();
   field = std::move(unescaped_string);
@@ -6,6 +6,7 @@
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -17,6 +18,84 @@
 
 namespace opossum {
 
+namespace detail {
+
+/*
+ * Fast paths for converting the most common number formats found in CSVs. They do not depend on the locale and do not
+ * allocate. If a field does not match the expected format, std::nullopt is returned and the caller falls back to the
+ * standard library functions, which also take care of reporting errors.
+ */
+
+// Handles an optional sign followed by 1 to MaxDigits digits. MaxDigits is chosen so that no overflow can occur.
+template <typename T, size_t MaxDigits>
+std::optional<T> parse_integer_fast_path(const std::string& str) {
+  auto iter = str.begin();
+  const auto negative = iter != str.end() && *iter == '-';
+  if (iter != str.end() && (*iter == '-' || *iter == '+')) ++iter;
+
+  const auto digit_count = static_cast<size_t>(str.end() - iter);
+  if (digit_count == 0 || digit_count > MaxDigits) return std::nullopt;
+
+  auto value = T{0};
+  for (; iter != str.end(); ++iter) {
+    const auto digit = static_cast<unsigned char>(*iter - '0');
+    if (digit > 9) return std::nullopt;
+    value = value * 10 + digit;
+  }
+
+  return negative ? -value : value;
+}
+
+/*
+ * Handles an optional sign followed by digits with an optional decimal point, without exponent. The fast path is only
+ * taken if both the digits (as an integer) and the power of ten that they need to be divided by are exactly
+ * representable in T. The result of the single division is then correctly rounded (see Clinger, "How to Read Floating
+ * Point Numbers Accurately").
+ */
+template <typename T>
+std::optional<T> parse_floating_point_fast_path(const std::string& str) {
+  // float: 10^7 < 2^24 and 10^10 are exactly representable, double: 10^15 < 2^53 and 10^22 are exactly representable
+  constexpr auto MAX_DIGITS = std::is_same_v<T, float> ? 7 : 15;
+  constexpr auto MAX_DECIMALS = std::is_same_v<T, float> ? 10 : 22;
+  constexpr T POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  auto iter = str.begin();
+  const auto negative = iter != str.end() && *iter == '-';
+  if (iter != str.end() && (*iter == '-' || *iter == '+')) ++iter;
+
+  auto mantissa = uint64_t{0};
+  auto has_digits = false;
+  auto digit_count = 0;
+  auto decimal_count = 0;
+  auto seen_decimal_point = false;
+  for (; iter != str.end(); ++iter) {
+    if (*iter == '.' && !seen_decimal_point) {
+      seen_decimal_point = true;
+      continue;
+    }
+
+    const auto digit = static_cast<unsigned char>(*iter - '0');
+    if (digit > 9) return std::nullopt;
+    has_digits = true;
+
+    // Leading zeros do not count towards the digits as they do not affect the mantissa
+    if (mantissa != 0 || digit != 0) ++digit_count;
+    if (seen_decimal_point) ++decimal_count;
+    if (digit_count > MAX_DIGITS || decimal_count > MAX_DECIMALS) return std::nullopt;
+
+    mantissa = mantissa * 10 + digit;
+  }
+
+  // Reject fields without any digit (e.g., "." or "-")
+  if (!has_digits) return std::nullopt;
+
+  const auto value = static_cast<T>(mantissa) / POWERS_OF_TEN[decimal_count];
+  return negative ? -value : value;
+}
+
+}  // namespace detail
+
 /*
  * CsvConverter is a helper class that creates a ValueSegment by converting the given null terminated strings and placing
  * them at the given position.
@@ -106,6 +185,8 @@ class CsvConverter : public BaseCsvConverter {
 template <>
 inline std::function<int32_t(const std::string&)> CsvConverter<int32_t>::_get_conversion_function() {
   return [](const std::string& str) {
+    if (const auto converted = opossum::detail::parse_integer_fast_path<int32_t, 9>(str)) return *converted;
+
     size_t pos;
     auto converted = std::stoi(str, &pos);
     Assert(pos == str.size(), "Unprocessed characters found while converting to int: " + str);
@@ -116,6 +197,8 @@ inline std::function<int32_t(const std::string&)> CsvConverter<int32_t>::_get_co
 template <>
 inline std::function<int64_t(const std::string&)> CsvConverter<int64_t>::_get_conversion_function() {
   return [](const std::string& str) {
+    if (const auto converted = opossum::detail::parse_integer_fast_path<int64_t, 18>(str)) return *converted;
+
     size_t pos;
     auto converted = static_cast<int64_t>(std::stoll(str, &pos));
     Assert(pos == str.size(), "Unprocessed characters found while converting to long: " + str);
@@ -126,6 +209,8 @@ inline std::function<int64_t(const std::string&)> CsvConverter<int64_t>::_get_co
 template <>
 inline std::function<float(const std::string&)> CsvConverter<float>::_get_conversion_function() {
   return [](const std::string& str) {
+    if (const auto converted = opossum::detail::parse_floating_point_fast_path<float>(str)) return *converted;
+
     size_t pos;
     auto converted = std::stof(str, &pos);
     Assert(pos == str.size(), "Unprocessed characters found while converting to float: " + str);
@@ -136,6 +221,8 @@ inline std::function<float(const std::string&)> CsvConverter<float>::_get_conver
 template <>
 inline std::function<double(const std::string&)> CsvConverter<double>::_get_conversion_function() {
   return [](const std::string& str) {
+    if (const auto converted = opossum::detail::parse_floating_point_fast_path<double>(str)) return *converted;
+
     size_t pos;
     auto converted = std::stod(str, &pos);
     Assert(pos == str.size(), "Unprocessed characters found while converting to double: " + str);
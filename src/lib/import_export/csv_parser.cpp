@@ -1,9 +1,9 @@
 #include "csv_parser.hpp"
 
 #include <boost/algorithm/string/trim.hpp>
+#include <algorithm>
 #include <fstream>
 #include <functional>
-#include <list>
 #include <memory>
 #include <optional>
 #include <string>
@@ -14,10 +14,12 @@
 #include "constant_mappings.hpp"
 #include "import_export/csv_converter.hpp"
 #include "import_export/csv_meta.hpp"
+#include "import_export/csv_structural_scanner.hpp"
 #include "resolve_type.hpp"
-#include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
+#include "scheduler/ordered_job_window.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/mvcc_data.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
@@ -25,8 +27,13 @@
 
 namespace opossum {
 
+CsvParser::CsvParser(const size_t window_size) : _window_size(window_size) {
+  Assert(_window_size > 0, "Window size must be greater than zero");
+}
+
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const std::optional<CsvMeta>& csv_meta,
-                                        const ChunkOffset chunk_size) {
+                                        const ChunkOffset chunk_size,
+                                        const std::optional<ChunkEncodingSpec>& encoding_spec) {
   // If no meta info is given as a parameter, look for a json file
   if (csv_meta == std::nullopt) {
     _meta = process_csv_meta_file(filename + CsvMeta::META_FILE_EXTENSION);
@@ -38,55 +45,75 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const std::
 
   auto table = _create_table_from_meta(chunk_size);
 
-  std::ifstream csvfile{filename};
+  if (encoding_spec) {
+    Assert(encoding_spec->size() == table->column_count(), "Number of encoding specs must match the column count");
+  }
+
+  std::ifstream csvfile{filename, std::ios::binary};
 
   // return empty table if input file is empty
   if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
 
-  /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
-   */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
-  csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
-
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != _meta.config.delimiter) content.push_back(_meta.config.delimiter);
-
-  std::string_view content_view{content.c_str(), content.size()};
-
-  // Save chunks in list to avoid memory relocation
-  std::list<Segments> segments_by_chunks;
-  std::vector<std::shared_ptr<AbstractTask>> tasks;
-  std::vector<size_t> field_ends;
-  while (_find_fields_in_chunk(content_view, *table, field_ends)) {
-    // create empty chunk
-    segments_by_chunks.emplace_back();
-    auto& segments = segments_by_chunks.back();
-
-    // Only pass the part of the string that is actually needed to the parsing task
-    std::string_view relevant_content = content_view.substr(0, field_ends.back());
-
-    // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
-
-    // create and start parsing task to fill chunk
-    tasks.emplace_back(std::make_shared<JobTask>([this, relevant_content, field_ends, &table, &segments]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments);
-    }));
-    tasks.back()->schedule();
-  }
+  const auto column_data_types = table->column_data_types();
+
+  // Each chunk is parsed (and encoded) by its own task. The chunks are appended to the table in the order of the csv
+  // rows. Limiting the number of chunks in flight keeps the memory used for unfinished chunks (and the windows they
+  // point into) independent of the file size.
+  auto pending_chunks =
+      OrderedJobWindow<std::shared_ptr<Chunk>>{[&](std::shared_ptr<Chunk>& chunk) { table->append_chunk(chunk); }};
+
+  const auto schedule_chunk = [&](const std::shared_ptr<const std::string>& window, std::string_view chunk_content) {
+    pending_chunks.add(nullptr, [&](std::shared_ptr<Chunk>& chunk) {
+      // The task keeps the window alive until the chunk has been parsed, the window is released with its last chunk.
+      return std::vector<std::shared_ptr<AbstractTask>>{std::make_shared<JobTask>(
+          [this, window, chunk_content, &table, &chunk, &column_data_types, &encoding_spec]() {
+            std::vector<size_t> field_ends;
+            _find_fields_in_chunk(chunk_content, *table, field_ends);
+
+            Segments segments;
+            const auto row_count = _parse_into_chunk(chunk_content, field_ends, *table, segments);
+
+            chunk = std::make_shared<Chunk>(segments, std::make_shared<MvccData>(row_count));
+            if (encoding_spec) {
+              ChunkEncoder::encode_chunk(chunk, column_data_types, *encoding_spec);
+            }
+          })};
+    });
+  };
+
+  // Bytes of the previous window that belong to a chunk that was not complete yet
+  auto remainder = std::string{};
+  auto end_of_file = false;
+
+  while (!end_of_file) {
+    auto window = std::make_shared<std::string>();
+    window->resize(remainder.size() + _window_size);
+    std::copy(remainder.begin(), remainder.end(), window->begin());
+    csvfile.read(window->data() + remainder.size(), static_cast<std::streamsize>(_window_size));
+    window->resize(remainder.size() + static_cast<size_t>(csvfile.gcount()));
+    end_of_file = !csvfile;
+
+    // make sure content ends with a delimiter for better row processing later
+    if (end_of_file && !window->empty() && window->back() != _meta.config.delimiter) {
+      window->push_back(_meta.config.delimiter);
+    }
 
-  CurrentScheduler::wait_for_tasks(tasks);
+    auto content_view = std::string_view{window->data(), window->size()};
+    while (const auto chunk_end = _find_chunk_end(content_view, *table)) {
+      schedule_chunk(window, content_view.substr(0, *chunk_end + 1));
+      content_view.remove_prefix(*chunk_end + 1);
+    }
 
-  for (auto& segments : segments_by_chunks) {
-    table->append_chunk(segments);
+    if (end_of_file) {
+      // The last chunk holds the remaining rows, which are less than max_chunk_size
+      if (!content_view.empty()) schedule_chunk(window, content_view);
+    } else {
+      remainder = std::string{content_view};
+    }
   }
 
+  pending_chunks.finish_all();
+
   return table;
 }
 
@@ -113,53 +140,46 @@ std::shared_ptr<Table> CsvParser::_create_table_from_meta(const ChunkOffset chun
   return std::make_shared<Table>(column_definitions, TableType::Data, chunk_size, UseMvcc::Yes);
 }
 
+std::optional<size_t> CsvParser::_find_chunk_end(std::string_view csv_content, const Table& table) const {
+  // A max_chunk_size of 0 means that all rows go into a single chunk
+  if (table.max_chunk_size() == 0) return std::nullopt;
+
+  // Only the delimiters are relevant for finding the end of a row, separators are handled by _find_fields_in_chunk()
+  // while parsing the chunk.
+  std::optional<size_t> chunk_end;
+  auto rows = size_t{0};
+  CsvStructuralScanner{_meta.config}.scan<false>(csv_content, [&](const size_t pos, const bool /*is_delimiter*/) {
+    if (++rows < table.max_chunk_size()) return true;
+
+    chunk_end = pos;
+    return false;
+  });
+
+  return chunk_end;
+}
+
 bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table& table,
-                                      std::vector<size_t>& field_ends) {
+                                      std::vector<size_t>& field_ends) const {
   field_ends.clear();
   if (csv_content.empty()) {
     return false;
   }
 
-  std::string search_for{_meta.config.separator, _meta.config.delimiter, _meta.config.quote};
-
-  size_t pos, from = 0;
   unsigned int rows = 0, field_count = 1;
-  bool in_quotes = false;
-  while (rows < table.max_chunk_size() || 0 == table.max_chunk_size()) {
-    // Find either of row separator, column delimiter, quote identifier
-    pos = csv_content.find_first_of(search_for, from);
-    if (std::string::npos == pos) {
-      break;
-    }
-    from = pos + 1;
-    const char elem = csv_content[pos];
-
-    // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
-    if (elem == _meta.config.quote) {
-      bool quote_is_escaped = false;
-      if (_meta.config.quote != _meta.config.escape) {
-        quote_is_escaped = pos != 0 && csv_content[pos - 1] == _meta.config.escape;
-      }
-      if (!quote_is_escaped) {
-        in_quotes = !in_quotes;
-      }
-    }
-
-    // Determine if delimiter marks end of row or is part of the (string) value
-    if (elem == _meta.config.delimiter && !in_quotes) {
+  CsvStructuralScanner{_meta.config}.scan<true>(csv_content, [&](const size_t pos, const bool is_delimiter) {
+    // Delimiters outside of quotes mark the end of a row, all other delimiters and separators are skipped by the
+    // scanner as they are part of a (string) value.
+    if (is_delimiter) {
       DebugAssert(field_count == table.column_count(), "Number of CSV fields does not match number of columns.");
       ++rows;
       field_count = 0;
     }
 
-    // Determine if separator marks end of field or is part of the (string) value
-    if (in_quotes || elem == _meta.config.quote) {
-      continue;
-    }
-
     ++field_count;
     field_ends.push_back(pos);
-  }
+
+    return rows < table.max_chunk_size() || 0 == table.max_chunk_size();
+  });
 
   return true;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv_meta.hpp"
+#include "storage/chunk_encoder.hpp"
 
 namespace opossum {
 
@@ -21,22 +22,33 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * This parser reads the csv file in windows of (at least) window_size bytes and separates each window into chunks that
+ * are aligned with the csv rows. Only the chunk boundaries are searched for sequentially, the fields of each chunk are
+ * found while parsing it. Each data chunk is parsed (and optionally encoded) by its own task and appended to the table
+ * as soon as it and all its predecessors are finished. The number of chunks in flight is bounded by the number of
+ * workers, so that the memory needed besides the resulting table is limited to a few windows and chunks per worker,
+ * regardless of the size of the csv file.
  */
 class CsvParser {
  public:
+  // Number of bytes read from the csv file at once. A window grows if a single chunk does not fit into it.
+  static constexpr size_t DEFAULT_WINDOW_SIZE = 64 * 1024 * 1024;
+
+  explicit CsvParser(const size_t window_size = DEFAULT_WINDOW_SIZE);
+
   // cannot move-assign because of const members
   CsvParser& operator=(CsvParser&&) = delete;
 
   /*
    * @param filename      Path to the input file.
    * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
+   * @param chunk_size    Maximum number of rows per chunk of the created table.
+   * @param encoding_spec Optional. If set, each chunk is encoded (and marked immutable) right after it was parsed.
    * @returns             The table that was created from the csv file.
    */
   std::shared_ptr<Table> parse(const std::string& filename, const std::optional<CsvMeta>& csv_meta = std::nullopt,
-                               const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
+                               const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
+                               const std::optional<ChunkEncodingSpec>& encoding_spec = std::nullopt);
   std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                      const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
@@ -46,6 +58,14 @@ class CsvParser {
    */
   std::shared_ptr<Table> _create_table_from_meta(const ChunkOffset chunk_size);
 
+  /*
+   * @param      csv_content String_view on the remaining content of the CSV, starting at the beginning of a row.
+   * @param      table       Empty table created by _process_meta_file.
+   * @returns                Position of the delimiter that ends the last row of the next chunk, or std::nullopt if
+   *                         \p csv_content holds less than max_chunk_size complete rows.
+   */
+  std::optional<size_t> _find_chunk_end(std::string_view csv_content, const Table& table) const;
+
   /*
    * @param      csv_content String_view on the remaining content of the CSV.
    * @param      table       Empty table created by _process_meta_file.
@@ -53,7 +73,7 @@ class CsvParser {
    * csv_content.
    * @returns                False if \p csv_content is empty or chunk_size set to 0, True otherwise.
    */
-  bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends);
+  bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends) const;
 
   /*
    * @param      csv_chunk  String_view on one chunk of the CSV.
@@ -70,6 +90,8 @@ class CsvParser {
    */
   void _sanitize_field(std::string& field);
 
+  const size_t _window_size;
+
   // CSV meta information like chunk_size, column information, delimitor/seperator characters, etc.
   CsvMeta _meta;
 
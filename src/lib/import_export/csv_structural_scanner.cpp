@@ -0,0 +1,82 @@
+#include "csv_structural_scanner.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
+namespace opossum {
+
+CsvStructuralScanner::CsvStructuralScanner(const ParseConfig& config) : _config(config) {}
+
+CsvStructuralScanner::BlockMasks CsvStructuralScanner::classify_block(const char* block, size_t length) const {
+  auto masks = BlockMasks{};
+
+#if defined(__AVX2__)
+  if (length == BLOCK_SIZE) {
+    const auto quote = _mm256_set1_epi8(_config.quote);
+    const auto escape = _mm256_set1_epi8(_config.escape);
+    const auto separator = _mm256_set1_epi8(_config.separator);
+    const auto delimiter = _mm256_set1_epi8(_config.delimiter);
+
+    for (auto offset = size_t{0}; offset < BLOCK_SIZE; offset += 32) {
+      const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+      const auto to_mask = [&](const __m256i& character) {
+        return uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, character)))} << offset;
+      };
+      masks.quotes |= to_mask(quote);
+      masks.escapes |= to_mask(escape);
+      masks.separators |= to_mask(separator);
+      masks.delimiters |= to_mask(delimiter);
+    }
+    return masks;
+  }
+#elif defined(__SSE2__)
+  if (length == BLOCK_SIZE) {
+    const auto quote = _mm_set1_epi8(_config.quote);
+    const auto escape = _mm_set1_epi8(_config.escape);
+    const auto separator = _mm_set1_epi8(_config.separator);
+    const auto delimiter = _mm_set1_epi8(_config.delimiter);
+
+    for (auto offset = size_t{0}; offset < BLOCK_SIZE; offset += 16) {
+      const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+      const auto to_mask = [&](const __m128i& character) {
+        return uint64_t{static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, character)))} << offset;
+      };
+      masks.quotes |= to_mask(quote);
+      masks.escapes |= to_mask(escape);
+      masks.separators |= to_mask(separator);
+      masks.delimiters |= to_mask(delimiter);
+    }
+    return masks;
+  }
+#endif
+
+  // Fallback for the last, incomplete block and for systems without SSE2
+  for (auto offset = size_t{0}; offset < length; ++offset) {
+    const auto character = block[offset];
+    masks.quotes |= uint64_t{character == _config.quote} << offset;
+    masks.escapes |= uint64_t{character == _config.escape} << offset;
+    masks.separators |= uint64_t{character == _config.separator} << offset;
+    masks.delimiters |= uint64_t{character == _config.delimiter} << offset;
+  }
+  return masks;
+}
+
+uint64_t CsvStructuralScanner::prefix_xor(uint64_t mask) {
+#if defined(__PCLMUL__)
+  // A carry-less multiplication with all ones computes the prefix XOR in a single instruction
+  const auto all_ones = _mm_set1_epi8(static_cast<char>(0xFF));
+  const auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(mask)), all_ones, 0);
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+#else
+  mask ^= mask << 1;
+  mask ^= mask << 2;
+  mask ^= mask << 4;
+  mask ^= mask << 8;
+  mask ^= mask << 16;
+  mask ^= mask << 32;
+  return mask;
+#endif
+}
+
+}  // namespace opossum
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include "import_export/csv_meta.hpp"
+
+namespace opossum {
+
+/**
+ * Finds the structural characters of a CSV, i.e., the separators and delimiters that are not part of a quoted value.
+ *
+ * Instead of looking at one character at a time, the input is processed in blocks of 64 bytes. For each block,
+ * bitmasks of the quotes, escape characters, separators, and delimiters are built using SIMD compares (if available).
+ * The mask of the bytes within quotes is then computed as the prefix XOR of the mask of unescaped quotes, so that the
+ * quote handling does not need any data-dependent branches. This is the approach of simdjson (Langdale and Lemire,
+ * "Parsing Gigabytes of JSON per Second").
+ *
+ * The quoting rules are the same as those of the former scalar implementation in the CsvParser: Each quote toggles
+ * the quoted state, unless quote and escape character differ and the quote is preceded by the escape character.
+ */
+class CsvStructuralScanner {
+ public:
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  // Bit i of each mask is set if the i-th byte of the block is the corresponding character
+  struct BlockMasks {
+    uint64_t quotes{0};
+    uint64_t escapes{0};
+    uint64_t separators{0};
+    uint64_t delimiters{0};
+  };
+
+  explicit CsvStructuralScanner(const ParseConfig& config);
+
+  /**
+   * Calls @param callback(position, is_delimiter) for each delimiter (and, if IncludeSeparators is set, each separator)
+   * outside of quotes in @param content in ascending order of their positions. Scanning stops as soon as the callback
+   * returns false.
+   */
+  template <bool IncludeSeparators, typename Callback>
+  void scan(std::string_view content, const Callback& callback) const;
+
+  // Builds the masks for the @param length (at most BLOCK_SIZE) bytes starting at @param block
+  BlockMasks classify_block(const char* block, size_t length) const;
+
+  // Sets bit i of the result if an odd number of bits in @param mask are set at positions less than or equal to i
+  static uint64_t prefix_xor(uint64_t mask);
+
+ private:
+  const ParseConfig _config;
+};
+
+template <bool IncludeSeparators, typename Callback>
+void CsvStructuralScanner::scan(std::string_view content, const Callback& callback) const {
+  const auto quotes_can_be_escaped = _config.quote != _config.escape;
+
+  // All ones if the previous block ended within quotes, zero otherwise
+  auto in_quotes_carry = uint64_t{0};
+  // One if the last byte of the previous block was an escape character, zero otherwise
+  auto escape_carry = uint64_t{0};
+
+  for (auto block_begin = size_t{0}; block_begin < content.size(); block_begin += BLOCK_SIZE) {
+    const auto length = std::min(BLOCK_SIZE, content.size() - block_begin);
+    const auto masks = classify_block(content.data() + block_begin, length);
+
+    auto quotes = masks.quotes;
+    if (quotes_can_be_escaped) {
+      quotes &= ~((masks.escapes << 1) | escape_carry);
+      escape_carry = masks.escapes >> 63;
+    }
+
+    const auto in_quotes = prefix_xor(quotes) ^ in_quotes_carry;
+    in_quotes_carry = uint64_t{0} - (in_quotes >> 63);
+
+    auto structurals = masks.delimiters;
+    if constexpr (IncludeSeparators) structurals |= masks.separators;
+    structurals &= ~in_quotes;
+
+    while (structurals) {
+      const auto position = block_begin + static_cast<size_t>(__builtin_ctzll(structurals));
+      if (!callback(position, content[position] == _config.delimiter)) return;
+
+      // Clear the lowest set bit
+      structurals &= structurals - 1;
+    }
+  }
+}
+
+}  // namespace opossum
@@ -1,11 +1,62 @@
 #include "csv_writer.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
 #include "types.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+void append_integer(std::string& buffer, const T value) {
+  // Write the digits back to front into a local buffer. The absolute value is computed as unsigned to handle the
+  // minimum value of T.
+  using UnsignedT = std::make_unsigned_t<T>;
+  auto absolute_value = value < 0 ? UnsignedT{0} - static_cast<UnsignedT>(value) : static_cast<UnsignedT>(value);
+
+  char digits[24];
+  auto digits_begin = std::end(digits);
+  do {
+    *--digits_begin = static_cast<char>('0' + absolute_value % 10);
+    absolute_value /= 10;
+  } while (absolute_value != 0);
+  if (value < 0) *--digits_begin = '-';
+
+  buffer.append(digits_begin, std::end(digits));
+}
+
+template <typename T>
+void append_floating_point(std::string& buffer, const T value) {
+  // %g with the default precision of 6 is what std::ostream uses for floating point numbers, which write() relies on
+  char digits[32];
+  const auto length = std::snprintf(digits, sizeof(digits), "%g", static_cast<double>(value));
+  buffer.append(digits, static_cast<size_t>(length));
+}
+
+void append_string(std::string& buffer, const pmr_string& value, const ParseConfig& config) {
+  // Same quoting and escaping as CsvWriter::_write_string_value()
+  buffer.push_back(config.quote);
+  auto begin = size_t{0};
+  auto quote_pos = size_t{0};
+  while (std::string::npos != (quote_pos = value.find(config.quote, begin))) {
+    buffer.append(value, begin, quote_pos - begin);
+    buffer.push_back(config.escape);
+    buffer.push_back(config.quote);
+    begin = quote_pos + 1;
+  }
+  buffer.append(value, begin, std::string::npos);
+  buffer.push_back(config.quote);
+}
+
+}  // namespace
+
 namespace opossum {
 
 CsvWriter::CsvWriter(const std::string& file, const ParseConfig& config) : _config(config) {
@@ -27,6 +78,66 @@ void CsvWriter::end_line() {
   _current_column_count = 0;
 }
 
+void CsvWriter::write_formatted_rows(const std::string& rows) {
+  DebugAssert(_current_column_count == 0, "Cannot write formatted rows in the middle of a row");
+  _stream.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+}
+
+std::string CsvWriter::format_chunk(const Chunk& chunk, const ParseConfig& config) {
+  const auto column_count = chunk.column_count();
+  const auto row_count = chunk.size();
+
+  // Format each column on its own, so that every segment is iterated only once and without virtual calls per value.
+  // field_ends[column_id][row] is the end of the row's field in formatted_columns[column_id].
+  auto formatted_columns = std::vector<std::string>(column_count);
+  auto field_ends = std::vector<std::vector<size_t>>(column_count);
+
+  for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+    const auto& segment = *chunk.get_segment(column_id);
+    auto& formatted_column = formatted_columns[column_id];
+    auto& column_field_ends = field_ends[column_id];
+    column_field_ends.reserve(row_count);
+
+    resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        if (!position.is_null()) {
+          if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+            append_string(formatted_column, position.value(), config);
+          } else if constexpr (std::is_floating_point_v<ColumnDataType>) {
+            append_floating_point(formatted_column, position.value());
+          } else {
+            append_integer(formatted_column, position.value());
+          }
+        }
+        column_field_ends.push_back(formatted_column.size());
+      });
+    });
+  }
+
+  // Interleave the formatted columns into rows. Each field is followed by either a separator or a delimiter.
+  auto formatted_size = size_t{row_count} * column_count;
+  for (const auto& formatted_column : formatted_columns) formatted_size += formatted_column.size();
+
+  auto rows = std::string{};
+  rows.reserve(formatted_size);
+
+  auto field_begins = std::vector<size_t>(column_count, 0);
+  for (auto row = size_t{0}; row < row_count; ++row) {
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      if (column_id > 0) rows.push_back(config.separator);
+
+      const auto field_end = field_ends[column_id][row];
+      rows.append(formatted_columns[column_id], field_begins[column_id], field_end - field_begins[column_id]);
+      field_begins[column_id] = field_end;
+    }
+    rows.push_back(config.delimiter);
+  }
+
+  return rows;
+}
+
 void CsvWriter::_write_value(const AllTypeVariant& value) {
   if (variant_is_null(value)) return;
 
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "storage/chunk.hpp"
 #include "csv_meta.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -26,6 +27,18 @@ class CsvWriter {
    */
   void end_line();
 
+  /*
+   * Writes rows that were formatted by format_chunk(). Must not be mixed with a partially written row.
+   */
+  void write_formatted_rows(const std::string& rows);
+
+  /*
+   * Formats all rows of @param chunk in csv format, producing the same output as write()-ing each value and
+   * end_line()-ing each row. The segments are read column by column using the typed segment iterables and the rows
+   * are assembled afterwards. Since this does not touch the output file, multiple chunks can be formatted in parallel.
+   */
+  static std::string format_chunk(const Chunk& chunk, const ParseConfig& config = {});
+
  protected:
   pmr_string _escape(const pmr_string& string);
 
@@ -0,0 +1,199 @@
+#include "logger.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <utility>
+
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+void write_value(std::vector<char>& buffer, const T& value) {
+  const auto* const data = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), data, data + sizeof(T));
+}
+
+template <typename String>
+void write_string(std::vector<char>& buffer, const String& string) {
+  write_value(buffer, static_cast<uint32_t>(string.size()));
+  buffer.insert(buffer.end(), string.begin(), string.end());
+}
+
+void write_all_type_variant(std::vector<char>& buffer, const AllTypeVariant& value) {
+  const auto data_type = data_type_from_all_type_variant(value);
+  write_value(buffer, data_type);
+  if (data_type == DataType::Null) return;
+
+  resolve_data_type(data_type, [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+      write_string(buffer, boost::get<pmr_string>(value));
+    } else {
+      write_value(buffer, boost::get<ColumnDataType>(value));
+    }
+  });
+}
+
+void write_entry_header(std::vector<char>& buffer, const LogEntryType type, const TransactionID transaction_id) {
+  write_value(buffer, type);
+  write_value(buffer, transaction_id);
+}
+
+void write_row_id(std::vector<char>& buffer, const std::string& table_name, const RowID& row_id) {
+  write_string(buffer, table_name);
+  write_value(buffer, row_id.chunk_id);
+  write_value(buffer, row_id.chunk_offset);
+}
+
+}  // namespace
+
+namespace opossum {
+
+Logger::~Logger() {
+  if (_is_enabled) disable();
+}
+
+void Logger::enable(const std::string& log_file_path) {
+  Assert(!_is_enabled, "Logger is already enabled");
+
+  _file_descriptor = open(log_file_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  Assert(_file_descriptor >= 0, "Could not open log file '" + log_file_path + "': " + std::strerror(errno));
+
+  _buffer.emplace_back(static_cast<char>(LogEntryType::Start));
+
+  _shutdown = false;
+  _written_bytes = 0;
+  _flush_count = 0;
+  _flush_thread = std::thread{&Logger::_flush_loop, this};
+  _is_enabled = true;
+}
+
+void Logger::disable() {
+  Assert(_is_enabled, "Logger is not enabled");
+
+  {
+    std::lock_guard<std::mutex> lock(_buffer_mutex);
+    _shutdown = true;
+  }
+  _flush_requested.notify_one();
+  _flush_thread.join();
+
+  close(_file_descriptor);
+  _file_descriptor = -1;
+  _is_enabled = false;
+}
+
+bool Logger::is_enabled() const { return _is_enabled; }
+
+void Logger::log_value(const TransactionID transaction_id, const std::string& table_name, const RowID& row_id,
+                       const std::vector<AllTypeVariant>& values) {
+  auto entry = std::vector<char>{};
+  write_entry_header(entry, LogEntryType::Value, transaction_id);
+  write_row_id(entry, table_name, row_id);
+  write_value(entry, static_cast<uint16_t>(values.size()));
+  for (const auto& value : values) {
+    write_all_type_variant(entry, value);
+  }
+
+  auto buffer_is_full = false;
+  {
+    std::lock_guard<std::mutex> lock(_buffer_mutex);
+    _buffer.insert(_buffer.end(), entry.begin(), entry.end());
+    buffer_is_full = _buffer.size() >= FLUSH_THRESHOLD;
+  }
+  if (buffer_is_full) _flush_requested.notify_one();
+}
+
+void Logger::log_invalidation(const TransactionID transaction_id, const std::string& table_name,
+                              const RowID& row_id) {
+  auto entry = std::vector<char>{};
+  write_entry_header(entry, LogEntryType::Invalidation, transaction_id);
+  write_row_id(entry, table_name, row_id);
+
+  std::lock_guard<std::mutex> lock(_buffer_mutex);
+  _buffer.insert(_buffer.end(), entry.begin(), entry.end());
+}
+
+void Logger::log_commit(const TransactionID transaction_id, const CommitID commit_id,
+                        const std::function<void()>& on_durable) {
+  auto entry = std::vector<char>{};
+  write_entry_header(entry, LogEntryType::Commit, transaction_id);
+  write_value(entry, commit_id);
+
+  {
+    std::lock_guard<std::mutex> lock(_buffer_mutex);
+    _buffer.insert(_buffer.end(), entry.begin(), entry.end());
+    _commit_callbacks.emplace_back(on_durable);
+  }
+  _flush_requested.notify_one();
+}
+
+void Logger::flush() {
+  auto flushed = std::promise<void>{};
+  {
+    std::lock_guard<std::mutex> lock(_buffer_mutex);
+    _commit_callbacks.emplace_back([&flushed]() { flushed.set_value(); });
+  }
+  _flush_requested.notify_one();
+  flushed.get_future().wait();
+}
+
+size_t Logger::written_bytes() const { return _written_bytes; }
+
+size_t Logger::flush_count() const { return _flush_count; }
+
+void Logger::_flush_loop() {
+  auto shutdown = false;
+  while (!shutdown) {
+    auto buffer = std::vector<char>{};
+    auto commit_callbacks = std::vector<std::function<void()>>{};
+
+    {
+      std::unique_lock<std::mutex> lock(_buffer_mutex);
+      _flush_requested.wait(lock, [&]() {
+        return _shutdown || !_commit_callbacks.empty() || _buffer.size() >= FLUSH_THRESHOLD;
+      });
+
+      // Everything that is logged from now on is written by the next iteration
+      std::swap(buffer, _buffer);
+      std::swap(commit_callbacks, _commit_callbacks);
+      shutdown = _shutdown;
+    }
+
+    _write_to_file(buffer);
+
+    for (const auto& commit_callback : commit_callbacks) {
+      commit_callback();
+    }
+  }
+}
+
+void Logger::_write_to_file(const std::vector<char>& buffer) {
+  auto written_bytes = size_t{0};
+  while (written_bytes < buffer.size()) {
+    const auto result = write(_file_descriptor, buffer.data() + written_bytes, buffer.size() - written_bytes);
+    if (result < 0 && errno == EINTR) continue;
+    Assert(result >= 0, std::string{"Could not write to log file: "} + std::strerror(errno));
+    written_bytes += static_cast<size_t>(result);
+  }
+
+#ifdef __APPLE__
+  const auto sync_result = fcntl(_file_descriptor, F_FULLFSYNC);
+#else
+  const auto sync_result = fdatasync(_file_descriptor);
+#endif
+  Assert(sync_result == 0, std::string{"Could not sync log file: "} + std::strerror(errno));
+
+  _written_bytes += written_bytes;
+  ++_flush_count;
+}
+
+}  // namespace opossum
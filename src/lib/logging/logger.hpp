@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+/**
+ * The log consists of entries of the following types. All numbers are written in the machine's byte order.
+ *
+ *   Value:        'v' | TransactionID | table name | ChunkID | ChunkOffset | column count | values
+ *   Invalidation: 'i' | TransactionID | table name | ChunkID | ChunkOffset
+ *   Commit:       'c' | TransactionID | CommitID
+ *   Start:        's'
+ *
+ * Strings (table names and string values) are prefixed with their length (uint32_t). Each value is prefixed with its
+ * DataType (DataType::Null for NULLs, which have no payload).
+ *
+ * A start entry is written whenever logging is enabled, e.g., after a restart. The RowIDs of the following entries
+ * refer to the tables as they were loaded and recovered before that point.
+ */
+enum class LogEntryType : char { Value = 'v', Invalidation = 'i', Commit = 'c', Start = 's' };
+
+/**
+ * Redo log for the changes of committed transactions. It is disabled by default and has to be enabled by calling
+ * enable() before the first transaction is executed.
+ *
+ * Insert and Delete write their changes to the log in commit_records(). TransactionContext::commit_async() then writes
+ * the commit entry and only marks the transaction as committed (i.e., makes it visible and calls its callback) once the
+ * log has been flushed to disk.
+ *
+ * The entries are collected in a buffer, which is written and synced by a separate flush thread (group commit). The
+ * flush thread writes the buffer as soon as a transaction waits for its commit. Transactions that commit while the
+ * previous flush is in progress are written together with the next flush, so that a single fsync persists many
+ * transactions under load.
+ *
+ * Use recover_from_log() to recover the tables from the log, optionally on top of a checkpoint (see CheckpointTask).
+ */
+class Logger : public Singleton<Logger> {
+ public:
+  // Entries that are not followed by a commit entry are written once the buffer exceeds this size
+  static constexpr auto FLUSH_THRESHOLD = size_t{1'000'000};
+
+  ~Logger();
+
+  // Starts logging to the end of the file at @param log_file_path, which is created if it does not exist
+  void enable(const std::string& log_file_path);
+
+  // Flushes the remaining entries and closes the file. No transaction may commit concurrently.
+  void disable();
+
+  bool is_enabled() const;
+
+  void log_value(const TransactionID transaction_id, const std::string& table_name, const RowID& row_id,
+                 const std::vector<AllTypeVariant>& values);
+
+  void log_invalidation(const TransactionID transaction_id, const std::string& table_name, const RowID& row_id);
+
+  // @param on_durable is called by the flush thread once the commit entry is on disk
+  void log_commit(const TransactionID transaction_id, const CommitID commit_id,
+                  const std::function<void()>& on_durable);
+
+  // Blocks until all entries that were logged before have been written to disk
+  void flush();
+
+  // Number of bytes and number of fsyncs written since the log was enabled
+  size_t written_bytes() const;
+  size_t flush_count() const;
+
+ protected:
+  Logger() = default;
+
+  friend class Singleton;
+
+  void _flush_loop();
+  void _write_to_file(const std::vector<char>& buffer);
+
+  int _file_descriptor{-1};
+  std::atomic_bool _is_enabled{false};
+
+  std::thread _flush_thread;
+  bool _shutdown{false};
+
+  // Protects the members below
+  std::mutex _buffer_mutex;
+  std::condition_variable _flush_requested;
+  std::vector<char> _buffer;
+  std::vector<std::function<void()>> _commit_callbacks;
+
+  std::atomic<size_t> _written_bytes{0};
+  std::atomic<size_t> _flush_count{0};
+};
+
+}  // namespace opossum
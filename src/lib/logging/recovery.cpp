@@ -0,0 +1,202 @@
+#include "recovery.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrency/transaction_manager.hpp"
+#include "logger.hpp"
+#include "resolve_type.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Reads entries from the log. Each read returns std::nullopt if the log ends before the value is complete.
+class LogReader {
+ public:
+  explicit LogReader(std::vector<char>&& log) : _log(std::move(log)) {}
+
+  bool at_end() const { return _position == _log.size(); }
+
+  template <typename T>
+  std::optional<T> read_value() {
+    if (_log.size() - _position < sizeof(T)) return std::nullopt;
+
+    auto value = T{};
+    std::copy(_log.begin() + _position, _log.begin() + _position + sizeof(T), reinterpret_cast<char*>(&value));
+    _position += sizeof(T);
+    return value;
+  }
+
+  template <typename String>
+  std::optional<String> read_string() {
+    const auto length = read_value<uint32_t>();
+    if (!length || _log.size() - _position < *length) return std::nullopt;
+
+    auto string = String{_log.begin() + _position, _log.begin() + _position + *length};
+    _position += *length;
+    return string;
+  }
+
+  std::optional<AllTypeVariant> read_all_type_variant() {
+    const auto data_type = read_value<DataType>();
+    if (!data_type) return std::nullopt;
+    if (*data_type == DataType::Null) return NULL_VALUE;
+
+    auto value = std::optional<AllTypeVariant>{};
+    resolve_data_type(*data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+        if (const auto string = read_string<pmr_string>()) value = *string;
+      } else {
+        if (const auto typed_value = read_value<ColumnDataType>()) value = *typed_value;
+      }
+    });
+    return value;
+  }
+
+ private:
+  const std::vector<char> _log;
+  size_t _position{0};
+};
+
+struct LoggedChange {
+  LogEntryType type;
+  std::string table_name;
+  RowID row_id;
+  std::vector<AllTypeVariant> values;
+};
+
+// Reads the part of a value or invalidation entry that follows the entry header
+std::optional<LoggedChange> read_change(LogReader& reader, const LogEntryType type) {
+  auto change = LoggedChange{type, {}, {}, {}};
+
+  const auto table_name = reader.read_string<std::string>();
+  const auto chunk_id = reader.read_value<ChunkID>();
+  const auto chunk_offset = reader.read_value<ChunkOffset>();
+  if (!table_name || !chunk_id || !chunk_offset) return std::nullopt;
+  change.table_name = *table_name;
+  change.row_id = RowID{*chunk_id, *chunk_offset};
+
+  if (type == LogEntryType::Invalidation) return change;
+
+  const auto column_count = reader.read_value<uint16_t>();
+  if (!column_count) return std::nullopt;
+
+  for (auto column_id = uint16_t{0}; column_id < *column_count; ++column_id) {
+    const auto value = reader.read_all_type_variant();
+    if (!value) return std::nullopt;
+    change.values.emplace_back(*value);
+  }
+
+  return change;
+}
+
+class ChangeApplier {
+ public:
+  void apply(const LoggedChange& change) {
+    Assert(StorageManager::get().has_table(change.table_name),
+           "Cannot recover changes of table '" + change.table_name + "', which does not exist");
+    const auto table = StorageManager::get().get_table(change.table_name);
+    auto& row_id_mapping = _row_id_mappings[change.table_name];
+
+    if (change.type == LogEntryType::Value) {
+      const auto last_chunk = table->chunk_count() > 0 ? table->get_chunk(ChunkID{table->chunk_count() - 1}) : nullptr;
+      if (last_chunk && !last_chunk->is_mutable()) table->append_mutable_chunk();
+
+      table->append(change.values);
+
+      const auto chunk_id = static_cast<ChunkID>(table->chunk_count() - 1);
+      const auto chunk = table->get_chunk(chunk_id);
+      const auto chunk_offset = static_cast<ChunkOffset>(chunk->size() - 1);
+      chunk->get_scoped_mvcc_data_lock()->begin_cids[chunk_offset] = CommitID{0};
+
+      row_id_mapping[change.row_id] = RowID{chunk_id, chunk_offset};
+      return;
+    }
+
+    // Rows that were not inserted by a replayed transaction are at their original position
+    const auto mapping_iter = row_id_mapping.find(change.row_id);
+    const auto row_id = mapping_iter != row_id_mapping.end() ? mapping_iter->second : change.row_id;
+
+    Assert(row_id.chunk_id < table->chunk_count() && table->get_chunk(row_id.chunk_id) &&
+               row_id.chunk_offset < table->get_chunk(row_id.chunk_id)->size(),
+           "Cannot recover the deletion of a row that does not exist in table '" + change.table_name + "'");
+    const auto chunk = table->get_chunk(row_id.chunk_id);
+    chunk->get_scoped_mvcc_data_lock()->end_cids[row_id.chunk_offset] = CommitID{0};
+    chunk->increase_invalid_row_count(1);
+  }
+
+  // After a restart, logged RowIDs refer to the tables as they were recovered
+  void reset_row_id_mappings() { _row_id_mappings.clear(); }
+
+ private:
+  // Maps the RowIDs of logged rows to the RowIDs of the replayed rows, per table
+  std::unordered_map<std::string, std::map<RowID, RowID>> _row_id_mappings;
+};
+
+}  // namespace
+
+namespace opossum {
+
+size_t recover_from_log(const std::string& log_file_path, const CommitID checkpoint_commit_id) {
+  Assert(!Logger::get().is_enabled(), "The Logger has to be enabled after the recovery");
+
+  auto log_file = std::ifstream{log_file_path, std::ios::binary};
+  Assert(log_file.is_open(), "Could not open log file '" + log_file_path + "'");
+  auto reader = LogReader{std::vector<char>{std::istreambuf_iterator<char>{log_file}, {}}};
+
+  auto uncommitted_changes = std::unordered_map<TransactionID, std::vector<LoggedChange>>{};
+  auto change_applier = ChangeApplier{};
+  auto recovered_transaction_count = size_t{0};
+  auto last_commit_id = std::max(TransactionManager::get().last_commit_id(), checkpoint_commit_id);
+
+  while (!reader.at_end()) {
+    const auto type = reader.read_value<LogEntryType>();
+    if (type == LogEntryType::Start) {
+      // Transactions that were not committed before the restart never will be
+      uncommitted_changes.clear();
+      change_applier.reset_row_id_mappings();
+      continue;
+    }
+
+    const auto transaction_id = reader.read_value<TransactionID>();
+    if (!type || !transaction_id) break;
+
+    if (*type == LogEntryType::Commit) {
+      const auto commit_id = reader.read_value<CommitID>();
+      if (!commit_id) break;
+
+      if (*commit_id > checkpoint_commit_id) {
+        // A transaction only sees the changes of another one once they are durable. Thus, replaying the transactions
+        // in the order of their commit entries preserves the order of conflicting changes.
+        for (const auto& change : uncommitted_changes[*transaction_id]) {
+          change_applier.apply(change);
+        }
+        last_commit_id = std::max(last_commit_id, *commit_id);
+        ++recovered_transaction_count;
+      }
+      uncommitted_changes.erase(*transaction_id);
+      continue;
+    }
+
+    Assert(*type == LogEntryType::Value || *type == LogEntryType::Invalidation, "Log file is corrupted");
+    auto change = read_change(reader, *type);
+    if (!change) break;
+    uncommitted_changes[*transaction_id].emplace_back(std::move(*change));
+  }
+
+  TransactionManager::get().restore_last_commit_id(last_commit_id);
+
+  return recovered_transaction_count;
+}
+
+}  // namespace opossum
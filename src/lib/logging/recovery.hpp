@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Replays the committed transactions in the log written by the Logger (see logger.hpp for the format). Transactions
+ * without a commit entry (e.g., because the system crashed before the log was synced) are skipped, as is an incomplete
+ * entry at the end of the log.
+ *
+ * The tables have to exist in the StorageManager already, usually because they were loaded from a checkpoint. Rows
+ * that were not inserted by a logged transaction are expected at the same position as before. Replayed rows are
+ * appended to the tables and are visible to all transactions, deleted rows become invisible to all transactions.
+ *
+ * Transactions that committed at or before @param checkpoint_commit_id are skipped, as their changes are contained in
+ * the checkpoint the tables were loaded from (see CheckpointTask::load_checkpoint()). Afterwards, new transactions
+ * commit after the last replayed one.
+ *
+ * Has to be called before the first transaction is executed and before the Logger is enabled.
+ *
+ * @return the number of replayed transactions
+ */
+size_t recover_from_log(const std::string& log_file_path, const CommitID checkpoint_commit_id = CommitID{0});
+
+}  // namespace opossum
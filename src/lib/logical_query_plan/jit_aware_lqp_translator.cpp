@@ -78,6 +78,8 @@ bool requires_computation(const std::shared_ptr<AbstractLQPNode>& node) {
 
 namespace opossum {
 
+JitAwareLQPTranslator::JitAwareLQPTranslator(const JitExecutionMode execution_mode) : _execution_mode(execution_mode) {}
+
 std::shared_ptr<AbstractOperator> JitAwareLQPTranslator::translate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   // Jit operators materialize their output table and cannot be used in non-select queries
@@ -130,7 +132,8 @@ std::shared_ptr<JitOperatorWrapper> JitAwareLQPTranslator::_try_translate_sub_pl
   // The input_node is not being integrated into the operator chain, but instead serves as the input to the JitOperators
   const auto input_node = *input_nodes.begin();
 
-  const auto jit_operator = std::make_shared<JitOperatorWrapper>(translate_node(input_node));
+  const auto jit_operator = std::make_shared<JitOperatorWrapper>(translate_node(input_node), _execution_mode);
+  if (_execution_mode == JitExecutionMode::Adaptive) jit_operator->set_lqp(node, input_node);
   const auto read_tuples = std::make_shared<JitReadTuples>(use_validate, row_count_expression);
   jit_operator->add_jit_operator(read_tuples);
 
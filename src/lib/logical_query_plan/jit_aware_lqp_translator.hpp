@@ -36,9 +36,14 @@ namespace opossum {
  *    can in turn reference a LQPExpression in a ProjectionNode) is encountered, it is converted to an JitExpression
  *    by a helper method first. We then add a JitCompute operator to our chain and use its result value instead of the
  *    original non-primitive value.
+ *
+ * The created JitOperatorWrappers use the given execution mode. By default, each execution of a JitOperatorWrapper
+ * decides whether the regular operators or the compiled pipeline are used (see JitExecutionAdvisor).
  */
 class JitAwareLQPTranslator final : public LQPTranslator {
  public:
+  explicit JitAwareLQPTranslator(const JitExecutionMode execution_mode = JitExecutionMode::Adaptive);
+
   std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const final;
 
  private:
@@ -56,6 +61,8 @@ class JitAwareLQPTranslator final : public LQPTranslator {
   bool _expression_is_jittable(const std::shared_ptr<AbstractExpression>& expression) const;
 
   static JitExpressionType _expression_to_jit_expression_type(const std::shared_ptr<AbstractExpression>& expression);
+
+  const JitExecutionMode _execution_mode;
 };
 
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -36,6 +37,7 @@
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -166,14 +168,18 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   auto value_variant = AllTypeVariant{NullValue{}};
   auto value2_variant = std::optional<AllTypeVariant>{};
 
-  // Currently, we will only use IndexScans if the predicate node directly follows a StoredTableNode.
-  // Our IndexScan implementation does not work on reference segments yet.
-  Assert(node->left_input()->type == LQPNodeType::StoredTable, "IndexScan must follow a StoredTableNode.");
-
   const auto predicate = std::dynamic_pointer_cast<AbstractPredicateExpression>(node->predicate());
   Assert(predicate, "Expected predicate");
   Assert(!predicate->arguments.empty(), "Expected arguments");
 
+  // The indexes are those of the stored table that the searched column originates from. The predicate does not need
+  // to directly follow the StoredTableNode, as the IndexScan intersects the index results with reference inputs.
+  const auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->arguments[0]);
+  Assert(column_expression, "Expected column as first argument for IndexScan");
+  const auto stored_table_node =
+      std::dynamic_pointer_cast<const StoredTableNode>(column_expression->column_reference.original_node());
+  Assert(stored_table_node, "IndexScan requires a column of a stored table");
+
   column_id = node->left_input()->get_column_id(*predicate->arguments[0]);
   if (predicate->arguments.size() > 1) {
     const auto value_expression = std::dynamic_pointer_cast<ValueExpression>(predicate->arguments[1]);
@@ -193,9 +199,25 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   std::vector<AllTypeVariant> right_values2 = {};
   if (value2_variant) right_values2.emplace_back(*value2_variant);
 
-  auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(node->left_input());
-  const auto table_name = stored_table_node->table_name;
-  const auto table = StorageManager::get().get_table(table_name);
+  const auto table = StorageManager::get().get_table(stored_table_node->table_name);
+  const auto original_column_ids = std::vector<ColumnID>{column_expression->column_reference.original_column_id()};
+
+  // A table-wide hash index covers all chunks, so no TableScan is needed for the remaining ones. GetTable might return
+  // a copy without the hash index, so the IndexScan needs to know the stored table.
+  if (predicate->predicate_condition == PredicateCondition::Equals && table->get_hash_index(original_column_ids)) {
+    const auto index_scan = std::make_shared<IndexScan>(input_operator, SegmentIndexType::Invalid, column_ids,
+                                                        predicate->predicate_condition, right_values);
+    index_scan->set_stored_table_name(stored_table_node->table_name);
+    return index_scan;
+  }
+
+  // On a reference input, the input chunks do not correspond to the stored chunks, so we cannot split them between an
+  // IndexScan and a TableScan here. Instead, the IndexScan scans referenced chunks without an index itself.
+  if (node->left_input()->type != LQPNodeType::StoredTable) {
+    return std::make_shared<IndexScan>(input_operator, SegmentIndexType::GroupKey, column_ids,
+                                       predicate->predicate_condition, right_values, right_values2);
+  }
+
   std::vector<ChunkID> indexed_chunks;
 
   for (ChunkID chunk_id{0u}; chunk_id < table->chunk_count(); ++chunk_id) {
@@ -314,10 +336,26 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
       join_node->join_mode != JoinMode::FullOuter) {
     return std::make_shared<JoinHash>(input_left_operator, input_right_operator, join_node->join_mode,
                                       primary_join_predicate, std::nullopt, std::move(secondary_join_predicates));
-  } else {
-    return std::make_shared<JoinSortMerge>(input_left_operator, input_right_operator, join_node->join_mode,
-                                           primary_join_predicate, std::move(secondary_join_predicates));
   }
+
+  // Inequality joins without any equi predicate (e.g., band joins) are executed by the JoinBand, which only enumerates
+  // the matching range of rows
+  const auto has_equi_predicate =
+      std::any_of(join_predicates.cbegin(), join_predicates.cend(), [](const auto& join_predicate) {
+        return join_predicate.predicate_condition == PredicateCondition::Equals;
+      });
+  const auto left_data_type =
+      node->left_input()->column_expressions().at(primary_join_predicate.column_ids.first)->data_type();
+  const auto right_data_type =
+      node->right_input()->column_expressions().at(primary_join_predicate.column_ids.second)->data_type();
+  if (!has_equi_predicate && JoinBand::supports(join_node->join_mode, primary_join_predicate.predicate_condition,
+                                                left_data_type, right_data_type)) {
+    return std::make_shared<JoinBand>(input_left_operator, input_right_operator, join_node->join_mode,
+                                      primary_join_predicate, std::move(secondary_join_predicates));
+  }
+
+  return std::make_shared<JoinSortMerge>(input_left_operator, input_right_operator, join_node->join_mode,
+                                         primary_join_predicate, std::move(secondary_join_predicates));
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
@@ -538,4 +576,14 @@ std::vector<std::shared_ptr<AbstractExpression>> LQPTranslator::_translate_expre
   return pqp_expressions;
 }
 
+InputReplacingLQPTranslator::InputReplacingLQPTranslator(const std::shared_ptr<AbstractLQPNode>& input_node,
+                                                         const std::shared_ptr<AbstractOperator>& input_operator)
+    : _input_node(input_node), _input_operator(input_operator) {}
+
+std::shared_ptr<AbstractOperator> InputReplacingLQPTranslator::translate_node(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  if (node == _input_node) return _input_operator;
+  return LQPTranslator::translate_node(node);
+}
+
 }  // namespace opossum
@@ -72,4 +72,20 @@ class LQPTranslator {
       _operator_by_lqp_node;
 };
 
+/**
+ * Translates an LQP, using an already existing operator for one of its nodes. Used to translate a subplan onto an input
+ * that is computed separately, e.g., by a MorselPipeline or a JitOperatorWrapper.
+ */
+class InputReplacingLQPTranslator : public LQPTranslator {
+ public:
+  InputReplacingLQPTranslator(const std::shared_ptr<AbstractLQPNode>& input_node,
+                              const std::shared_ptr<AbstractOperator>& input_operator);
+
+  std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const override;
+
+ private:
+  const std::shared_ptr<AbstractLQPNode> _input_node;
+  const std::shared_ptr<AbstractOperator> _input_operator;
+};
+
 }  // namespace opossum
@@ -0,0 +1,66 @@
+#include "morsel_aware_lqp_translator.hpp"
+
+#include <memory>
+
+#include "expression/expression_utils.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "operators/table_wrapper.hpp"
+#include "predicate_node.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+std::shared_ptr<AbstractOperator> MorselAwareLQPTranslator::translate_node(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  if (!_node_is_pipelineable(node)) return LQPTranslator::translate_node(node);
+
+  const auto morsel_pipeline_iter = _morsel_pipeline_by_lqp_node.find(node);
+  if (morsel_pipeline_iter != _morsel_pipeline_by_lqp_node.end()) return morsel_pipeline_iter->second;
+
+  auto pipeline_length = size_t{1};
+  auto input_node = node->left_input();
+  while (_node_is_pipelineable(input_node) && input_node->output_count() == 1) {
+    input_node = input_node->left_input();
+    ++pipeline_length;
+  }
+
+  // A single operator already processes its input chunk by chunk
+  if (pipeline_length < 2) return LQPTranslator::translate_node(node);
+
+  const auto input_operator = translate_node(input_node);
+
+  // The placeholder is replaced by the input of each morsel and never executed
+  const auto pipeline_input = std::make_shared<TableWrapper>(Table::create_dummy_table({}));
+  const auto pipeline_root = InputReplacingLQPTranslator{input_node, pipeline_input}.translate_node(node);
+
+  const auto morsel_pipeline = std::make_shared<MorselPipeline>(input_operator, pipeline_root, pipeline_input);
+  _morsel_pipeline_by_lqp_node.emplace(node, morsel_pipeline);
+  return morsel_pipeline;
+}
+
+bool MorselAwareLQPTranslator::_node_is_pipelineable(const std::shared_ptr<AbstractLQPNode>& node) {
+  switch (node->type) {
+    case LQPNodeType::Alias:
+    case LQPNodeType::Projection:
+    case LQPNodeType::Validate:
+      break;
+    case LQPNodeType::Predicate:
+      // IndexScans need the chunks of the stored table
+      if (std::static_pointer_cast<PredicateNode>(node)->scan_type != ScanType::TableScan) return false;
+      break;
+    default:
+      return false;
+  }
+
+  auto contains_subquery = false;
+  for (const auto& node_expression : node->node_expressions) {
+    visit_expression(node_expression, [&](const auto& expression) {
+      if (expression->type == ExpressionType::LQPSubquery) contains_subquery = true;
+      return contains_subquery ? ExpressionVisitation::DoNotVisitArguments : ExpressionVisitation::VisitArguments;
+    });
+  }
+
+  return !contains_subquery;
+}
+
+}  // namespace opossum
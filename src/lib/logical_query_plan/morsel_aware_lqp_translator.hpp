@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "logical_query_plan/lqp_translator.hpp"
+
+namespace opossum {
+
+/**
+ * This class can be used as a drop-in specialization for the LQPTranslator. It translates chains of at least two
+ * pipelineable nodes (PredicateNodes that are executed as TableScans, ValidateNodes, ProjectionNodes and AliasNodes)
+ * into a MorselPipeline, which executes them chunk by chunk instead of operator at a time. All other nodes are pipeline
+ * breakers and are translated by the LQPTranslator.
+ *
+ * A chain ends at a node with multiple outputs, since its result is needed by other operators as well. Nodes with
+ * subqueries are not pipelined, as the subqueries would be executed for each morsel.
+ */
+class MorselAwareLQPTranslator final : public LQPTranslator {
+ public:
+  std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const final;
+
+ private:
+  static bool _node_is_pipelineable(const std::shared_ptr<AbstractLQPNode>& node);
+
+  // Cache MorselPipelines by their root node, like the LQPTranslator does for the other operators
+  mutable std::unordered_map<std::shared_ptr<const AbstractLQPNode>, std::shared_ptr<AbstractOperator>>
+      _morsel_pipeline_by_lqp_node;
+};
+
+}  // namespace opossum
@@ -28,12 +28,14 @@ enum class OperatorType {
   IndexScan,
   Insert,
   JitOperatorWrapper,
+  JoinBand,
   JoinHash,
   JoinIndex,
   JoinMPSM,
   JoinNestedLoop,
   JoinSortMerge,
   Limit,
+  MorselPipeline,
   Print,
   Product,
   Projection,
@@ -108,6 +110,11 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // An operator needs to implement this method in order to be cacheable.
   std::shared_ptr<AbstractOperator> deep_copy() const;
 
+  // Same as deep_copy(), but uses the operators in @param copied_ops instead of copying them, e.g., to copy a subplan
+  // onto a different input. The copied operators are added to @param copied_ops.
+  std::shared_ptr<AbstractOperator> deep_copy(
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const;
+
   // Get the input operators.
   std::shared_ptr<const AbstractOperator> input_left() const;
   std::shared_ptr<const AbstractOperator> input_right() const;
@@ -17,7 +17,10 @@
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_segment.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 #include "type_comparison.hpp"
 #include "utils/aligned_size.hpp"
 #include "utils/assert.hpp"
@@ -48,6 +51,24 @@ typename Results::reference get_or_add_result(ResultIds& result_ids, Results& re
 
   return results[result_id];
 }
+
+// Same as above, but for dense AggregateKeys that directly index the result ids (see DenseAggregateResultIdMap)
+template <typename Results>
+typename Results::reference get_or_add_result(DenseAggregateResultIdMap& result_ids, Results& results,
+                                              const AggregateKeyEntry key, const RowID& row_id) {
+  if (key >= result_ids.size()) {
+    result_ids.resize(key + 1, INVALID_AGGREGATE_RESULT_ID);
+  }
+
+  auto& result_id = result_ids[key];
+  if (result_id == INVALID_AGGREGATE_RESULT_ID) {
+    result_id = results.size();
+    results.emplace_back();
+    results[result_id].row_id = row_id;
+  }
+
+  return results[result_id];
+}
 }  // namespace
 
 namespace opossum {
@@ -122,7 +143,7 @@ struct AggregateResultContext : SegmentVisitorContext {
 template <typename ColumnDataType, typename AggregateType, typename AggregateKey>
 struct AggregateContext : public AggregateResultContext<ColumnDataType, AggregateType> {
   AggregateContext() {
-    auto allocator = AggregateResultIdMapAllocator<AggregateKey>{&this->buffer};
+    auto allocator = typename AggregateResultIdMap<AggregateKey>::allocator_type{&this->buffer};
     result_ids = std::make_unique<AggregateResultIdMap<AggregateKey>>(allocator);
   }
 
@@ -215,6 +236,65 @@ void Aggregate::_aggregate_segment(ChunkID chunk_id, ColumnID column_index, cons
   auto& results = context.results;
   const auto& hash_keys = keys_per_chunk[chunk_id];
 
+  if (const auto run_length_segment = dynamic_cast<const RunLengthSegment<ColumnDataType>*>(&base_segment)) {
+    /**
+     * Aggregate the runs without expanding them. All rows of a run have the same value, so consecutive rows of a run
+     * that also belong to the same group are aggregated at once.
+     */
+    const auto& values = *run_length_segment->values();
+    const auto& null_values = *run_length_segment->null_values();
+    const auto& end_positions = *run_length_segment->end_positions();
+
+    auto run_begin = ChunkOffset{0};
+    for (auto run_index = size_t{0}; run_index < values.size(); ++run_index) {
+      const auto run_end = static_cast<ChunkOffset>(end_positions[run_index] + 1);
+
+      auto group_begin = run_begin;
+      while (group_begin < run_end) {
+        auto group_end = static_cast<ChunkOffset>(group_begin + 1);
+        while (group_end < run_end && hash_keys[group_end] == hash_keys[group_begin]) ++group_end;
+
+        auto& result = get_or_add_result(result_ids, results, hash_keys[group_begin], RowID(chunk_id, group_begin));
+
+        // If the value is NULL, the current aggregate value does not change
+        if (!null_values[run_index]) {
+          const auto& value = values[run_index];
+          const auto row_count = group_end - group_begin;
+
+          if constexpr ((function == AggregateFunction::Sum || function == AggregateFunction::Avg) &&
+                        std::is_integral_v<AggregateType>) {
+            const auto run_sum = static_cast<AggregateType>(value) * static_cast<AggregateType>(row_count);
+            if (result.current_aggregate) {
+              *result.current_aggregate += run_sum;
+            } else {
+              result.current_aggregate = run_sum;
+            }
+          } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+            // Multiplying floating point values would round differently than adding them row by row
+            for (auto row = size_t{0}; row < row_count; ++row) {
+              aggregator(value, result.current_aggregate);
+            }
+          } else {
+            // MIN, MAX, and COUNT are not affected by repeating the same value
+            aggregator(value, result.current_aggregate);
+          }
+
+          result.aggregate_count += row_count;
+
+          if constexpr (function == AggregateFunction::CountDistinct) {  // NOLINT
+            result.distinct_values.insert(value);
+          }
+        }
+
+        group_begin = group_end;
+      }
+
+      run_begin = run_end;
+    }
+
+    return;
+  }
+
   ChunkOffset chunk_offset{0};
   segment_iterate<ColumnDataType>(base_segment, [&](const auto& position) {
     auto& result = get_or_add_result(result_ids, results, hash_keys[chunk_offset], RowID(chunk_id, chunk_offset));
@@ -350,29 +430,67 @@ void Aggregate::_aggregate() {
           const auto chunk_in = input_table->get_chunk(chunk_id);
           const auto base_segment = chunk_in->get_segment(column_id);
 
-          ChunkOffset chunk_offset{0};
-          segment_iterate<ColumnDataType>(*base_segment, [&](const auto& position) {
-            if (position.is_null()) {
-              if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                keys_per_chunk[chunk_id][chunk_offset] = 0u;
-              } else {
-                keys_per_chunk[chunk_id][chunk_offset][group_column_index] = 0u;
-              }
+          const auto set_key = [&](const ChunkOffset chunk_offset, const AggregateKeyEntry key) {
+            if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+              keys_per_chunk[chunk_id][chunk_offset] = key;
             } else {
-              auto inserted = id_map.try_emplace(position.value(), id_counter);
-              // store either the current id_counter or the existing ID of the value
-              if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                keys_per_chunk[chunk_id][chunk_offset] = inserted.first->second;
-              } else {
-                keys_per_chunk[chunk_id][chunk_offset][group_column_index] = inserted.first->second;
-              }
-
-              // if the id_map didn't have the value as a key and a new element was inserted
-              if (inserted.second) ++id_counter;
+              keys_per_chunk[chunk_id][chunk_offset][group_column_index] = key;
+            }
+          };
+
+          // Returns either the current id_counter or the existing ID of the value
+          const auto get_or_add_id = [&](const ColumnDataType& value) {
+            const auto inserted = id_map.try_emplace(value, id_counter);
+
+            // if the id_map didn't have the value as a key and a new element was inserted
+            if (inserted.second) ++id_counter;
+
+            return inserted.first->second;
+          };
+
+          if (const auto dictionary_segment =
+                  std::dynamic_pointer_cast<const DictionarySegment<ColumnDataType>>(base_segment)) {
+            /*
+            The value IDs of a dictionary segment already are dense IDs of the chunk's values. Thus, only the
+            dictionary entries are hashed and the rows are mapped to their IDs through an array indexed by value ID.
+            The null value ID is the last one and maps to the reserved ID 0.
+            */
+            const auto& dictionary = *dictionary_segment->dictionary();
+            DebugAssert(dictionary_segment->null_value_id() == dictionary.size(), "Unexpected null value ID");
+
+            auto id_by_value_id = std::vector<AggregateKeyEntry>(dictionary.size() + 1, 0u);
+            for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+              id_by_value_id[value_id] = get_or_add_id(dictionary[value_id]);
             }
 
-            ++chunk_offset;
-          });
+            resolve_compressed_vector_type(*dictionary_segment->attribute_vector(), [&](const auto& attribute_vector) {
+              auto chunk_offset = ChunkOffset{0};
+              for (auto iter = attribute_vector.cbegin(); iter != attribute_vector.cend(); ++iter, ++chunk_offset) {
+                set_key(chunk_offset, id_by_value_id[*iter]);
+              }
+            });
+          } else if (const auto run_length_segment =
+                         std::dynamic_pointer_cast<const RunLengthSegment<ColumnDataType>>(base_segment)) {
+            // Each run is looked up once and all of its rows get the same ID
+            const auto& values = *run_length_segment->values();
+            const auto& null_values = *run_length_segment->null_values();
+            const auto& end_positions = *run_length_segment->end_positions();
+
+            auto run_begin = ChunkOffset{0};
+            for (auto run_index = size_t{0}; run_index < values.size(); ++run_index) {
+              const auto id = null_values[run_index] ? AggregateKeyEntry{0u} : get_or_add_id(values[run_index]);
+              for (auto chunk_offset = run_begin; chunk_offset <= end_positions[run_index]; ++chunk_offset) {
+                set_key(chunk_offset, id);
+              }
+              run_begin = end_positions[run_index] + 1;
+            }
+          } else {
+            ChunkOffset chunk_offset{0};
+            segment_iterate<ColumnDataType>(*base_segment, [&](const auto& position) {
+              set_key(chunk_offset, position.is_null() ? AggregateKeyEntry{0u} : get_or_add_id(position.value()));
+              ++chunk_offset;
+            });
+          }
         }
       });
     }));
@@ -9,6 +9,7 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -66,19 +67,31 @@ template <typename ColumnDataType, typename AggregateType>
 using AggregateResults = pmr_vector<AggregateResult<ColumnDataType, AggregateType>>;
 using AggregateResultId = size_t;
 
+/*
+The key type that is used for the aggregation map.
+*/
+using AggregateKeyEntry = uint64_t;
+
 // The AggregateResultIdMap maps AggregateKeys to their index in the list of aggregate results.
 template <typename AggregateKey>
 using AggregateResultIdMapAllocator = PolymorphicAllocator<std::pair<const AggregateKey, AggregateResultId>>;
 
 template <typename AggregateKey>
-using AggregateResultIdMap =
+using HashAggregateResultIdMap =
     std::unordered_map<AggregateKey, AggregateResultId, std::hash<AggregateKey>, std::equal_to<AggregateKey>,
                        AggregateResultIdMapAllocator<AggregateKey>>;
 
 /*
-The key type that is used for the aggregation map.
+With at most one group-by column, the AggregateKeys are the dense IDs assigned in the partitioning phase (see
+Aggregate::_aggregate()). Instead of hashing them, they are used as an index into a vector. Keys that were not seen
+yet map to INVALID_AGGREGATE_RESULT_ID.
 */
-using AggregateKeyEntry = uint64_t;
+using DenseAggregateResultIdMap = pmr_vector<AggregateResultId>;
+constexpr auto INVALID_AGGREGATE_RESULT_ID = std::numeric_limits<AggregateResultId>::max();
+
+template <typename AggregateKey>
+using AggregateResultIdMap = std::conditional_t<std::is_same_v<AggregateKey, AggregateKeyEntry>,
+                                                DenseAggregateResultIdMap, HashAggregateResultIdMap<AggregateKey>>;
 
 template <typename AggregateKey>
 using AggregateKeys = std::vector<AggregateKey>;
@@ -1,10 +1,16 @@
 #include "delete.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "concurrency/transaction_context.hpp"
 #include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/reference_segment.hpp"
@@ -87,6 +93,8 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
 }
 
 void Delete::_on_commit_records(const CommitID cid) {
+  auto stored_tables = std::unordered_map<std::shared_ptr<const Table>, std::optional<StoredTable>>{};
+
   for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
        ++referencing_chunk_id) {
     const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
@@ -107,6 +115,63 @@ void Delete::_on_commit_records(const CommitID cid) {
     if (table_statistics) {
       table_statistics->increase_invalid_row_count(referencing_segment->pos_list()->size());
     }
+
+    if (referencing_segment->pos_list()->empty()) continue;
+
+    auto stored_table_iter = stored_tables.find(referenced_table);
+    if (stored_table_iter == stored_tables.end()) {
+      stored_table_iter = stored_tables.emplace(referenced_table, _find_stored_table(referenced_table)).first;
+    }
+    const auto& stored_table = stored_table_iter->second;
+
+    // Cached query results read the stored table, not the copy that GetTable might have returned
+    referenced_table->update_last_commit_id(cid);
+    if (stored_table) stored_table->table->update_last_commit_id(cid);
+
+    if (Logger::get().is_enabled()) {
+      Assert(stored_table, "Deleted rows of a table that is not in the StorageManager cannot be logged");
+      _log_invalidations(*stored_table, *referencing_segment->pos_list());
+    }
+  }
+}
+
+std::optional<Delete::StoredTable> Delete::_find_stored_table(const std::shared_ptr<const Table>& referenced_table) {
+  const auto& tables = StorageManager::get().tables();
+  for (const auto& [name, table] : tables) {
+    if (table == referenced_table) return StoredTable{name, table, {}};
+  }
+
+  for (const auto& [name, table] : tables) {
+    if (table->column_definitions() != referenced_table->column_definitions()) continue;
+
+    auto stored_chunk_ids = std::unordered_map<std::shared_ptr<const Chunk>, ChunkID>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (chunk) stored_chunk_ids.emplace(chunk, chunk_id);
+    }
+
+    auto chunk_ids = std::vector<ChunkID>{};
+    chunk_ids.reserve(referenced_table->chunk_count());
+    for (auto chunk_id = ChunkID{0}; chunk_id < referenced_table->chunk_count(); ++chunk_id) {
+      const auto stored_chunk_id_iter = stored_chunk_ids.find(referenced_table->get_chunk(chunk_id));
+      if (stored_chunk_id_iter == stored_chunk_ids.end()) break;
+      chunk_ids.emplace_back(stored_chunk_id_iter->second);
+    }
+
+    if (chunk_ids.size() == static_cast<size_t>(referenced_table->chunk_count())) {
+      return StoredTable{name, table, std::move(chunk_ids)};
+    }
+  }
+
+  return std::nullopt;
+}
+
+void Delete::_log_invalidations(const StoredTable& stored_table, const PosList& pos_list) const {
+  // The log refers to the rows by their RowIDs in the stored table, which recovery invalidates
+  auto& logger = Logger::get();
+  for (const auto& row_id : pos_list) {
+    const auto chunk_id = stored_table.chunk_ids.empty() ? row_id.chunk_id : stored_table.chunk_ids[row_id.chunk_id];
+    logger.log_invalidation(_transaction_id, stored_table.name, RowID{chunk_id, row_id.chunk_offset});
   }
 }
 
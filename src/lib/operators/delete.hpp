@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,22 @@ class Delete : public AbstractReadWriteOperator {
   void _on_rollback_records() override;
 
  private:
+  struct StoredTable {
+    std::string name;
+    std::shared_ptr<const Table> table;
+    // The ChunkIDs within the stored table of the referenced table's chunks. Empty if the referenced table is stored.
+    std::vector<ChunkID> chunk_ids;
+  };
+
+  /**
+   * Returns the table in the StorageManager that the referenced table belongs to. GetTable returns a copy of the
+   * stored table if it excludes chunks (e.g., pruned or physically deleted ones). The copy shares the chunks of the
+   * stored table, which is found by comparing them.
+   */
+  static std::optional<StoredTable> _find_stored_table(const std::shared_ptr<const Table>& referenced_table);
+
+  void _log_invalidations(const StoredTable& stored_table, const PosList& pos_list) const;
+
   TransactionID _transaction_id;
   std::shared_ptr<const Table> _referencing_table;
 };
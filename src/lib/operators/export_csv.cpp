@@ -1,5 +1,6 @@
 #include "export_csv.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -9,6 +10,8 @@
 
 #include "import_export/csv_meta.hpp"
 #include "import_export/csv_writer.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/ordered_job_window.hpp"
 #include "storage/materialize.hpp"
 #include "storage/reference_segment.hpp"
 
@@ -71,29 +74,20 @@ void ExportCsv::_generate_content_file(const std::shared_ptr<const Table>& table
   CsvWriter writer(csv_file);
 
   /**
-   * Multiple rows containing the values of each respective row are written.
-   * Therefore we first iterate through the chunks, then through the rows
-   * in the chunks and afterwards through the segments of the chunks.
-   *
-   * This is a lot of iterating, but to convert a column-based table to
-   * a row-based representation takes some effort.
+   * Converting a column-based table to a row-based representation takes some effort. Each chunk is formatted into its
+   * own buffer by a separate task (see CsvWriter::format_chunk), the buffers are written to the file in chunk order.
+   * To bound the memory used by the buffers, only a few chunks per worker are formatted at the same time.
    */
-  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
-    const auto chunk = table->get_chunk(chunk_id);
-
-    for (ChunkOffset chunk_offset = 0; chunk_offset < chunk->size(); ++chunk_offset) {
-      for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
-        const auto segment = chunk->get_segment(column_id);
-
-        // The previous implementation did a double dispatch (at least two virtual method calls)
-        // So the subscript operator cannot be much slower.
-        const auto value = (*segment)[chunk_offset];
-        writer.write(value);
-      }
+  auto pending_chunks = OrderedJobWindow<std::string>{[&](std::string& rows) { writer.write_formatted_rows(rows); }};
 
-      writer.end_line();
-    }
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    pending_chunks.add(std::string{}, [&](std::string& rows) {
+      return std::vector<std::shared_ptr<AbstractTask>>{std::make_shared<JobTask>(
+          [&table, &rows, chunk_id]() { rows = CsvWriter::format_chunk(*table->get_chunk(chunk_id)); })};
+    });
   }
+
+  pending_chunks.finish_all();
 }
 
 }  // namespace opossum
@@ -1,13 +1,24 @@
 #include "index_scan.hpp"
 
 #include <algorithm>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
+#include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
 
 #include "storage/index/base_index.hpp"
+#include "storage/index/table_hash_index.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/storage_manager.hpp"
+#include "type_cast.hpp"
+#include "type_comparison.hpp"
 
 #include "utils/assert.hpp"
 
@@ -27,6 +38,8 @@ const std::string IndexScan::name() const { return "IndexScan"; }
 
 void IndexScan::set_included_chunk_ids(const std::vector<ChunkID>& chunk_ids) { _included_chunk_ids = chunk_ids; }
 
+void IndexScan::set_stored_table_name(const std::string& table_name) { _stored_table_name = table_name; }
+
 std::shared_ptr<const Table> IndexScan::_on_execute() {
   _in_table = input_table_left();
 
@@ -34,6 +47,19 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
 
   _out_table = std::make_shared<Table>(_in_table->column_definitions(), TableType::References);
 
+  if (_in_table->type() == TableType::References) {
+    _scan_reference_table();
+    return _out_table;
+  }
+
+  _indexed_table = _in_table;
+  _indexed_column_ids = _left_column_ids;
+
+  if (auto hash_index_matches = _lookup_in_hash_index()) {
+    _write_hash_index_matches(*hash_index_matches);
+    return _out_table;
+  }
+
   std::mutex output_mutex;
 
   auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
@@ -57,18 +83,24 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
 std::shared_ptr<AbstractOperator> IndexScan::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<IndexScan>(copied_input_left, _index_type, _left_column_ids, _predicate_condition,
-                                     _right_values, _right_values2);
+  const auto copy = std::make_shared<IndexScan>(copied_input_left, _index_type, _left_column_ids, _predicate_condition,
+                                                _right_values, _right_values2);
+  if (_stored_table_name) copy->set_stored_table_name(*_stored_table_name);
+  return copy;
 }
 
 void IndexScan::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
 std::shared_ptr<AbstractTask> IndexScan::_create_job_and_schedule(const ChunkID chunk_id, std::mutex& output_mutex) {
   auto job_task = std::make_shared<JobTask>([=, &output_mutex]() {
-    const auto matches_out = std::make_shared<PosList>(_scan_chunk(chunk_id));
-
     // The output chunk is allocated on the same NUMA node as the input chunk.
     const auto chunk = _in_table->get_chunk(chunk_id);
+
+    // A plan that was translated for a hash index (i.e., with SegmentIndexType::Invalid) might run after the stored
+    // table was replaced by one without that index. Like chunks without an index, its chunks are scanned directly.
+    const auto matches_out = std::make_shared<PosList>(chunk->get_index(_index_type, _indexed_column_ids)
+                                                           ? _scan_chunk(chunk_id)
+                                                           : _scan_chunk_without_index(chunk_id));
     Segments segments;
 
     for (ColumnID column_id{0u}; column_id < _in_table->column_count(); ++column_id) {
@@ -84,6 +116,209 @@ std::shared_ptr<AbstractTask> IndexScan::_create_job_and_schedule(const ChunkID
   return job_task;
 }
 
+std::optional<PosList> IndexScan::_lookup_in_hash_index() const {
+  if (_predicate_condition != PredicateCondition::Equals) return std::nullopt;
+
+  if (const auto hash_index = _indexed_table->get_hash_index(_indexed_column_ids)) {
+    return hash_index->lookup(_right_values);
+  }
+
+  // GetTable returns a copy without the hash indexes if it excludes chunks (e.g., pruned or physically deleted ones).
+  // The copy shares the chunks of the stored table, so the RowIDs of the stored table's index are mapped to it.
+  if (!_stored_table_name || !StorageManager::get().has_table(*_stored_table_name)) return std::nullopt;
+  const auto stored_table = StorageManager::get().get_table(*_stored_table_name);
+  const auto hash_index = stored_table->get_hash_index(_indexed_column_ids);
+  if (!hash_index) return std::nullopt;
+
+  // Look up the chunks before the index, so that rows inserted concurrently into new chunks are ignored
+  const auto stored_chunk_count = stored_table->chunk_count();
+  auto stored_chunk_ids = std::unordered_map<std::shared_ptr<const Chunk>, ChunkID>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < stored_chunk_count; ++chunk_id) {
+    const auto chunk = stored_table->get_chunk(chunk_id);
+    if (chunk) stored_chunk_ids.emplace(chunk, chunk_id);
+  }
+
+  // If a chunk of the indexed table is not part of the stored table, the tables are unrelated
+  auto indexed_chunk_ids = std::vector<std::optional<ChunkID>>(stored_chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < _indexed_table->chunk_count(); ++chunk_id) {
+    const auto stored_chunk_id_iter = stored_chunk_ids.find(_indexed_table->get_chunk(chunk_id));
+    if (stored_chunk_id_iter == stored_chunk_ids.end()) return std::nullopt;
+    indexed_chunk_ids[stored_chunk_id_iter->second] = chunk_id;
+  }
+
+  auto matches = PosList{};
+  for (const auto& row_id : hash_index->lookup(_right_values)) {
+    if (row_id.chunk_id >= stored_chunk_count || !indexed_chunk_ids[row_id.chunk_id]) continue;
+    matches.emplace_back(RowID{*indexed_chunk_ids[row_id.chunk_id], row_id.chunk_offset});
+  }
+  return matches;
+}
+
+void IndexScan::_write_hash_index_matches(PosList& matches) {
+  // A concurrent Insert might have appended a chunk and indexed its rows since the input was produced
+  const auto chunk_count = _in_table->chunk_count();
+  matches.erase(std::remove_if(matches.begin(), matches.end(),
+                               [&](const auto& row_id) {
+                                 if (row_id.chunk_id >= chunk_count) return true;
+                                 return !_included_chunk_ids.empty() &&
+                                        std::find(_included_chunk_ids.cbegin(), _included_chunk_ids.cend(),
+                                                  row_id.chunk_id) == _included_chunk_ids.cend();
+                               }),
+                matches.end());
+
+  // Emit one output chunk per input chunk that contains matches, as the chunk-based scan does
+  std::sort(matches.begin(), matches.end());
+
+  auto chunk_begin = matches.cbegin();
+  while (chunk_begin != matches.cend()) {
+    const auto chunk_id = chunk_begin->chunk_id;
+    const auto chunk_end = std::find_if(chunk_begin, matches.cend(),
+                                        [&](const auto& row_id) { return row_id.chunk_id != chunk_id; });
+
+    const auto matches_out = std::make_shared<PosList>(chunk_begin, chunk_end);
+    matches_out->guarantee_single_chunk();
+
+    Segments segments;
+    for (ColumnID column_id{0u}; column_id < _in_table->column_count(); ++column_id) {
+      segments.push_back(std::make_shared<ReferenceSegment>(_in_table, column_id, matches_out));
+    }
+    _out_table->append_chunk(segments, _in_table->get_chunk(chunk_id)->get_allocator());
+
+    chunk_begin = chunk_end;
+  }
+}
+
+void IndexScan::_scan_reference_table() {
+  if (_in_table->chunk_count() == 0) return;
+
+  auto input_chunk_ids = _included_chunk_ids;
+  if (input_chunk_ids.empty()) {
+    input_chunk_ids.resize(_in_table->chunk_count());
+    std::iota(input_chunk_ids.begin(), input_chunk_ids.end(), ChunkID{0});
+  }
+
+  // The indexes of the table referenced by the searched columns are used. As we intersect the index results with the
+  // positions of the input, all searched columns need to reference the same rows of that table.
+  const auto first_chunk = _in_table->get_chunk(input_chunk_ids.front());
+  _indexed_table = std::static_pointer_cast<const ReferenceSegment>(first_chunk->get_segment(_left_column_ids[0]))
+                       ->referenced_table();
+  _indexed_column_ids.clear();
+  for (const auto column_id : _left_column_ids) {
+    const auto segment = std::static_pointer_cast<const ReferenceSegment>(first_chunk->get_segment(column_id));
+    _indexed_column_ids.emplace_back(segment->referenced_column_id());
+  }
+
+  const auto searched_pos_list = [&](const ChunkID chunk_id) {
+    const auto chunk = _in_table->get_chunk(chunk_id);
+    const auto pos_list = std::static_pointer_cast<const ReferenceSegment>(chunk->get_segment(_left_column_ids[0]))
+                              ->pos_list();
+    for (const auto column_id : _left_column_ids) {
+      const auto segment = std::static_pointer_cast<const ReferenceSegment>(chunk->get_segment(column_id));
+      Assert(segment->referenced_table() == _indexed_table && segment->pos_list() == pos_list,
+             "IndexScan requires all searched columns to reference the same rows of the same table");
+    }
+    return pos_list;
+  };
+
+  // Find the chunks of the referenced table that are referenced by the input. Only those are searched.
+  auto is_chunk_referenced = std::vector<bool>(_indexed_table->chunk_count());
+  for (const auto chunk_id : input_chunk_ids) {
+    const auto pos_list = searched_pos_list(chunk_id);
+    if (pos_list->references_single_chunk() && !pos_list->empty()) {
+      is_chunk_referenced[pos_list->common_chunk_id()] = true;
+      continue;
+    }
+    for (const auto& row_id : *pos_list) {
+      if (!row_id.is_null()) is_chunk_referenced[row_id.chunk_id] = true;
+    }
+  }
+
+  // Search the referenced chunks. Each list of matches is sorted so that the input positions can be probed using a
+  // binary search.
+  auto matches_per_referenced_chunk = std::vector<PosList>(_indexed_table->chunk_count());
+
+  if (const auto hash_index_matches = _lookup_in_hash_index()) {
+    // A concurrent Insert might have appended a chunk and indexed its rows since the chunks were counted. Such rows
+    // are not referenced by the input.
+    for (const auto& row_id : *hash_index_matches) {
+      if (row_id.chunk_id < is_chunk_referenced.size() && is_chunk_referenced[row_id.chunk_id]) {
+        matches_per_referenced_chunk[row_id.chunk_id].emplace_back(row_id);
+      }
+    }
+    for (auto& matches : matches_per_referenced_chunk) {
+      std::sort(matches.begin(), matches.end());
+    }
+  } else {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < _indexed_table->chunk_count(); ++chunk_id) {
+      if (!is_chunk_referenced[chunk_id]) continue;
+
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        auto& matches = matches_per_referenced_chunk[chunk_id];
+        // Chunks without an index, e.g., the most recent, still mutable chunk, are scanned directly
+        const auto chunk = _indexed_table->get_chunk(chunk_id);
+        matches = chunk->get_index(_index_type, _indexed_column_ids) ? _scan_chunk(chunk_id)
+                                                                     : _scan_chunk_without_index(chunk_id);
+        std::sort(matches.begin(), matches.end());
+      }));
+      jobs.back()->schedule();
+    }
+    CurrentScheduler::wait_for_tasks(jobs);
+  }
+
+  // Intersect the matches with the positions of each input chunk
+  std::mutex output_mutex;
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(input_chunk_ids.size());
+  for (const auto chunk_id : input_chunk_ids) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto pos_list_in = searched_pos_list(chunk_id);
+
+      auto matching_offsets = std::vector<ChunkOffset>{};
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < pos_list_in->size(); ++chunk_offset) {
+        const auto& row_id = (*pos_list_in)[chunk_offset];
+        if (row_id.is_null()) continue;
+
+        const auto& matches = matches_per_referenced_chunk[row_id.chunk_id];
+        if (std::binary_search(matches.cbegin(), matches.cend(), row_id)) matching_offsets.emplace_back(chunk_offset);
+      }
+      if (matching_offsets.empty()) return;
+
+      // As in the TableScan, the output references the physical segments and shares PosLists between the segments
+      // that shared them in the input
+      const auto chunk_in = _in_table->get_chunk(chunk_id);
+      auto filtered_pos_lists = std::map<std::shared_ptr<const PosList>, std::shared_ptr<PosList>>{};
+
+      Segments segments;
+      for (ColumnID column_id{0u}; column_id < _in_table->column_count(); ++column_id) {
+        const auto ref_segment_in = std::static_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(column_id));
+        const auto& pos_list = ref_segment_in->pos_list();
+
+        auto& filtered_pos_list = filtered_pos_lists[pos_list];
+        if (!filtered_pos_list) {
+          filtered_pos_list = std::make_shared<PosList>();
+          filtered_pos_list->reserve(matching_offsets.size());
+          if (pos_list->references_single_chunk()) filtered_pos_list->guarantee_single_chunk();
+
+          for (const auto chunk_offset : matching_offsets) {
+            filtered_pos_list->emplace_back((*pos_list)[chunk_offset]);
+          }
+        }
+
+        segments.push_back(std::make_shared<ReferenceSegment>(ref_segment_in->referenced_table(),
+                                                              ref_segment_in->referenced_column_id(),
+                                                              filtered_pos_list));
+      }
+
+      std::lock_guard<std::mutex> lock(output_mutex);
+      _out_table->append_chunk(segments);
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+}
+
 void IndexScan::_validate_input() {
   Assert(_predicate_condition != PredicateCondition::Like, "Predicate condition not supported by index scan.");
   Assert(_predicate_condition != PredicateCondition::NotLike, "Predicate condition not supported by index scan.");
@@ -94,8 +329,6 @@ void IndexScan::_validate_input() {
     Assert(_left_column_ids.size() == _right_values2.size(),
            "Count mismatch: left column IDs and right values don’t have same size.");
   }
-
-  Assert(_in_table->type() == TableType::Data, "IndexScan only supports persistent tables right now.");
 }
 
 PosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
@@ -104,10 +337,10 @@ PosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
   auto range_begin = BaseIndex::Iterator{};
   auto range_end = BaseIndex::Iterator{};
 
-  const auto chunk = _in_table->get_chunk(chunk_id);
+  const auto chunk = _indexed_table->get_chunk(chunk_id);
   auto matches_out = PosList{};
 
-  const auto index = chunk->get_index(_index_type, _left_column_ids);
+  const auto index = chunk->get_index(_index_type, _indexed_column_ids);
   Assert(index != nullptr, "Index of specified type not found for segment (vector).");
 
   switch (_predicate_condition) {
@@ -164,4 +397,39 @@ PosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
   return matches_out;
 }
 
+PosList IndexScan::_scan_chunk_without_index(const ChunkID chunk_id) {
+  Assert(_indexed_column_ids.size() == 1, "Only single-column predicates can be evaluated without an index");
+
+  const auto& segment = *_indexed_table->get_chunk(chunk_id)->get_segment(_indexed_column_ids[0]);
+  auto matches_out = PosList{};
+
+  resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto value = type_cast_variant<ColumnDataType>(_right_values[0]);
+
+    if (_predicate_condition == PredicateCondition::Between) {
+      // Like the index lookup, which searches from the lower bound of the first value to the upper bound of the
+      // second value, both bounds are inclusive
+      const auto value2 = type_cast_variant<ColumnDataType>(_right_values2[0]);
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        if (!position.is_null() && position.value() >= value && position.value() <= value2) {
+          matches_out.emplace_back(RowID{chunk_id, position.chunk_offset()});
+        }
+      });
+      return;
+    }
+
+    with_comparator(_predicate_condition, [&](auto comparator) {
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        if (!position.is_null() && comparator(position.value(), value)) {
+          matches_out.emplace_back(RowID{chunk_id, position.chunk_offset()});
+        }
+      });
+    });
+  });
+
+  return matches_out;
+}
+
 }  // namespace opossum
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "abstract_read_only_operator.hpp"
 
@@ -17,6 +20,16 @@ class AbstractTask;
 /**
  * Operator that performs a predicate search using indices
  *
+ * If the predicate is Equals and the input table has a TableHashIndex on exactly the searched columns, the matching
+ * rows are looked up in that index, which only touches the chunks that contain matches. Otherwise, the chunk indexes
+ * of the given type are used. If GetTable excluded chunks, its output has no hash indexes. The hash index of the stored
+ * table is used instead if its name is set (see set_stored_table_name).
+ *
+ * The input may also be a reference table, e.g., the output of a Validate or of another scan. In that case, the
+ * indexes of the table referenced by the searched columns are searched and the results are intersected with the
+ * input's PosLists. Only the referenced chunks that are actually referenced by the input are searched. Referenced
+ * chunks without an index (e.g., the most recent, still mutable chunk) are scanned directly.
+ *
  * Note: Scans only the set of chunks passed to the constructor
  */
 class IndexScan : public AbstractReadOnlyOperator {
@@ -36,6 +49,14 @@ class IndexScan : public AbstractReadOnlyOperator {
    */
   void set_included_chunk_ids(const std::vector<ChunkID>& chunk_ids);
 
+  /**
+   * @brief The name of the stored table that the searched columns originate from.
+   *
+   * If set, its TableHashIndex is used even if GetTable excluded chunks and returned a copy of the table without the
+   * hash indexes.
+   */
+  void set_stored_table_name(const std::string& table_name);
+
  protected:
   std::shared_ptr<const Table> _on_execute() final;
 
@@ -47,6 +68,12 @@ class IndexScan : public AbstractReadOnlyOperator {
   void _validate_input();
   std::shared_ptr<AbstractTask> _create_job_and_schedule(const ChunkID chunk_id, std::mutex& output_mutex);
   PosList _scan_chunk(const ChunkID chunk_id);
+  PosList _scan_chunk_without_index(const ChunkID chunk_id);
+  // Returns the matches of an Equals predicate from the TableHashIndex in the chunk numbering of _indexed_table, or
+  // nullopt if no hash index can be used
+  std::optional<PosList> _lookup_in_hash_index() const;
+  void _write_hash_index_matches(PosList& matches);
+  void _scan_reference_table();
 
  private:
   const SegmentIndexType _index_type;
@@ -56,9 +83,15 @@ class IndexScan : public AbstractReadOnlyOperator {
   const std::vector<AllTypeVariant> _right_values2;
 
   std::vector<ChunkID> _included_chunk_ids;
+  std::optional<std::string> _stored_table_name;
 
   std::shared_ptr<const Table> _in_table;
   std::shared_ptr<Table> _out_table;
+
+  // The table whose indexes are searched and the searched columns within it. For data tables, these are the input
+  // table and _left_column_ids. For reference tables, these are the referenced table and columns.
+  std::shared_ptr<const Table> _indexed_table;
+  std::vector<ColumnID> _indexed_column_ids;
 };
 
 }  // namespace opossum
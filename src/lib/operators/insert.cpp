@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "logging/logger.hpp"
 #include "resolve_type.hpp"
 #include "storage/base_encoded_segment.hpp"
 #include "storage/storage_manager.hpp"
@@ -210,6 +211,11 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
       _inserted_rows.emplace_back(RowID{target_chunk_id, i});
     }
 
+    // The rows are indexed right away. They remain invisible to other transactions until the commit.
+    for (const auto& hash_index : _target_table->hash_indexes()) {
+      hash_index->insert(target_chunk_id, *target_chunk, start_index, start_index + current_num_rows_to_insert);
+    }
+
     input_offset += current_num_rows_to_insert;
     start_index = 0u;
   }
@@ -225,6 +231,21 @@ void Insert::_on_commit_records(const CommitID cid) {
     mvcc_data->begin_cids[row_id.chunk_offset] = cid;
     mvcc_data->tids[row_id.chunk_offset] = 0u;
   }
+
+  if (!_inserted_rows.empty()) _target_table->update_last_commit_id(cid);
+
+  auto& logger = Logger::get();
+  if (logger.is_enabled()) {
+    const auto transaction_id = transaction_context()->transaction_id();
+    auto values = std::vector<AllTypeVariant>(_target_table->column_count());
+    for (const auto& row_id : _inserted_rows) {
+      const auto chunk = _target_table->get_chunk(row_id.chunk_id);
+      for (auto column_id = ColumnID{0}; column_id < values.size(); ++column_id) {
+        values[column_id] = (*chunk->get_segment(column_id))[row_id.chunk_offset];
+      }
+      logger.log_value(transaction_id, _target_table_name, row_id, values);
+    }
+  }
 }
 
 void Insert::_on_rollback_records() {
@@ -237,6 +258,11 @@ void Insert::_on_rollback_records() {
     chunk->get_scoped_mvcc_data_lock()->begin_cids[row_id.chunk_offset] = 0u;
 
     chunk->get_scoped_mvcc_data_lock()->tids[row_id.chunk_offset] = 0u;
+
+    // The rows never become visible, so they are removed from the hash indexes
+    for (const auto& hash_index : _target_table->hash_indexes()) {
+      hash_index->erase(row_id.chunk_id, *chunk, row_id.chunk_offset, row_id.chunk_offset + 1);
+    }
   }
 }
 
@@ -0,0 +1,82 @@
+#include "jit_execution_advisor.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include "expression/abstract_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/placeholder_expression.hpp"
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+
+namespace opossum {
+
+double JitExecutionAdvisor::ExecutionStatistics::walltime_per_row() const {
+  return static_cast<double>(walltime.count()) / static_cast<double>(std::max(row_count, size_t{1}));
+}
+
+std::string JitExecutionAdvisor::query_template(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  // Values are replaced in a copy, as the plan might be executed concurrently. Subqueries are replaced as well, since
+  // their descriptions contain their addresses.
+  const auto template_lqp = lqp->deep_copy();
+
+  auto stream = std::stringstream{};
+  visit_lqp(template_lqp, [&](auto& node) {
+    for (auto& node_expression : node->node_expressions) {
+      visit_expression(node_expression, [&](auto& expression) {
+        if (expression->type != ExpressionType::Value && expression->type != ExpressionType::CorrelatedParameter &&
+            expression->type != ExpressionType::LQPSubquery) {
+          return ExpressionVisitation::VisitArguments;
+        }
+        expression = std::make_shared<PlaceholderExpression>(ParameterID{0});
+        return ExpressionVisitation::DoNotVisitArguments;
+      });
+    }
+    stream << node->description() << "\n";
+    return LQPVisitation::VisitInputs;
+  });
+
+  return stream.str();
+}
+
+bool JitExecutionAdvisor::should_use_jit(const std::string& query_template, const size_t input_row_count) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& statistics = _statistics[query_template];
+  ++statistics.decision_count;
+
+  const auto& jit = statistics.jit;
+  const auto& regular = statistics.regular;
+
+  if (jit.execution_count < MIN_SAMPLE_COUNT || regular.execution_count < MIN_SAMPLE_COUNT) {
+    // Jitted templates are executed by the regular operators until they are compared with them
+    if (jit.execution_count >= MIN_SAMPLE_COUNT) return false;
+    return input_row_count >= MIN_JIT_ROW_COUNT || statistics.decision_count >= HOT_EXECUTION_COUNT;
+  }
+
+  const auto jit_is_faster = jit.walltime_per_row() < regular.walltime_per_row();
+  if (statistics.decision_count % EXPLORATION_INTERVAL == 0) return !jit_is_faster;
+  return jit_is_faster;
+}
+
+void JitExecutionAdvisor::record_execution(const std::string& query_template, const bool used_jit,
+                                           const size_t input_row_count, const std::chrono::nanoseconds walltime) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& statistics = _statistics[query_template];
+  auto& execution_statistics = used_jit ? statistics.jit : statistics.regular;
+  ++execution_statistics.execution_count;
+  execution_statistics.row_count += input_row_count;
+  execution_statistics.walltime += walltime;
+}
+
+JitExecutionAdvisor::TemplateStatistics JitExecutionAdvisor::statistics(const std::string& query_template) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto iter = _statistics.find(query_template);
+  return iter != _statistics.end() ? iter->second : TemplateStatistics{};
+}
+
+void JitExecutionAdvisor::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _statistics.clear();
+}
+
+}  // namespace opossum
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/* The JitExecutionAdvisor decides whether a plan that is executed with JitExecutionMode::Adaptive is executed by the
+ * regular operators or by its compiled operator pipeline. Decisions and runtimes are recorded per query template,
+ * i.e., per plan without the values of its literals and parameters.
+ *
+ * Until both variants of a template have been executed MIN_SAMPLE_COUNT times, only pipelines with at least
+ * MIN_JIT_ROW_COUNT input rows and templates that have been executed HOT_EXECUTION_COUNT times are jitted, as the
+ * compilation is unlikely to pay off for small and rarely executed queries. Afterwards, the variant with the lower
+ * runtime per input row is used. Every EXPLORATION_INTERVAL-th execution uses the other variant, so that changes (e.g.,
+ * of the data) are noticed.
+ *
+ * The JitOperatorWrapper only jits a pipeline once its compiled code is available, so that neither the compilation
+ * nor the interpretation of the pipeline adds to the latency of a query.
+ */
+class JitExecutionAdvisor : public Singleton<JitExecutionAdvisor> {
+ public:
+  static constexpr auto MIN_JIT_ROW_COUNT = size_t{100'000};
+  static constexpr auto HOT_EXECUTION_COUNT = size_t{20};
+  static constexpr auto MIN_SAMPLE_COUNT = size_t{3};
+  static constexpr auto EXPLORATION_INTERVAL = size_t{100};
+
+  struct ExecutionStatistics {
+    double walltime_per_row() const;
+
+    size_t execution_count{0};
+    size_t row_count{0};
+    std::chrono::nanoseconds walltime{0};
+  };
+
+  struct TemplateStatistics {
+    size_t decision_count{0};
+    ExecutionStatistics regular;
+    ExecutionStatistics jit;
+  };
+
+  // Returns the description of the @param lqp without the values of its literals and parameters
+  static std::string query_template(const std::shared_ptr<AbstractLQPNode>& lqp);
+
+  // Returns whether the template should be jitted for an input with @param input_row_count rows
+  bool should_use_jit(const std::string& query_template, const size_t input_row_count);
+
+  void record_execution(const std::string& query_template, const bool used_jit, const size_t input_row_count,
+                        const std::chrono::nanoseconds walltime);
+
+  TemplateStatistics statistics(const std::string& query_template) const;
+
+  void clear();
+
+ protected:
+  JitExecutionAdvisor() = default;
+
+  friend class Singleton;
+
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, TemplateStatistics> _statistics;
+};
+
+}  // namespace opossum
@@ -34,6 +34,12 @@ class AbstractJittableSink : public AbstractJittable {
   // It is used to create a new chunk in the output table for each input chunk.
   virtual void after_chunk(const std::shared_ptr<const Table>& in_table, Table& out_table,
                            JitRuntimeContext& context) const {}
+
+  // This function is called by the JitOperatorWrapper if the chunks were pushed through the pipeline by multiple
+  // workers, each with its own context (see JitOperatorWrapper). The workers' contexts are merged into the context
+  // passed to after_query(), in the order of the chunks they processed. The output chunks that the workers created in
+  // after_chunk() are appended to the output table by the JitOperatorWrapper.
+  virtual void merge_worker_context(JitRuntimeContext& context, JitRuntimeContext& worker_context) const {}
 };
 
 }  // namespace opossum
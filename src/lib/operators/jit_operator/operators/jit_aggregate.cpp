@@ -1,5 +1,7 @@
 #include "jit_aggregate.hpp"
 
+#include <algorithm>
+
 #include "constant_mappings.hpp"
 #include "operators/jit_operator/jit_operations.hpp"
 #include "resolve_type.hpp"
@@ -182,8 +184,128 @@ DataType get_sum_data_type(const DataType data_type) {
   }
 }
 
+// Compares two hashmap values using NULL == NULL semantics
+bool hashmap_values_equal(const JitHashmapEntry& hashmap_entry, const size_t index, JitRuntimeContext& context,
+                          const size_t worker_index, JitRuntimeContext& worker_context) {
+  const auto is_null = hashmap_entry.is_null(index, context);
+  const auto worker_is_null = hashmap_entry.is_null(worker_index, worker_context);
+  if (is_null || worker_is_null) return is_null && worker_is_null;
+
+  auto equal = false;
+  resolve_data_type(hashmap_entry.data_type(), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    equal = hashmap_entry.get<ColumnDataType>(index, context) ==
+            hashmap_entry.get<ColumnDataType>(worker_index, worker_context);
+  });
+  return equal;
+}
+
+// Appends the hashmap value of a worker to the corresponding hashmap column of the context
+void append_hashmap_value(const JitHashmapEntry& hashmap_entry, JitRuntimeContext& context,
+                          const size_t worker_index, JitRuntimeContext& worker_context) {
+  resolve_data_type(hashmap_entry.data_type(), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    const auto index = context.hashmap.columns[hashmap_entry.column_index()].template grow_by_one<ColumnDataType>(
+        JitVariantVector::InitialValue::Zero);
+    hashmap_entry.set<ColumnDataType>(hashmap_entry.get<ColumnDataType>(worker_index, worker_context), index,
+                                      context);
+    hashmap_entry.set_is_null(hashmap_entry.is_null(worker_index, worker_context), index, context);
+  });
+}
+
+// Combines the aggregate value of a worker with the aggregate value of the same group in the context
+void combine_aggregate_values(const AggregateFunction function, const JitHashmapEntry& hashmap_entry,
+                              const size_t index, JitRuntimeContext& context, const size_t worker_index,
+                              JitRuntimeContext& worker_context) {
+  // NULL aggregates (i.e., the worker did not encounter a non-NULL value for the group) do not change the aggregate
+  if (hashmap_entry.is_null(worker_index, worker_context)) return;
+
+  resolve_data_type(hashmap_entry.data_type(), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    const auto worker_value = hashmap_entry.get<ColumnDataType>(worker_index, worker_context);
+
+    if (hashmap_entry.is_null(index, context)) {
+      hashmap_entry.set<ColumnDataType>(worker_value, index, context);
+      hashmap_entry.set_is_null(false, index, context);
+      return;
+    }
+
+    const auto value = hashmap_entry.get<ColumnDataType>(index, context);
+    switch (function) {
+      case AggregateFunction::Count:
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+        if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+          hashmap_entry.set<ColumnDataType>(value + worker_value, index, context);
+        } else {
+          Fail("Invalid aggregate");
+        }
+        break;
+      case AggregateFunction::Max:
+        hashmap_entry.set<ColumnDataType>(std::max(value, worker_value), index, context);
+        break;
+      case AggregateFunction::Min:
+        hashmap_entry.set<ColumnDataType>(std::min(value, worker_value), index, context);
+        break;
+      case AggregateFunction::CountDistinct:
+        Fail("Aggregate function count distinct not supported");
+    }
+  });
+}
+
 }  // namespace
 
+void JitAggregate::merge_worker_context(JitRuntimeContext& context, JitRuntimeContext& worker_context) const {
+  // The hashmap only maps hashes to groups. Restore the hash of each group of the worker, so that the groups can be
+  // merged in the order in which the worker created them.
+  auto worker_group_hashes = std::vector<uint64_t>{};
+  for (const auto& [hash_value, hash_bucket] : worker_context.hashmap.indices) {
+    for (const auto worker_index : hash_bucket) {
+      if (worker_index >= worker_group_hashes.size()) worker_group_hashes.resize(worker_index + 1);
+      worker_group_hashes[worker_index] = hash_value;
+    }
+  }
+
+  auto group_count = size_t{0};
+  for (const auto& [hash_value, hash_bucket] : context.hashmap.indices) {
+    group_count += hash_bucket.size();
+  }
+
+  for (auto worker_index = size_t{0}; worker_index < worker_group_hashes.size(); ++worker_index) {
+    auto& hash_bucket = context.hashmap.indices[worker_group_hashes[worker_index]];
+
+    const auto match = std::find_if(hash_bucket.cbegin(), hash_bucket.cend(), [&](const auto index) {
+      return std::all_of(_groupby_columns.cbegin(), _groupby_columns.cend(), [&](const auto& groupby_column) {
+        return hashmap_values_equal(groupby_column.hashmap_entry, index, context, worker_index, worker_context);
+      });
+    });
+
+    if (match != hash_bucket.cend()) {
+      for (const auto& aggregate_column : _aggregate_columns) {
+        combine_aggregate_values(aggregate_column.function, aggregate_column.hashmap_entry, *match, context,
+                                 worker_index, worker_context);
+        if (aggregate_column.hashmap_count_for_avg) {
+          combine_aggregate_values(AggregateFunction::Count, *aggregate_column.hashmap_count_for_avg, *match, context,
+                                   worker_index, worker_context);
+        }
+      }
+      continue;
+    }
+
+    // The group was not found by a previous worker - copy it
+    for (const auto& groupby_column : _groupby_columns) {
+      append_hashmap_value(groupby_column.hashmap_entry, context, worker_index, worker_context);
+    }
+    for (const auto& aggregate_column : _aggregate_columns) {
+      append_hashmap_value(aggregate_column.hashmap_entry, context, worker_index, worker_context);
+      if (aggregate_column.hashmap_count_for_avg) {
+        append_hashmap_value(*aggregate_column.hashmap_count_for_avg, context, worker_index, worker_context);
+      }
+    }
+    hash_bucket.emplace_back(group_count++);
+  }
+}
+
 void JitAggregate::add_aggregate_column(const std::string& column_name, const JitTupleEntry& tuple_entry,
                                         const AggregateFunction function) {
   auto column_position = _aggregate_columns.size() + _groupby_columns.size();
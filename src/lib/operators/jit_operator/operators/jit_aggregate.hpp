@@ -51,6 +51,12 @@ struct JitGroupByColumn {
  *   These are (roughly) the same operations a std::unordered_map would perform internally.
  * - After all tuples have been processed, the output table is created from the output vectors.
  *
+ * If the pipeline is executed by multiple workers, each worker builds its own hashmap and output vectors. These are
+ * merged afterwards (see merge_worker_context()): the groups of each worker are looked up in the merged hashmap in the
+ * order in which the worker created them, so that the groups are output in the same order as in a single-threaded
+ * execution. The aggregates of groups found by multiple workers are combined (COUNTs and SUMs are added, MINs and MAXs
+ * are compared).
+ *
  * Averages can not easily be updated on the fly. Instead, each average aggregate triggers the computation of two
  * aggregates on the same value (a SUM and a COUNT). After all tuples have been consumed, the quotient of these
  * aggregates is computed in a post-processing step to produce the requested averages.
@@ -71,6 +77,10 @@ class JitAggregate : public AbstractJittableSink {
   // This is used to perform the post-processing for average aggregates and to build the final output table.
   void after_query(Table& out_table, JitRuntimeContext& context) const final;
 
+  // Is called by the JitOperatorWrapper if the pipeline was executed by multiple workers.
+  // This is used to merge the groups of a worker into the hashmap of the context and to combine their aggregates.
+  void merge_worker_context(JitRuntimeContext& context, JitRuntimeContext& worker_context) const final;
+
   // Adds an aggregate to the operator that is to be computed on tuple groups.
   void add_aggregate_column(const std::string& column_name, const JitTupleEntry& tuple_entry,
                             const AggregateFunction function);
@@ -0,0 +1,181 @@
+#include "jit_code_cache.hpp"
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "cache/gdfs_cache.hpp"
+#include "jit_code_specializer.hpp"
+#include "jit_runtime_pointer.hpp"
+#include "operators/jit_operator/operators/jit_aggregate.hpp"
+#include "operators/jit_operator/operators/jit_read_tuples.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+const JitReadTuples* JitCodeCache::CompiledPipeline::source() const {
+  return static_cast<const JitReadTuples*>(jit_operators.front().get());
+}
+
+JitCodeCache::JitCodeCache()
+    : _compiled_pipelines{
+          std::make_unique<GDFSCache<std::string, std::shared_ptr<const CompiledPipeline>>>(DEFAULT_CAPACITY)} {}
+
+JitCodeCache::~JitCodeCache() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _compilation_queued.notify_one();
+  if (_compile_thread.joinable()) _compile_thread.join();
+}
+
+std::shared_ptr<const JitCodeCache::CompiledPipeline> JitCodeCache::get_or_compile(
+    const std::string& signature, const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators) {
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    // Another query might be compiling the same pipeline already
+    _compilation_done.wait(lock, [&]() { return !_pending_signatures.count(signature); });
+
+    if (_compiled_pipelines->has(signature)) return _compiled_pipelines->get(signature);
+
+    _pending_signatures.emplace(signature);
+  }
+
+  auto compiled_pipeline = std::shared_ptr<const CompiledPipeline>{};
+  try {
+    compiled_pipeline = _compile(jit_operators);
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _pending_signatures.erase(signature);
+    }
+    _compilation_done.notify_all();
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache(signature, compiled_pipeline);
+    _pending_signatures.erase(signature);
+  }
+  _compilation_done.notify_all();
+
+  return compiled_pipeline;
+}
+
+std::shared_ptr<const JitCodeCache::CompiledPipeline> JitCodeCache::try_get_or_compile_in_background(
+    const std::string& signature, const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_compiled_pipelines->has(signature)) return _compiled_pipelines->get(signature);
+
+    if (_pending_signatures.count(signature) || _failed_signatures.count(signature)) return nullptr;
+
+    _pending_signatures.emplace(signature);
+    _compilation_queue.emplace_back(signature, jit_operators);
+    if (!_compile_thread.joinable()) _compile_thread = std::thread{&JitCodeCache::_compile_loop, this};
+  }
+  _compilation_queued.notify_one();
+
+  return nullptr;
+}
+
+void JitCodeCache::wait_for_background_compilations() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _compilation_done.wait(lock, [&]() { return _pending_signatures.empty(); });
+}
+
+size_t JitCodeCache::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _compiled_pipelines->size();
+}
+
+size_t JitCodeCache::capacity() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _compiled_pipelines->capacity();
+}
+
+void JitCodeCache::resize(const size_t capacity) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _compiled_pipelines->resize(capacity);
+}
+
+void JitCodeCache::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Assert(_pending_signatures.empty(), "Cannot clear the JitCodeCache while pipelines are compiled");
+  _compiled_pipelines->clear();
+  _failed_signatures.clear();
+}
+
+std::shared_ptr<const JitCodeCache::CompiledPipeline> JitCodeCache::_compile(
+    const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators) {
+  const auto begin = std::chrono::steady_clock::now();
+  auto compiled_pipeline = std::make_shared<CompiledPipeline>();
+  compiled_pipeline->jit_operators = jit_operators;
+  compiled_pipeline->specializer = std::make_shared<JitCodeSpecializer>();
+
+  // We want to perform two specialization passes if the operator chain contains a JitAggregate operator, since the
+  // JitAggregate operator contains multiple loops that need unrolling.
+  const auto two_specialization_passes =
+      static_cast<bool>(std::dynamic_pointer_cast<JitAggregate>(jit_operators.back()));
+
+  // this corresponds to "opossum::JitReadTuples::execute(opossum::JitRuntimeContext&) const"
+  compiled_pipeline->execute_func =
+      compiled_pipeline->specializer->specialize_and_compile_function<void(const JitReadTuples*, JitRuntimeContext&)>(
+          "_ZNK7opossum13JitReadTuples7executeERNS_17JitRuntimeContextE",
+          std::make_shared<JitConstantRuntimePointer>(compiled_pipeline->source()), two_specialization_passes);
+
+  compiled_pipeline->compilation_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+  return compiled_pipeline;
+}
+
+void JitCodeCache::_compile_loop() {
+  while (true) {
+    auto signature = std::string{};
+    auto jit_operators = std::vector<std::shared_ptr<AbstractJittable>>{};
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _compilation_queued.wait(lock, [&]() { return _shutdown || !_compilation_queue.empty(); });
+      if (_shutdown) return;
+
+      std::tie(signature, jit_operators) = std::move(_compilation_queue.front());
+      _compilation_queue.pop_front();
+    }
+
+    auto compiled_pipeline = std::shared_ptr<const CompiledPipeline>{};
+    try {
+      compiled_pipeline = _compile(jit_operators);
+    } catch (const std::exception&) {
+      // The queries keep executing the pipeline in interpreted mode
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (compiled_pipeline) {
+        _cache(signature, compiled_pipeline);
+      } else {
+        _failed_signatures.emplace(signature);
+      }
+      _pending_signatures.erase(signature);
+    }
+    _compilation_done.notify_all();
+  }
+}
+
+void JitCodeCache::_cache(const std::string& signature,
+                          const std::shared_ptr<const CompiledPipeline>& compiled_pipeline) {
+  if (_compiled_pipelines->capacity() == 0) return;
+
+  // Pipelines that took long to compile are preferably kept. Zero costs are avoided.
+  const auto cost = static_cast<double>(compiled_pipeline->compilation_time.count()) + 1.0;
+  _compiled_pipelines->set(signature, compiled_pipeline, cost);
+}
+
+}  // namespace opossum
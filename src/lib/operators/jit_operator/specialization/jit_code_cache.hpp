@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "cache/abstract_cache_impl.hpp"
+#include "operators/jit_operator/operators/abstract_jittable.hpp"
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+class JitCodeSpecializer;
+class JitReadTuples;
+
+/* The JitCodeCache holds the compiled JIT operator pipelines of all queries. Pipelines are identified by a signature
+ * (see JitOperatorWrapper), so that queries of the same shape share the compiled code instead of specializing and
+ * compiling their pipeline again.
+ *
+ * The specialized code depends on the operator objects it was specialized for, as values are loaded from them during
+ * specialization and the remaining code may still access them. Thus, a cached pipeline keeps its operators alive and
+ * its function must be called with its own source (see CompiledPipeline::source()). The values that differ between
+ * queries of the same shape (i.e., literals and parameters) are passed in the runtime context, which is prepared by
+ * the operators of each query.
+ *
+ * Pipelines can either be compiled while the caller waits (get_or_compile()) or by a background thread
+ * (try_get_or_compile_in_background()), so that a query can start executing its pipeline in interpreted mode and use
+ * the compiled function once it is available. Since the JitRepository only allows one specialization at a time, a
+ * single background thread compiles the pipelines in the order in which they were requested.
+ *
+ * The signature contains the literal values of a pipeline, so the number of signatures is unbounded. Thus, the cache
+ * holds at most capacity() pipelines and evicts according to the GDFS policy with the compilation time as cost. A
+ * pipeline that is evicted stays valid for the queries that still use it.
+ *
+ * The cache is not persisted, as the compiled code refers to the addresses of the operator objects of this process.
+ */
+class JitCodeCache : public Singleton<JitCodeCache> {
+ public:
+  using ExecuteFunction = std::function<void(const JitReadTuples*, JitRuntimeContext&)>;
+
+  struct CompiledPipeline {
+    const JitReadTuples* source() const;
+
+    std::vector<std::shared_ptr<AbstractJittable>> jit_operators;
+    std::shared_ptr<JitCodeSpecializer> specializer;
+    ExecuteFunction execute_func;
+    std::chrono::nanoseconds compilation_time{0};
+  };
+
+  static constexpr auto DEFAULT_CAPACITY = size_t{256};
+
+  ~JitCodeCache();
+
+  // Returns the compiled pipeline for the signature. If it is not cached yet, the chained @param jit_operators are
+  // compiled, which blocks the caller until the compilation is done.
+  std::shared_ptr<const CompiledPipeline> get_or_compile(
+      const std::string& signature, const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators);
+
+  // Returns the compiled pipeline for the signature if it is cached. Otherwise, the chained @param jit_operators are
+  // queued for compilation in the background (unless the signature is already being compiled) and nullptr is returned.
+  std::shared_ptr<const CompiledPipeline> try_get_or_compile_in_background(
+      const std::string& signature, const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators);
+
+  // Waits for all queued compilations to finish
+  void wait_for_background_compilations();
+
+  size_t size() const;
+  size_t capacity() const;
+
+  // Evicts pipelines if the cache holds more than @param capacity pipelines. A capacity of zero disables caching.
+  void resize(const size_t capacity);
+
+  // Removes all cached pipelines. Must not be called while pipelines are compiled.
+  void clear();
+
+ protected:
+  JitCodeCache();
+
+  friend class Singleton;
+
+  static std::shared_ptr<const CompiledPipeline> _compile(
+      const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators);
+
+  void _compile_loop();
+
+  // Requires the lock
+  void _cache(const std::string& signature, const std::shared_ptr<const CompiledPipeline>& compiled_pipeline);
+
+  // Protects the members below
+  mutable std::mutex _mutex;
+  std::condition_variable _compilation_queued;
+  std::condition_variable _compilation_done;
+
+  std::unique_ptr<AbstractCacheImpl<std::string, std::shared_ptr<const CompiledPipeline>>> _compiled_pipelines;
+
+  // Signatures that are queued or being compiled
+  std::unordered_set<std::string> _pending_signatures;
+
+  // Signatures whose compilation failed. Their pipelines are not compiled again and keep being interpreted.
+  std::unordered_set<std::string> _failed_signatures;
+
+  std::deque<std::pair<std::string, std::vector<std::shared_ptr<AbstractJittable>>>> _compilation_queue;
+  std::thread _compile_thread;
+  bool _shutdown{false};
+};
+
+}  // namespace opossum
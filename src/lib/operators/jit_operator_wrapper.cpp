@@ -1,8 +1,22 @@
 #include "jit_operator_wrapper.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
 #include "expression/expression_utils.hpp"
+#include "logical_query_plan/lqp_translator.hpp"
+#include "operators/jit_operator/jit_execution_advisor.hpp"
 #include "operators/jit_operator/operators/jit_aggregate.hpp"
 #include "operators/jit_operator/operators/jit_validate.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/operator_task.hpp"
+#include "scheduler/topology.hpp"
+#include "utils/timer.hpp"
 
 namespace opossum {
 
@@ -37,6 +51,12 @@ const std::vector<AllTypeVariant>& JitOperatorWrapper::input_parameter_values()
   return _input_parameter_values;
 }
 
+void JitOperatorWrapper::set_lqp(const std::shared_ptr<AbstractLQPNode>& lqp,
+                                 const std::shared_ptr<AbstractLQPNode>& input_node) {
+  _adaptive_execution_plan = std::make_shared<AdaptiveExecutionPlan>(
+      AdaptiveExecutionPlan{lqp, input_node, JitExecutionAdvisor::query_template(lqp)});
+}
+
 const std::shared_ptr<JitReadTuples> JitOperatorWrapper::_source() const {
   return std::dynamic_pointer_cast<JitReadTuples>(_specialized_function_wrapper->jit_operators.front());
 }
@@ -49,6 +69,31 @@ std::shared_ptr<const Table> JitOperatorWrapper::_on_execute() {
   Assert(_source(), "JitOperatorWrapper does not have a valid source node.");
   Assert(_sink(), "JitOperatorWrapper does not have a valid sink node.");
 
+  if (_execution_mode != JitExecutionMode::Adaptive) {
+    return _execute_jit_operators(_prepare_and_specialize_operator_pipeline());
+  }
+
+  Assert(_adaptive_execution_plan, "JitExecutionMode::Adaptive requires the LQP of the pipeline");
+  auto& jit_execution_advisor = JitExecutionAdvisor::get();
+  const auto& query_template = _adaptive_execution_plan->query_template;
+  const auto input_row_count = static_cast<size_t>(input_table_left()->row_count());
+
+  // The pipeline is only jitted once it has been compiled. Until then, it is compiled in the background.
+  auto compiled_pipeline = std::shared_ptr<const JitCodeCache::CompiledPipeline>{};
+  if (jit_execution_advisor.should_use_jit(query_template, input_row_count)) {
+    compiled_pipeline = _prepare_and_specialize_operator_pipeline();
+  }
+
+  auto timer = Timer{};
+  const auto output = compiled_pipeline ? _execute_jit_operators(compiled_pipeline) : _execute_regular_operators();
+  jit_execution_advisor.record_execution(query_template, static_cast<bool>(compiled_pipeline), input_row_count,
+                                         timer.lap());
+
+  return output;
+}
+
+std::shared_ptr<const Table> JitOperatorWrapper::_execute_jit_operators(
+    const std::shared_ptr<const JitCodeCache::CompiledPipeline>& compiled_pipeline) {
   const auto in_table = input_left()->get_output();
 
   auto out_table = _sink()->create_output_table(*in_table);
@@ -62,12 +107,26 @@ std::shared_ptr<const Table> JitOperatorWrapper::_on_execute() {
   _source()->before_query(*in_table, _input_parameter_values, context);
   _sink()->before_query(*out_table, context);
 
-  _prepare_and_specialize_operator_pipeline();
+  // Without a compiled pipeline, the functions of the operators are called directly
+  const auto execute_func =
+      compiled_pipeline ? compiled_pipeline->execute_func : JitCodeCache::ExecuteFunction{&JitReadTuples::execute};
+  const auto* const source = compiled_pipeline ? compiled_pipeline->source() : _source().get();
+
+  // A JitLimit operator counts the emitted rows in the context and stops the execution once the limit is reached.
+  // Thus, pipelines with a limit are executed by a single worker.
+  const auto chunk_count = static_cast<size_t>(in_table->chunk_count());
+  const auto worker_count = CurrentScheduler::is_set() && !_source()->row_count_expression()
+                                ? std::min(chunk_count, std::max(Topology::get().num_cpus(), size_t{1}))
+                                : size_t{1};
 
-  for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count() && context.limit_rows; ++chunk_id) {
-    _source()->before_chunk(*in_table, chunk_id, context);
-    _specialized_function_wrapper->execute_func(_source().get(), context);
-    _sink()->after_chunk(in_table, *out_table, context);
+  if (worker_count > 1) {
+    _execute_in_parallel(in_table, *out_table, context, execute_func, source, worker_count);
+  } else {
+    for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count() && context.limit_rows; ++chunk_id) {
+      _source()->before_chunk(*in_table, chunk_id, context);
+      execute_func(source, context);
+      _sink()->after_chunk(in_table, *out_table, context);
+    }
   }
 
   _sink()->after_query(*out_table, context);
@@ -75,45 +134,150 @@ std::shared_ptr<const Table> JitOperatorWrapper::_on_execute() {
   return out_table;
 }
 
-void JitOperatorWrapper::_prepare_and_specialize_operator_pipeline() {
+std::shared_ptr<const Table> JitOperatorWrapper::_execute_regular_operators() const {
+  const auto input_operator = std::make_shared<TableWrapper>(input_table_left());
+  const auto pqp = InputReplacingLQPTranslator{_adaptive_execution_plan->input_node, input_operator}.translate_node(
+      _adaptive_execution_plan->lqp);
+
+  if (transaction_context_is_set()) pqp->set_transaction_context_recursively(transaction_context());
+  pqp->set_parameters(_parameters);
+
+  CurrentScheduler::schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp, CleanupTemporaries::Yes));
+
+  return pqp->get_output();
+}
+
+void JitOperatorWrapper::_execute_in_parallel(const std::shared_ptr<const Table>& in_table, Table& out_table,
+                                              JitRuntimeContext& context,
+                                              const JitCodeCache::ExecuteFunction& execute_func,
+                                              const JitReadTuples* source, const size_t worker_count) const {
+  // Each worker processes a contiguous range of chunks with its own context and writes its output chunks to its own
+  // table. The operators in the pipeline are stateless, so that the specialized function can be called concurrently.
+  struct Worker {
+    JitRuntimeContext context;
+    std::shared_ptr<Table> out_table;
+  };
+  auto workers = std::vector<Worker>(worker_count);
+
+  const auto chunk_count = static_cast<size_t>(in_table->chunk_count());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(worker_count);
+  for (auto worker_id = size_t{0}; worker_id < worker_count; ++worker_id) {
+    const auto begin_chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_count * worker_id / worker_count)};
+    const auto end_chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_count * (worker_id + 1) / worker_count)};
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, begin_chunk_id, end_chunk_id, worker_id]() {
+      auto& worker = workers[worker_id];
+
+      // The literals and parameters have already been written to the tuple by JitReadTuples::before_query()
+      worker.context.tuple = context.tuple;
+      worker.context.limit_rows = context.limit_rows;
+      worker.context.transaction_id = context.transaction_id;
+      worker.context.snapshot_commit_id = context.snapshot_commit_id;
+
+      worker.out_table = _sink()->create_output_table(*in_table);
+      _sink()->before_query(*worker.out_table, worker.context);
+
+      for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+        _source()->before_chunk(*in_table, chunk_id, worker.context);
+        execute_func(source, worker.context);
+        _sink()->after_chunk(in_table, *worker.out_table, worker.context);
+      }
+    }));
+  }
+  CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+
+  // Merging the workers in the order of their chunk ranges produces the same output as a single-threaded execution
+  for (auto& worker : workers) {
+    const auto worker_chunk_count = worker.out_table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < worker_chunk_count; ++chunk_id) {
+      out_table.append_chunk(worker.out_table->get_chunk(chunk_id));
+    }
+    _sink()->merge_worker_context(context, worker.context);
+  }
+}
+
+std::shared_ptr<const JitCodeCache::CompiledPipeline> JitOperatorWrapper::_prepare_and_specialize_operator_pipeline() {
   // Use a mutex to specialize a jittable operator pipeline within a subquery only once.
   // See jit_operator_wrapper.hpp for details.
   std::lock_guard<std::mutex> guard(_specialized_function_wrapper->specialization_mutex);
-  if (_specialized_function_wrapper->execute_func) return;
+  auto& specialized_function_wrapper = *_specialized_function_wrapper;
 
-  const auto jit_operators = _specialized_function_wrapper->jit_operators;
+  const auto& jit_operators = specialized_function_wrapper.jit_operators;
 
-  for (auto& jit_operator : jit_operators) {
-    if (auto jit_validate = std::dynamic_pointer_cast<JitValidate>(jit_operator)) {
-      jit_validate->set_input_table_type(input_left()->get_output()->type());
+  if (!specialized_function_wrapper.is_prepared) {
+    for (auto& jit_operator : jit_operators) {
+      if (auto jit_validate = std::dynamic_pointer_cast<JitValidate>(jit_operator)) {
+        jit_validate->set_input_table_type(input_left()->get_output()->type());
+      }
+    }
+
+    // Connect operators to a chain
+    for (auto it = jit_operators.begin(); it != jit_operators.end() && it + 1 != jit_operators.end(); ++it) {
+      (*it)->set_next_operator(*(it + 1));
     }
-  }
 
-  // Connect operators to a chain
-  for (auto it = jit_operators.begin(); it != jit_operators.end() && it + 1 != jit_operators.end(); ++it) {
-    (*it)->set_next_operator(*(it + 1));
+    specialized_function_wrapper.signature = _pipeline_signature();
+    specialized_function_wrapper.is_prepared = true;
   }
 
-  std::function<void(const JitReadTuples*, JitRuntimeContext&)> execute_func;
-  // We want to perform two specialization passes if the operator chain contains a JitAggregate operator, since the
-  // JitAggregate operator contains multiple loops that need unrolling.
-  auto two_specialization_passes = static_cast<bool>(std::dynamic_pointer_cast<JitAggregate>(_sink()));
+  if (specialized_function_wrapper.compiled_pipeline) return specialized_function_wrapper.compiled_pipeline;
+
+  auto& jit_code_cache = JitCodeCache::get();
   switch (_execution_mode) {
     case JitExecutionMode::Compile:
-      // this corresponds to "opossum::JitReadTuples::execute(opossum::JitRuntimeContext&) const"
-      _specialized_function_wrapper->execute_func =
-          _specialized_function_wrapper->module
-              .specialize_and_compile_function<void(const JitReadTuples*, JitRuntimeContext&)>(
-                  "_ZNK7opossum13JitReadTuples7executeERNS_17JitRuntimeContextE",
-                  std::make_shared<JitConstantRuntimePointer>(_source().get()), two_specialization_passes);
+      specialized_function_wrapper.compiled_pipeline =
+          jit_code_cache.get_or_compile(specialized_function_wrapper.signature, jit_operators);
+      break;
+    case JitExecutionMode::CompileInBackground:
+    case JitExecutionMode::Adaptive:
+      // Until the compilation is done, each execution checks whether the compiled pipeline is available
+      specialized_function_wrapper.compiled_pipeline =
+          jit_code_cache.try_get_or_compile_in_background(specialized_function_wrapper.signature, jit_operators);
       break;
     case JitExecutionMode::Interpret:
-      _specialized_function_wrapper->execute_func = &JitReadTuples::execute;
       break;
   }
+
+  return specialized_function_wrapper.compiled_pipeline;
+}
+
+std::string JitOperatorWrapper::_pipeline_signature() const {
+  // The descriptions of the operators contain neither the data types of the values nor the exact values of
+  // floating-point literals, which are loaded from the operators during specialization.
+  auto signature = std::stringstream{};
+  signature << std::setprecision(std::numeric_limits<double>::max_digits10);
+  signature << "input table type " << static_cast<int>(input_left()->get_output()->type()) << "\n";
+
+  const auto add_tuple_entry = [&](const JitTupleEntry& tuple_entry) {
+    signature << "x" << tuple_entry.tuple_index() << ": " << static_cast<int>(tuple_entry.data_type())
+              << (tuple_entry.is_nullable() ? " nullable" : "") << ", ";
+  };
+
+  for (const auto& input_column : _source()->input_columns()) {
+    add_tuple_entry(input_column.tuple_entry);
+  }
+  for (const auto& input_literal : _source()->input_literals()) {
+    add_tuple_entry(input_literal.tuple_entry);
+    signature << "= " << input_literal.value << ", ";
+  }
+  for (const auto& input_parameter : _source()->input_parameters()) {
+    add_tuple_entry(input_parameter.tuple_entry);
+  }
+  signature << "\n";
+
+  for (const auto& jit_operator : _specialized_function_wrapper->jit_operators) {
+    signature << jit_operator->description() << "\n";
+  }
+
+  return signature.str();
 }
 
 void JitOperatorWrapper::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  // The regular operators are created during the execution (see JitExecutionMode::Adaptive)
+  _parameters = parameters;
+
   const auto& input_parameters = _source()->input_parameters();
   _input_parameter_values.resize(input_parameters.size());
 
@@ -140,7 +304,10 @@ void JitOperatorWrapper::_on_set_transaction_context(const std::weak_ptr<Transac
 std::shared_ptr<AbstractOperator> JitOperatorWrapper::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<JitOperatorWrapper>(copied_input_left, _execution_mode, _specialized_function_wrapper);
+  const auto copy =
+      std::make_shared<JitOperatorWrapper>(copied_input_left, _execution_mode, _specialized_function_wrapper);
+  copy->_adaptive_execution_plan = _adaptive_execution_plan;
+  return copy;
 }
 
 }  // namespace opossum
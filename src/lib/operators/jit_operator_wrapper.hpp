@@ -1,15 +1,24 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "abstract_read_only_operator.hpp"
 #include "jit_operator/operators/abstract_jittable_sink.hpp"
 #include "jit_operator/operators/jit_read_tuples.hpp"
-#include "operators/jit_operator/specialization/jit_code_specializer.hpp"
+#include "operators/jit_operator/specialization/jit_code_cache.hpp"
 
 namespace opossum {
 
-enum class JitExecutionMode { Interpret, Compile };
+// Interpret:           The functions of the jittable operators are called without specializing them.
+// Compile:             The pipeline is specialized and compiled before its first execution.
+// CompileInBackground: The pipeline is interpreted until it has been specialized and compiled in the background.
+// Adaptive:            The JitExecutionAdvisor decides for each execution whether the plan is executed by the regular
+//                      operators or by the compiled pipeline, which is compiled in the background (see set_lqp()).
+enum class JitExecutionMode { Interpret, Compile, CompileInBackground, Adaptive };
+
+class AbstractLQPNode;
 
 /* The JitOperatorWrapper wraps a number of jittable operators and exposes them through Hyrise's default
  * operator interface. This allows a number of jit operators to be seamlessly integrated with
@@ -17,12 +26,19 @@ enum class JitExecutionMode { Interpret, Compile };
  * The JitOperatorWrapper is responsible for chaining the operators it contains, compiling code for the operators at
  * runtime, creating and managing the runtime context and calling hooks (before/after processing a chunk or the entire
  * query) on the its operators.
+ * If a scheduler is set, the chunks are distributed across multiple workers, each with its own runtime context. The
+ * output chunks and contexts of the workers are merged before the query is finalized (see
+ * AbstractJittableSink::merge_worker_context). Pipelines with a JitLimit operator are executed by a single worker.
+ * Compiled pipelines are shared with other queries of the same shape through the JitCodeCache. The shape of a pipeline
+ * is described by its signature, which consists of the descriptions of its operators, the data types of its input
+ * values, the values of its literals, and the type of its input table.
  */
 class JitOperatorWrapper : public AbstractReadOnlyOperator {
  public:
   /* The SpecializedFunctionWrapper allows the JitOperatorWrapper to share a jittable operator pipeline and the
    * specialized function from this pipeline between multiple JitOperatorWrapper instances. The mutex ensures that the
-   * same pipeline within a correlated subquery is specialized only once when executed in parallel.
+   * same pipeline within a correlated subquery is prepared and looked up in the JitCodeCache only once when executed
+   * in parallel.
    *
    * During the evaluation of a correlated subquery, multiple subqueries can be executed in parallel. If no mutex is
    * used, the first executed JitOperatorWrapper instance will start specializing the jittable operator pipeline which
@@ -33,13 +49,14 @@ class JitOperatorWrapper : public AbstractReadOnlyOperator {
    */
   struct SpecializedFunctionWrapper {
     std::vector<std::shared_ptr<AbstractJittable>> jit_operators;
-    std::function<void(const JitReadTuples*, JitRuntimeContext&)> execute_func;
+    std::string signature;
+    std::shared_ptr<const JitCodeCache::CompiledPipeline> compiled_pipeline;
+    bool is_prepared{false};
     std::mutex specialization_mutex;
-    JitCodeSpecializer module;
   };
 
   explicit JitOperatorWrapper(const std::shared_ptr<const AbstractOperator>& left,
-                              const JitExecutionMode execution_mode = JitExecutionMode::Compile,
+                              const JitExecutionMode execution_mode = JitExecutionMode::CompileInBackground,
                               const std::shared_ptr<SpecializedFunctionWrapper>& specialized_function_wrapper =
                                   std::make_shared<SpecializedFunctionWrapper>());
 
@@ -53,6 +70,10 @@ class JitOperatorWrapper : public AbstractReadOnlyOperator {
   const std::vector<std::shared_ptr<AbstractJittable>>& jit_operators() const;
   const std::vector<AllTypeVariant>& input_parameter_values() const;
 
+  // Required for JitExecutionMode::Adaptive. @param lqp is the plan that the jittable operators were created from and
+  // @param input_node the node that the input operator was created from. The regular operators are translated from it.
+  void set_lqp(const std::shared_ptr<AbstractLQPNode>& lqp, const std::shared_ptr<AbstractLQPNode>& input_node);
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
@@ -63,15 +84,37 @@ class JitOperatorWrapper : public AbstractReadOnlyOperator {
   void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
 
  private:
+  struct AdaptiveExecutionPlan {
+    std::shared_ptr<AbstractLQPNode> lqp;
+    std::shared_ptr<AbstractLQPNode> input_node;
+    std::string query_template;
+  };
+
   const std::shared_ptr<JitReadTuples> _source() const;
   const std::shared_ptr<AbstractJittableSink> _sink() const;
 
-  void _prepare_and_specialize_operator_pipeline();
+  // Returns the compiled pipeline, or nullptr if the pipeline has to be interpreted
+  std::shared_ptr<const JitCodeCache::CompiledPipeline> _prepare_and_specialize_operator_pipeline();
+
+  std::string _pipeline_signature() const;
+
+  std::shared_ptr<const Table> _execute_jit_operators(
+      const std::shared_ptr<const JitCodeCache::CompiledPipeline>& compiled_pipeline);
+
+  // Executes the plan set with set_lqp() by the regular operators
+  std::shared_ptr<const Table> _execute_regular_operators() const;
+
+  void _execute_in_parallel(const std::shared_ptr<const Table>& in_table, Table& out_table, JitRuntimeContext& context,
+                            const JitCodeCache::ExecuteFunction& execute_func, const JitReadTuples* source,
+                            const size_t worker_count) const;
 
   const JitExecutionMode _execution_mode;
   const std::shared_ptr<SpecializedFunctionWrapper> _specialized_function_wrapper;
 
   std::vector<AllTypeVariant> _input_parameter_values;
+
+  std::shared_ptr<const AdaptiveExecutionPlan> _adaptive_execution_plan;
+  std::unordered_map<ParameterID, AllTypeVariant> _parameters;
 };
 
 }  // namespace opossum
@@ -0,0 +1,384 @@
+#include "join_band.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "join_nested_loop.hpp"
+#include "multi_predicate_join/multi_predicate_join_evaluator.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+bool is_inequality(const PredicateCondition predicate_condition) {
+  return predicate_condition == PredicateCondition::LessThan ||
+         predicate_condition == PredicateCondition::LessThanEquals ||
+         predicate_condition == PredicateCondition::GreaterThan ||
+         predicate_condition == PredicateCondition::GreaterThanEquals;
+}
+
+}  // namespace
+
+namespace opossum {
+
+JoinBand::JoinBand(const std::shared_ptr<const AbstractOperator>& left,
+                   const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
+                   const OperatorJoinPredicate& primary_predicate,
+                   const std::vector<OperatorJoinPredicate>& secondary_predicates)
+    : AbstractJoinOperator(OperatorType::JoinBand, left, right, mode, primary_predicate, secondary_predicates) {
+  Assert(mode == JoinMode::Inner || mode == JoinMode::Left || mode == JoinMode::Right || mode == JoinMode::FullOuter ||
+             mode == JoinMode::Semi || mode == JoinMode::AntiNullAsFalse,
+         "JoinBand does not support this join mode.");
+  Assert(is_inequality(primary_predicate.predicate_condition), "JoinBand requires an inequality as primary predicate.");
+}
+
+const std::string JoinBand::name() const { return "JoinBand"; }
+
+bool JoinBand::supports(const JoinMode mode, const PredicateCondition predicate_condition,
+                        const DataType left_data_type, const DataType right_data_type) {
+  if (mode == JoinMode::Cross || mode == JoinMode::AntiNullAsTrue) return false;
+  return is_inequality(predicate_condition) && left_data_type == right_data_type;
+}
+
+std::shared_ptr<AbstractOperator> JoinBand::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  return std::make_shared<JoinBand>(copied_input_left, copied_input_right, _mode, _primary_predicate,
+                                    _secondary_predicates);
+}
+
+void JoinBand::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
+
+std::shared_ptr<const Table> JoinBand::_on_execute() {
+  const auto left_data_type = input_table_left()->column_data_type(_primary_predicate.column_ids.first);
+  Assert(left_data_type == input_table_right()->column_data_type(_primary_predicate.column_ids.second),
+         "The columns of the primary predicate of a JoinBand must have the same data type.");
+
+  _impl = make_unique_by_data_type<AbstractJoinOperatorImpl, JoinBandImpl>(left_data_type, *this);
+  return _impl->_on_execute();
+}
+
+void JoinBand::_on_cleanup() { _impl.reset(); }
+
+template <typename T>
+class JoinBand::JoinBandImpl : public AbstractJoinOperatorImpl {
+ public:
+  explicit JoinBandImpl(JoinBand& join_band)
+      : _join_band{join_band},
+        _mode{join_band._mode},
+        _is_semi_or_anti_join{_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse} {}
+
+  std::shared_ptr<const Table> _on_execute() override {
+    const auto left_table = _join_band.input_table_left();
+    const auto right_table = _join_band.input_table_right();
+
+    _choose_sorted_side(*left_table, *right_table);
+
+    const auto& sorted_table = _sort_left ? left_table : right_table;
+    const auto& probe_table = _sort_left ? right_table : left_table;
+
+    const auto sorted_rows = _materialize_sorted_rows(*sorted_table);
+
+    const auto track_left_matches = _mode == JoinMode::Left || _mode == JoinMode::FullOuter || _is_semi_or_anti_join;
+    const auto track_right_matches = _mode == JoinMode::Right || _mode == JoinMode::FullOuter;
+    const auto track_probe_matches = _sort_left ? track_right_matches : track_left_matches;
+    const auto track_sorted_matches = _sort_left ? track_left_matches : track_right_matches;
+
+    // For Semi/Anti joins with the left input as the probe side, the first match of a probe row is sufficient
+    const auto stop_at_first_match = _is_semi_or_anti_join && !track_sorted_matches;
+
+    // Each chunk of the probe side is joined in a separate job, which writes its own output chunk. The matches of the
+    // sorted rows are tracked per job and merged afterwards.
+    auto output_chunks = std::vector<Segments>(probe_table->chunk_count());
+    auto probe_matches_by_chunk = std::vector<std::vector<bool>>(probe_table->chunk_count());
+    auto sorted_matches = std::vector<bool>(track_sorted_matches ? sorted_rows.size() : 0);
+    auto sorted_matches_mutex = std::mutex{};
+
+    const auto join_probe_chunk = [&](const ChunkID probe_chunk_id) {
+      const auto chunk = probe_table->get_chunk(probe_chunk_id);
+      const auto chunk_size = chunk->size();
+
+      // Materialize the values of the range predicates. Rows with a NULL value cannot find a match.
+      auto probe_values = std::vector<std::vector<T>>(_range_predicates.size(), std::vector<T>(chunk_size));
+      auto probe_value_is_null = std::vector<bool>(chunk_size);
+      for (auto predicate_id = size_t{0}; predicate_id < _range_predicates.size(); ++predicate_id) {
+        auto& values = probe_values[predicate_id];
+        segment_iterate<T>(*chunk->get_segment(_range_predicates[predicate_id].probe_column_id),
+                           [&](const auto& position) {
+                             if (position.is_null()) {
+                               probe_value_is_null[position.chunk_offset()] = true;
+                             } else {
+                               values[position.chunk_offset()] = position.value();
+                             }
+                           });
+      }
+
+      // The segment accessors of the evaluator are not thread-safe, so each job uses its own
+      auto secondary_predicate_evaluator = std::optional<MultiPredicateJoinEvaluator>{};
+      if (!_evaluated_predicates.empty()) {
+        secondary_predicate_evaluator.emplace(*left_table, *right_table, _evaluated_predicates);
+      }
+
+      const auto pos_list_left = std::make_shared<PosList>();
+      const auto pos_list_right = std::make_shared<PosList>();
+
+      auto& probe_matches = probe_matches_by_chunk[probe_chunk_id];
+      if (track_probe_matches) probe_matches.resize(chunk_size);
+      auto job_sorted_matches = std::vector<bool>(sorted_matches.size());
+
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (probe_value_is_null[chunk_offset]) continue;
+
+        auto range_begin = sorted_rows.cbegin();
+        auto range_end = sorted_rows.cend();
+        for (auto predicate_id = size_t{0}; predicate_id < _range_predicates.size(); ++predicate_id) {
+          _narrow_range(range_begin, range_end, _range_predicates[predicate_id].predicate_condition,
+                        probe_values[predicate_id][chunk_offset]);
+        }
+
+        const auto probe_row_id = RowID{probe_chunk_id, chunk_offset};
+        for (auto sorted_row = range_begin; sorted_row < range_end; ++sorted_row) {
+          const auto& left_row_id = _sort_left ? sorted_row->second : probe_row_id;
+          const auto& right_row_id = _sort_left ? probe_row_id : sorted_row->second;
+          if (secondary_predicate_evaluator &&
+              !secondary_predicate_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+            continue;
+          }
+
+          if (!_is_semi_or_anti_join) {
+            pos_list_left->emplace_back(left_row_id);
+            pos_list_right->emplace_back(right_row_id);
+          }
+          if (track_probe_matches) probe_matches[chunk_offset] = true;
+          if (track_sorted_matches) job_sorted_matches[sorted_row - sorted_rows.cbegin()] = true;
+          if (stop_at_first_match) break;
+        }
+      }
+
+      if (track_sorted_matches) {
+        const auto lock = std::lock_guard<std::mutex>{sorted_matches_mutex};
+        for (auto sorted_row_id = size_t{0}; sorted_row_id < sorted_matches.size(); ++sorted_row_id) {
+          if (job_sorted_matches[sorted_row_id]) sorted_matches[sorted_row_id] = true;
+        }
+      }
+
+      if (!pos_list_left->empty()) {
+        _write_output_chunk(output_chunks[probe_chunk_id], pos_list_left, pos_list_right);
+      }
+    };
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(probe_table->chunk_count());
+    for (auto probe_chunk_id = ChunkID{0}; probe_chunk_id < probe_table->chunk_count(); ++probe_chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, probe_chunk_id] { join_probe_chunk(probe_chunk_id); }));
+    }
+    CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+
+    const auto output_table = _join_band._initialize_output_table();
+    for (auto& segments : output_chunks) {
+      if (!segments.empty()) output_table->append_chunk(segments);
+    }
+
+    // Rows with NULL values are not part of the sorted rows and thus never marked as matched
+    auto sorted_matches_by_chunk = std::vector<std::vector<bool>>{};
+    if (track_sorted_matches) {
+      sorted_matches_by_chunk.resize(sorted_table->chunk_count());
+      for (auto chunk_id = ChunkID{0}; chunk_id < sorted_table->chunk_count(); ++chunk_id) {
+        sorted_matches_by_chunk[chunk_id].resize(sorted_table->get_chunk(chunk_id)->size());
+      }
+      for (auto sorted_row_id = size_t{0}; sorted_row_id < sorted_rows.size(); ++sorted_row_id) {
+        if (!sorted_matches[sorted_row_id]) continue;
+        const auto& row_id = sorted_rows[sorted_row_id].second;
+        sorted_matches_by_chunk[row_id.chunk_id][row_id.chunk_offset] = true;
+      }
+    }
+    const auto& left_matches_by_chunk = _sort_left ? sorted_matches_by_chunk : probe_matches_by_chunk;
+    const auto& right_matches_by_chunk = _sort_left ? probe_matches_by_chunk : sorted_matches_by_chunk;
+
+    // Add the left rows without a match for Left, Full Outer, and Anti joins, or with a match for Semi joins
+    if (track_left_matches) {
+      const auto pos_list_left = std::make_shared<PosList>();
+      const auto pos_list_right = std::make_shared<PosList>();
+      for (auto chunk_id = ChunkID{0}; chunk_id < left_table->chunk_count(); ++chunk_id) {
+        const auto& left_matches = left_matches_by_chunk[chunk_id];
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+          if (left_matches[chunk_offset] != (_mode == JoinMode::Semi)) continue;
+          pos_list_left->emplace_back(chunk_id, chunk_offset);
+          if (!_is_semi_or_anti_join) pos_list_right->emplace_back(NULL_ROW_ID);
+        }
+      }
+      _append_output_chunk(*output_table, pos_list_left, pos_list_right);
+    }
+
+    // Add the right rows without a match for Right and Full Outer joins
+    if (track_right_matches) {
+      const auto pos_list_left = std::make_shared<PosList>();
+      const auto pos_list_right = std::make_shared<PosList>();
+      for (auto chunk_id = ChunkID{0}; chunk_id < right_table->chunk_count(); ++chunk_id) {
+        const auto& right_matches = right_matches_by_chunk[chunk_id];
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < right_matches.size(); ++chunk_offset) {
+          if (right_matches[chunk_offset]) continue;
+          pos_list_left->emplace_back(NULL_ROW_ID);
+          pos_list_right->emplace_back(chunk_id, chunk_offset);
+        }
+      }
+      _append_output_chunk(*output_table, pos_list_left, pos_list_right);
+    }
+
+    // If there are no matches at all, the output consists of a single empty chunk
+    if (output_table->chunk_count() == 0) {
+      Segments segments;
+      _write_output_chunk(segments, std::make_shared<PosList>(), std::make_shared<PosList>());
+      output_table->append_chunk(segments);
+    }
+
+    return output_table;
+  }
+
+ protected:
+  using SortedRows = std::vector<std::pair<T, RowID>>;
+
+  // A predicate that restricts the sorted rows to a contiguous range, read as
+  // `<value in the sorted column> <predicate_condition> <value in the probe column>`
+  struct RangePredicate {
+    ColumnID sorted_column_id;
+    ColumnID probe_column_id;
+    PredicateCondition predicate_condition;
+  };
+
+  /**
+   * Sorts the side whose column is used by the primary predicate and by a secondary inequality predicate, so that both
+   * predicates define the range of matching rows (band join). Otherwise, the smaller input is sorted.
+   */
+  void _choose_sorted_side(const Table& left_table, const Table& right_table) {
+    const auto& primary_predicate = _join_band._primary_predicate;
+    const auto& secondary_predicates = _join_band._secondary_predicates;
+    const auto data_type = left_table.column_data_type(primary_predicate.column_ids.first);
+
+    _sort_left = left_table.row_count() <= right_table.row_count();
+
+    auto band_predicate_id = std::optional<size_t>{};
+    for (auto predicate_id = size_t{0}; predicate_id < secondary_predicates.size(); ++predicate_id) {
+      const auto& secondary_predicate = secondary_predicates[predicate_id];
+      if (!is_inequality(secondary_predicate.predicate_condition) ||
+          left_table.column_data_type(secondary_predicate.column_ids.first) != data_type ||
+          right_table.column_data_type(secondary_predicate.column_ids.second) != data_type) {
+        continue;
+      }
+
+      if (secondary_predicate.column_ids.first == primary_predicate.column_ids.first) {
+        _sort_left = true;
+      } else if (secondary_predicate.column_ids.second == primary_predicate.column_ids.second) {
+        _sort_left = false;
+      } else {
+        continue;
+      }
+      band_predicate_id = predicate_id;
+      break;
+    }
+
+    const auto add_range_predicate = [&](OperatorJoinPredicate predicate) {
+      // The range predicates are read from the sorted side
+      if (!_sort_left) predicate.flip();
+      _range_predicates.emplace_back(
+          RangePredicate{predicate.column_ids.first, predicate.column_ids.second, predicate.predicate_condition});
+    };
+
+    add_range_predicate(primary_predicate);
+    for (auto predicate_id = size_t{0}; predicate_id < secondary_predicates.size(); ++predicate_id) {
+      if (predicate_id == band_predicate_id) {
+        add_range_predicate(secondary_predicates[predicate_id]);
+      } else {
+        _evaluated_predicates.emplace_back(secondary_predicates[predicate_id]);
+      }
+    }
+  }
+
+  /**
+   * Materializes the non-NULL values of the sorted column together with their RowIDs and sorts them by value
+   */
+  SortedRows _materialize_sorted_rows(const Table& sorted_table) const {
+    const auto sorted_column_id = _range_predicates.front().sorted_column_id;
+
+    auto sorted_rows = SortedRows{};
+    sorted_rows.reserve(sorted_table.row_count());
+    for (auto chunk_id = ChunkID{0}; chunk_id < sorted_table.chunk_count(); ++chunk_id) {
+      segment_iterate<T>(*sorted_table.get_chunk(chunk_id)->get_segment(sorted_column_id), [&](const auto& position) {
+        if (position.is_null()) return;
+        sorted_rows.emplace_back(position.value(), RowID{chunk_id, position.chunk_offset()});
+      });
+    }
+
+    std::sort(sorted_rows.begin(), sorted_rows.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return sorted_rows;
+  }
+
+  /**
+   * Narrows [range_begin, range_end) to the sorted rows whose value satisfies `<sorted value> <condition> value`
+   */
+  static void _narrow_range(typename SortedRows::const_iterator& range_begin,
+                            typename SortedRows::const_iterator& range_end, const PredicateCondition condition,
+                            const T& value) {
+    const auto row_is_less = [](const auto& row, const T& search_value) { return row.first < search_value; };
+    const auto value_is_less = [](const T& search_value, const auto& row) { return search_value < row.first; };
+
+    switch (condition) {
+      case PredicateCondition::LessThan:
+        range_end = std::lower_bound(range_begin, range_end, value, row_is_less);
+        break;
+      case PredicateCondition::LessThanEquals:
+        range_end = std::upper_bound(range_begin, range_end, value, value_is_less);
+        break;
+      case PredicateCondition::GreaterThan:
+        range_begin = std::upper_bound(range_begin, range_end, value, value_is_less);
+        break;
+      case PredicateCondition::GreaterThanEquals:
+        range_begin = std::lower_bound(range_begin, range_end, value, row_is_less);
+        break;
+      default:
+        Fail("Unsupported predicate condition");
+    }
+  }
+
+  // Writes the segments of both inputs (or only of the left input for Semi/Anti joins) to the output chunk
+  void _write_output_chunk(Segments& segments, const std::shared_ptr<PosList>& pos_list_left,
+                           const std::shared_ptr<PosList>& pos_list_right) const {
+    JoinNestedLoop::_write_output_segments(segments, _join_band.input_table_left(), pos_list_left);
+    if (!_is_semi_or_anti_join) {
+      JoinNestedLoop::_write_output_segments(segments, _join_band.input_table_right(), pos_list_right);
+    }
+  }
+
+  void _append_output_chunk(Table& output_table, const std::shared_ptr<PosList>& pos_list_left,
+                            const std::shared_ptr<PosList>& pos_list_right) const {
+    if (pos_list_left->empty()) return;
+
+    Segments segments;
+    _write_output_chunk(segments, pos_list_left, pos_list_right);
+    output_table.append_chunk(segments);
+  }
+
+  JoinBand& _join_band;
+  const JoinMode _mode;
+  const bool _is_semi_or_anti_join;
+
+  bool _sort_left{};
+  std::vector<RangePredicate> _range_predicates;
+
+  // Secondary predicates that do not restrict the range and are evaluated for each row within the range
+  std::vector<OperatorJoinPredicate> _evaluated_predicates;
+};
+
+}  // namespace opossum
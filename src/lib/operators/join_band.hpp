@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "operator_join_predicate.hpp"
+#include "storage/pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Sort-based join for inequality predicates (<, <=, >, >=), e.g., `a.x < b.y` or band joins such as
+ * `a.t BETWEEN b.start AND b.end` (i.e., `a.t >= b.start AND a.t <= b.end`).
+ *
+ * One input (the sorted side) is materialized and sorted by its column of the primary predicate. For each row of the
+ * other input (the probe side), the rows of the sorted side that satisfy the primary predicate form a contiguous
+ * range, which is found by binary search. If a secondary inequality predicate uses the same column of the sorted side
+ * (as in band joins), it narrows the range further. Thus, only the matching rows are enumerated instead of all pairs
+ * of rows. The remaining secondary predicates are evaluated on the rows within the range.
+ *
+ * For band joins, the side whose column is bounded from both sides is sorted. Otherwise, the smaller input is sorted.
+ * The chunks of the probe side are joined in parallel.
+ *
+ * The columns of the primary predicate need to have the same data type. Use JoinBand::supports() to check whether a
+ * join can be executed by the JoinBand.
+ */
+class JoinBand : public AbstractJoinOperator {
+ public:
+  JoinBand(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
+           const JoinMode mode, const OperatorJoinPredicate& primary_predicate,
+           const std::vector<OperatorJoinPredicate>& secondary_predicates = {});
+
+  const std::string name() const override;
+
+  static bool supports(const JoinMode mode, const PredicateCondition predicate_condition,
+                       const DataType left_data_type, const DataType right_data_type);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  void _on_cleanup() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+  template <typename T>
+  class JoinBandImpl;
+  template <typename T>
+  friend class JoinBandImpl;
+
+  std::unique_ptr<AbstractJoinOperatorImpl> _impl;
+};
+
+}  // namespace opossum
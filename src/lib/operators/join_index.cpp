@@ -3,6 +3,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -13,6 +14,8 @@
 #include "multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
 #include "storage/index/base_index.hpp"
+#include "storage/index/table_hash_index.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/segment_iterate.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
@@ -82,18 +85,44 @@ void JoinIndex::_perform_join() {
 
   auto secondary_predicate_evaluator = MultiPredicateJoinEvaluator{*input_table_left(), *input_table_right(), {}};
 
+  const auto joined_using_hash_index = _perform_join_using_hash_index();
+
   // Scan all chunks for right input
-  for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < input_table_right()->chunk_count(); ++chunk_id_right) {
+  for (ChunkID chunk_id_right = ChunkID{0};
+       !joined_using_hash_index && chunk_id_right < input_table_right()->chunk_count(); ++chunk_id_right) {
     const auto chunk_right = input_table_right()->get_chunk(chunk_id_right);
-    const auto indices = chunk_right->get_indices(std::vector<ColumnID>{_primary_predicate.column_ids.second});
     if (track_right_matches) _right_matches[chunk_id_right].resize(chunk_right->size());
 
     std::shared_ptr<BaseIndex> index = nullptr;
-
-    if (!indices.empty()) {
-      // We assume the first index to be efficient for our join
-      // as we do not want to spend time on evaluating the best index inside of this join loop
-      index = indices.front();
+    auto referenced_positions = std::optional<ReferencedPositions>{};
+
+    if (input_table_right()->type() == TableType::Data) {
+      const auto indices = chunk_right->get_indices(std::vector<ColumnID>{_primary_predicate.column_ids.second});
+      if (!indices.empty()) {
+        // We assume the first index to be efficient for our join
+        // as we do not want to spend time on evaluating the best index inside of this join loop
+        index = indices.front();
+      }
+    } else {
+      // If all positions of the reference chunk point into the same chunk, the index of that chunk can be used
+      const auto segment_right = std::static_pointer_cast<const ReferenceSegment>(
+          chunk_right->get_segment(_primary_predicate.column_ids.second));
+      const auto& pos_list = *segment_right->pos_list();
+      if (pos_list.references_single_chunk() && !pos_list.empty()) {
+        const auto referenced_chunk = segment_right->referenced_table()->get_chunk(pos_list.common_chunk_id());
+        const auto indices =
+            referenced_chunk->get_indices(std::vector<ColumnID>{segment_right->referenced_column_id()});
+        if (!indices.empty()) {
+          index = indices.front();
+
+          referenced_positions.emplace();
+          referenced_positions->reserve(pos_list.size());
+          for (ChunkOffset chunk_offset_right{0}; chunk_offset_right < pos_list.size(); ++chunk_offset_right) {
+            referenced_positions->emplace_back(pos_list[chunk_offset_right].chunk_offset, chunk_offset_right);
+          }
+          std::sort(referenced_positions->begin(), referenced_positions->end());
+        }
+      }
     }
 
     // Scan all chunks from left input
@@ -103,7 +132,7 @@ void JoinIndex::_perform_join() {
             input_table_left()->get_chunk(chunk_id_left)->get_segment(_primary_predicate.column_ids.first);
 
         segment_with_iterators(*segment_left, [&](auto it, const auto end) {
-          _join_two_segments_using_index(it, end, chunk_id_left, chunk_id_right, index);
+          _join_two_segments_using_index(it, end, chunk_id_left, chunk_id_right, index, referenced_positions);
         });
       }
       performance_data.chunks_scanned_with_index++;
@@ -174,10 +203,114 @@ void JoinIndex::_perform_join() {
   }
 }
 
+bool JoinIndex::_perform_join_using_hash_index() {
+  if (_primary_predicate.predicate_condition != PredicateCondition::Equals) return false;
+  if (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue) return false;
+
+  const auto& right_table = input_table_right();
+  const auto right_column_id = _primary_predicate.column_ids.second;
+
+  // For a reference input, the hash index of the referenced table is used. This requires all chunks to reference the
+  // same table.
+  auto indexed_table = std::shared_ptr<const Table>{right_table};
+  auto indexed_column_id = right_column_id;
+  if (right_table->type() == TableType::References) {
+    if (right_table->chunk_count() == 0) return false;
+
+    for (ChunkID chunk_id_right{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+      const auto segment = std::static_pointer_cast<const ReferenceSegment>(
+          right_table->get_chunk(chunk_id_right)->get_segment(right_column_id));
+      if (chunk_id_right == ChunkID{0}) {
+        indexed_table = segment->referenced_table();
+        indexed_column_id = segment->referenced_column_id();
+      } else if (segment->referenced_table() != indexed_table ||
+                 segment->referenced_column_id() != indexed_column_id) {
+        return false;
+      }
+    }
+  }
+
+  const auto hash_index = indexed_table->get_hash_index({indexed_column_id});
+  if (!hash_index) return false;
+
+  // The index yields rows of the referenced table. Map them to the rows of the right input that reference them. Rows
+  // of the referenced table that are not part of the right input (e.g., because they were filtered out by a Validate)
+  // are not part of the mapping and thus ignored.
+  auto referenced_row_ids = std::vector<std::pair<RowID, RowID>>{};
+  if (right_table->type() == TableType::References) {
+    for (ChunkID chunk_id_right{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+      const auto segment = std::static_pointer_cast<const ReferenceSegment>(
+          right_table->get_chunk(chunk_id_right)->get_segment(right_column_id));
+      const auto& pos_list = *segment->pos_list();
+      for (ChunkOffset chunk_offset_right{0}; chunk_offset_right < pos_list.size(); ++chunk_offset_right) {
+        if (pos_list[chunk_offset_right].is_null()) continue;
+        referenced_row_ids.emplace_back(pos_list[chunk_offset_right], RowID{chunk_id_right, chunk_offset_right});
+      }
+    }
+    std::sort(referenced_row_ids.begin(), referenced_row_ids.end());
+  }
+
+  const auto track_left_matches = (_mode == JoinMode::Left || _mode == JoinMode::FullOuter);
+  const auto track_right_matches = (_mode == JoinMode::Right || _mode == JoinMode::FullOuter);
+
+  // An Insert adds its rows to the hash index before it commits. Thus, for a data input, the index might yield rows
+  // that were appended to the last chunk or to new chunks after the input was produced. The chunk sizes are captured
+  // once, so that such rows are skipped.
+  auto right_chunk_sizes = std::vector<ChunkOffset>(_right_matches.size());
+  for (ChunkID chunk_id_right{0}; chunk_id_right < right_chunk_sizes.size(); ++chunk_id_right) {
+    right_chunk_sizes[chunk_id_right] = right_table->get_chunk(chunk_id_right)->size();
+    if (track_right_matches) _right_matches[chunk_id_right].resize(right_chunk_sizes[chunk_id_right]);
+  }
+
+  for (ChunkID chunk_id_left{0}; chunk_id_left < input_table_left()->chunk_count(); ++chunk_id_left) {
+    const auto segment_left =
+        input_table_left()->get_chunk(chunk_id_left)->get_segment(_primary_predicate.column_ids.first);
+
+    segment_iterate(*segment_left, [&](const auto& left_value) {
+      if (left_value.is_null()) return;
+
+      const auto left_row_id = RowID{chunk_id_left, left_value.chunk_offset()};
+      auto has_match = false;
+
+      const auto append_match = [&](const RowID& right_row_id) {
+        _pos_list_left->emplace_back(left_row_id);
+        _pos_list_right->emplace_back(right_row_id);
+        has_match = true;
+
+        if (track_right_matches) _right_matches[right_row_id.chunk_id][right_row_id.chunk_offset] = true;
+      };
+
+      for (const auto& indexed_row_id : hash_index->lookup({AllTypeVariant{left_value.value()}})) {
+        if (right_table->type() == TableType::Data) {
+          if (indexed_row_id.chunk_id < right_chunk_sizes.size() &&
+              indexed_row_id.chunk_offset < right_chunk_sizes[indexed_row_id.chunk_id]) {
+            append_match(indexed_row_id);
+          }
+          continue;
+        }
+
+        auto mapping_it = std::lower_bound(referenced_row_ids.cbegin(), referenced_row_ids.cend(),
+                                           std::pair{indexed_row_id, RowID{ChunkID{0}, ChunkOffset{0}}});
+        for (; mapping_it != referenced_row_ids.cend() && mapping_it->first == indexed_row_id; ++mapping_it) {
+          append_match(mapping_it->second);
+        }
+      }
+
+      if (track_left_matches && has_match) _left_matches[chunk_id_left][left_value.chunk_offset()] = true;
+    });
+  }
+
+  auto& performance_data = static_cast<PerformanceData&>(*_performance_data);
+  performance_data.chunks_scanned_with_index = right_chunk_sizes.size();
+
+  return true;
+}
+
 // join loop that joins two segments of two columns using an iterator for the left, and an index for the right
 template <typename LeftIterator>
 void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                               const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index) {
+                                               const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index,
+                                               const std::optional<ReferencedPositions>& referenced_positions) {
   for (; left_it != left_end; ++left_it) {
     const auto left_value = *left_it;
     if (left_value.is_null()) continue;
@@ -196,7 +329,8 @@ void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterato
         range_begin = index->cbegin();
         range_end = index->lower_bound({left_value.value()});
 
-        _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
+        _append_index_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right,
+                              referenced_positions);
 
         // set range for second half to all values greater than the search value
         range_begin = index->upper_bound({left_value.value()});
@@ -227,7 +361,8 @@ void JoinIndex::_join_two_segments_using_index(LeftIterator left_it, LeftIterato
         Fail("Unsupported comparison type encountered");
     }
 
-    _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
+    _append_index_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right,
+                              referenced_positions);
   }
 }
 
@@ -264,7 +399,32 @@ void JoinIndex::_join_two_segments_nested_loop(const BinaryFunctor& func, LeftIt
   }
 }
 
-void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
+void JoinIndex::_append_index_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
+                                      const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left,
+                                      const ChunkID chunk_id_right,
+                                      const std::optional<ReferencedPositions>& referenced_positions) {
+  if (!referenced_positions) {
+    _append_matches(range_begin, range_end, chunk_offset_left, chunk_id_left, chunk_id_right);
+    return;
+  }
+
+  // The index returned positions in the referenced chunk. Translate them into the positions of the right input chunk
+  // that reference them.
+  auto chunk_offsets_right = std::vector<ChunkOffset>{};
+  for (auto index_it = range_begin; index_it != range_end; ++index_it) {
+    auto position_it = std::lower_bound(referenced_positions->cbegin(), referenced_positions->cend(),
+                                        std::pair{*index_it, ChunkOffset{0}});
+    for (; position_it != referenced_positions->cend() && position_it->first == *index_it; ++position_it) {
+      chunk_offsets_right.emplace_back(position_it->second);
+    }
+  }
+
+  _append_matches(chunk_offsets_right.cbegin(), chunk_offsets_right.cend(), chunk_offset_left, chunk_id_left,
+                  chunk_id_right);
+}
+
+template <typename RightIterator>
+void JoinIndex::_append_matches(const RightIterator& range_begin, const RightIterator& range_end,
                                 const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left,
                                 const ChunkID chunk_id_right) {
   const auto num_right_matches = std::distance(range_begin, range_end);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -18,6 +19,14 @@ namespace opossum {
    * finding the right values utilizing the index.
    *
    * Note: An index needs to be present on the right table in order to execute an index join.
+   *
+   * If the right input is a data table with a TableHashIndex on the right join column and the join is an equi-join
+   * (and not a semi or anti join), each left value is looked up in that index. Only the chunks containing matches
+   * are touched then. Otherwise, the chunk indexes are used.
+   *
+   * The right input may also be a reference table (e.g., the output of a Validate). Then, the indexes of the
+   * referenced table are used and their results are mapped back to the positions of the right input. For chunk
+   * indexes, this requires the reference chunk to point into a single chunk.
    */
 class JoinIndex : public AbstractJoinOperator {
  public:
@@ -43,16 +52,30 @@ class JoinIndex : public AbstractJoinOperator {
 
   void _perform_join();
 
+  // Returns false if the join cannot be performed using a TableHashIndex
+  bool _perform_join_using_hash_index();
+
+  // For a right input chunk that references a single chunk, the positions within the referenced chunk paired with the
+  // positions of the right input chunk that reference them, sorted by the former
+  using ReferencedPositions = std::vector<std::pair<ChunkOffset, ChunkOffset>>;
+
   template <typename LeftIterator>
   void _join_two_segments_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                      const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index);
+                                      const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index,
+                                      const std::optional<ReferencedPositions>& referenced_positions);
 
   template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
   void _join_two_segments_nested_loop(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
                                       RightIterator right_begin, RightIterator right_end, const ChunkID chunk_id_left,
                                       const ChunkID chunk_id_right);
 
-  void _append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
+  void _append_index_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
+                             const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left,
+                             const ChunkID chunk_id_right,
+                             const std::optional<ReferencedPositions>& referenced_positions);
+
+  template <typename RightIterator>
+  void _append_matches(const RightIterator& range_begin, const RightIterator& range_end,
                        const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left, const ChunkID chunk_id_right);
 
   void _write_output_segments(Segments& output_segments, const std::shared_ptr<const Table>& input_table,
@@ -1,11 +1,14 @@
 #include "join_nested_loop.hpp"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "resolve_type.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/segment_iterables/any_segment_iterable.hpp"
 #include "storage/segment_iterate.hpp"
@@ -94,7 +97,8 @@ const std::string JoinNestedLoop::name() const { return "JoinNestedLoop"; }
 std::shared_ptr<AbstractOperator> JoinNestedLoop::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_input_left,
     const std::shared_ptr<AbstractOperator>& copied_input_right) const {
-  return std::make_shared<JoinNestedLoop>(copied_input_left, copied_input_right, _mode, _primary_predicate);
+  return std::make_shared<JoinNestedLoop>(copied_input_left, copied_input_right, _mode, _primary_predicate,
+                                          _secondary_predicates);
 }
 
 void JoinNestedLoop::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
@@ -124,10 +128,6 @@ std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
     }
   }
 
-  // Track pairs of matching RowIDs
-  const auto pos_list_left = std::make_shared<PosList>();
-  const auto pos_list_right = std::make_shared<PosList>();
-
   const auto is_outer_join = _mode == JoinMode::Left || _mode == JoinMode::Right || _mode == JoinMode::FullOuter;
   const auto is_semi_or_anti_join =
       _mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue;
@@ -135,31 +135,49 @@ std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
   const auto track_left_matches = is_outer_join || is_semi_or_anti_join;
   const auto track_right_matches = _mode == JoinMode::FullOuter;
 
-  auto left_matches_by_chunk = std::vector<std::vector<bool>>(left_table->chunk_count());
-  auto right_matches_by_chunk = std::vector<std::vector<bool>>(right_table->chunk_count());
+  // Each chunk of the left input is joined with all chunks of the right input in a separate job. As all matches of a
+  // left row are found within its job, the job can also write the unmatched rows of Outer joins and the output of
+  // Semi/Anti joins. Thus, each job produces one output chunk.
+  auto output_chunks = std::vector<Segments>(left_table->chunk_count());
 
-  auto secondary_predicate_evaluator =
-      MultiPredicateJoinEvaluator{*left_table, *right_table, maybe_flipped_secondary_predicates};
+  // The matches of the right rows (only needed for Full Outer joins) are tracked per job and merged afterwards
+  auto right_matches_by_chunk = std::vector<std::vector<bool>>(right_table->chunk_count());
+  if (track_right_matches) {
+    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+      right_matches_by_chunk[chunk_id_right].resize(right_table->get_chunk(chunk_id_right)->size());
+    }
+  }
+  auto right_matches_mutex = std::mutex{};
 
-  // Scan all chunks from left input
-  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
-    auto segment_left = left_table->get_chunk(chunk_id_left)->get_segment(left_column_id);
+  const auto join_left_chunk = [&](const ChunkID chunk_id_left) {
+    const auto segment_left = left_table->get_chunk(chunk_id_left)->get_segment(left_column_id);
 
-    std::vector<bool> left_matches;
+    // Track pairs of matching RowIDs
+    const auto pos_list_left = std::make_shared<PosList>();
+    const auto pos_list_right = std::make_shared<PosList>();
 
+    auto left_matches = std::vector<bool>{};
     if (track_left_matches) {
       left_matches.resize(segment_left->size());
     }
 
+    auto job_right_matches_by_chunk = std::vector<std::vector<bool>>(right_table->chunk_count());
+
+    // The segment accessors of the evaluator are not thread-safe, so each job uses its own
+    auto secondary_predicate_evaluator =
+        MultiPredicateJoinEvaluator{*left_table, *right_table, maybe_flipped_secondary_predicates};
+
     for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
       const auto segment_right = right_table->get_chunk(chunk_id_right)->get_segment(right_column_id);
-      right_matches_by_chunk[chunk_id_right].resize(segment_right->size());
+      if (track_right_matches) {
+        job_right_matches_by_chunk[chunk_id_right].resize(segment_right->size());
+      }
 
       JoinParams params{*pos_list_left,
                         *pos_list_right,
                         left_matches,
-                        right_matches_by_chunk[chunk_id_right],
-                        is_semi_or_anti_join || is_outer_join,
+                        job_right_matches_by_chunk[chunk_id_right],
+                        track_left_matches,
                         track_right_matches,
                         _mode,
                         maybe_flipped_predicate_condition,
@@ -178,59 +196,94 @@ std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
       }
     }
 
-    left_matches_by_chunk[chunk_id_left] = std::move(left_matches);
+    // Write PosLists for Semi/Anti Joins, which so far haven't written any results to the PosLists
+    // We use `left_matches` to determine whether a tuple from the left side found a match.
+    if (is_semi_or_anti_join) {
+      const auto invert = _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue;
+
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+        if (left_matches[chunk_offset] ^ invert) {
+          pos_list_left->emplace_back(chunk_id_left, chunk_offset);
+        }
+      }
+    }
+
+    if (track_right_matches) {
+      const auto lock = std::lock_guard<std::mutex>{right_matches_mutex};
+      for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+        auto& right_matches = right_matches_by_chunk[chunk_id_right];
+        const auto& job_right_matches = job_right_matches_by_chunk[chunk_id_right];
+        for (auto chunk_offset = size_t{0}; chunk_offset < right_matches.size(); ++chunk_offset) {
+          if (job_right_matches[chunk_offset]) right_matches[chunk_offset] = true;
+        }
+      }
+    }
+
+    if (!pos_list_left->empty()) {
+      _write_output_chunk(output_chunks[chunk_id_left], left_table, right_table, pos_list_left, pos_list_right);
+    }
+  };
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(left_table->chunk_count());
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id_left] { join_left_chunk(chunk_id_left); }));
+  }
+  CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+
+  for (auto& segments : output_chunks) {
+    if (!segments.empty()) output_table->append_chunk(segments);
   }
 
   // For Full Outer we need to add all unmatched rows for the right side.
-  // Unmatched rows on the left side are already added in the main loop above
+  // Unmatched rows on the left side are already added by the jobs above
   if (_mode == JoinMode::FullOuter) {
+    const auto pos_list_left = std::make_shared<PosList>();
+    const auto pos_list_right = std::make_shared<PosList>();
+
     for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
-      const auto chunk_size = right_table->get_chunk(chunk_id_right)->size();
+      const auto& right_matches = right_matches_by_chunk[chunk_id_right];
 
-      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-        if (!right_matches_by_chunk[chunk_id_right][chunk_offset]) {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < right_matches.size(); ++chunk_offset) {
+        if (!right_matches[chunk_offset]) {
           pos_list_left->emplace_back(NULL_ROW_ID);
           pos_list_right->emplace_back(chunk_id_right, chunk_offset);
         }
       }
     }
-  }
-
-  // Write PosLists for Semi/Anti Joins, which so far haven't written any results to the PosLists
-  // We use `left_matches_by_chunk` to determine whether a tuple from the left side found a match.
-  if (is_semi_or_anti_join) {
-    const auto invert = _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue;
 
-    for (auto chunk_id = ChunkID{0}; chunk_id < left_table->chunk_count(); ++chunk_id) {
-      const auto chunk_size = left_table->get_chunk(chunk_id)->size();
-      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-        if (left_matches_by_chunk[chunk_id][chunk_offset] ^ invert) {
-          pos_list_left->emplace_back(chunk_id, chunk_offset);
-        }
-      }
+    if (!pos_list_left->empty()) {
+      Segments segments;
+      _write_output_chunk(segments, left_table, right_table, pos_list_left, pos_list_right);
+      output_table->append_chunk(segments);
     }
   }
 
-  // Write output Chunk based on the PosList(s) we created during the Join
-  Segments segments;
-
-  if (is_semi_or_anti_join) {
-    _write_output_chunk(segments, left_table, pos_list_left);
-  } else {
-    if (_mode == JoinMode::Right) {
-      _write_output_chunk(segments, right_table, pos_list_right);
-      _write_output_chunk(segments, left_table, pos_list_left);
-    } else {
-      _write_output_chunk(segments, left_table, pos_list_left);
-      _write_output_chunk(segments, right_table, pos_list_right);
-    }
+  // If there are no matches at all, the output consists of a single empty chunk
+  if (output_table->chunk_count() == 0) {
+    Segments segments;
+    _write_output_chunk(segments, left_table, right_table, std::make_shared<PosList>(), std::make_shared<PosList>());
+    output_table->append_chunk(segments);
   }
 
-  output_table->append_chunk(segments);
-
   return output_table;
 }
 
+void JoinNestedLoop::_write_output_chunk(Segments& segments, const std::shared_ptr<const Table>& left_table,
+                                         const std::shared_ptr<const Table>& right_table,
+                                         const std::shared_ptr<PosList>& pos_list_left,
+                                         const std::shared_ptr<PosList>& pos_list_right) {
+  if (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsFalse || _mode == JoinMode::AntiNullAsTrue) {
+    _write_output_segments(segments, left_table, pos_list_left);
+  } else if (_mode == JoinMode::Right) {
+    _write_output_segments(segments, right_table, pos_list_right);
+    _write_output_segments(segments, left_table, pos_list_left);
+  } else {
+    _write_output_segments(segments, left_table, pos_list_left);
+    _write_output_segments(segments, right_table, pos_list_right);
+  }
+}
+
 void JoinNestedLoop::_join_two_untyped_segments(const BaseSegment& base_segment_left,
                                                 const BaseSegment& base_segment_right, const ChunkID chunk_id_left,
                                                 const ChunkID chunk_id_right, JoinNestedLoop::JoinParams& params) {
@@ -323,8 +376,8 @@ void JoinNestedLoop::_join_two_untyped_segments(const BaseSegment& base_segment_
   // clang-format on
 }
 
-void JoinNestedLoop::_write_output_chunk(Segments& segments, const std::shared_ptr<const Table>& input_table,
-                                         const std::shared_ptr<PosList>& pos_list) {
+void JoinNestedLoop::_write_output_segments(Segments& segments, const std::shared_ptr<const Table>& input_table,
+                                            const std::shared_ptr<PosList>& pos_list) {
   // Add segments from table to output chunk
   for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
     std::shared_ptr<BaseSegment> segment;
@@ -332,6 +385,7 @@ void JoinNestedLoop::_write_output_chunk(Segments& segments, const std::shared_p
     if (input_table->type() == TableType::References) {
       if (input_table->chunk_count() > 0) {
         auto new_pos_list = std::make_shared<PosList>();
+        new_pos_list->reserve(pos_list->size());
 
         // de-reference to the correct RowID so the output can be used in a Multi Join
         for (const auto& row : *pos_list) {
@@ -56,11 +56,20 @@ class JoinNestedLoop : public AbstractJoinOperator {
   _join_two_untyped_segments(const BaseSegment& base_segment_left, const BaseSegment& base_segment_right,
                              const ChunkID chunk_id_left, const ChunkID chunk_id_right, JoinParams& params);
 
-  void _write_output_chunk(Segments& segments, const std::shared_ptr<const Table>& input_table,
-                           const std::shared_ptr<PosList>& pos_list);
+  // Writes the segments of both inputs (or only of the left input for Semi/Anti joins) to the output chunk
+  void _write_output_chunk(Segments& segments, const std::shared_ptr<const Table>& left_table,
+                           const std::shared_ptr<const Table>& right_table,
+                           const std::shared_ptr<PosList>& pos_list_left,
+                           const std::shared_ptr<PosList>& pos_list_right);
+
+  static void _write_output_segments(Segments& segments, const std::shared_ptr<const Table>& input_table,
+                                     const std::shared_ptr<PosList>& pos_list);
 
   // The JoinIndex uses this join as a fallback if no index exists
   friend class JoinIndex;
+
+  // The JoinBand writes its output segments the same way
+  friend class JoinBand;
 };
 
 }  // namespace opossum
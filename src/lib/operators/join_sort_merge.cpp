@@ -1,6 +1,7 @@
 #include "join_sort_merge.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <memory>
 #include <optional>
@@ -15,6 +16,7 @@
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/abstract_segment_visitor.hpp"
 #include "storage/reference_segment.hpp"
 
@@ -22,7 +24,6 @@ namespace opossum {
 
 /**
 * TODO(anyone): Outer not-equal join (outer !=)
-* TODO(anyone): Choose an appropriate number of clusters.
 **/
 
 /**
@@ -32,7 +33,8 @@ namespace opossum {
 *    /utils/radix_cluster_sort.hpp for more info on the clustering phase.
 * -> The join is performed per cluster. For the joining phase, runs of entries with the same value are identified
 *    and handled at once. If a join-match is identified, the corresponding row_ids are noted for the output.
-* -> Using the join result, the output table is built using pos lists referencing the original tables.
+* -> Using the join result, the output table is built using pos lists referencing the original tables. Each cluster
+*    becomes a separate output chunk, so that the clusters are joined and written in parallel.
 **/
 JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator>& left,
                              const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
@@ -99,6 +101,9 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     _cluster_count = _determine_number_of_clusters();
     _output_pos_lists_left.resize(_cluster_count);
     _output_pos_lists_right.resize(_cluster_count);
+    _multi_predicate_join_evaluators.resize(_cluster_count);
+    _left_row_id_has_match.resize(_cluster_count);
+    _right_row_id_has_match.resize(_cluster_count);
   }
 
  protected:
@@ -119,14 +124,24 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
   const JoinMode _mode;
 
   const std::vector<OperatorJoinPredicate>& _secondary_join_predicates;
-  std::optional<MultiPredicateJoinEvaluator> _multi_predicate_join_evaluator;
-  // these are used for outer joins where the primary predicate is not Equals.
-  std::map<RowID, bool> _left_row_id_has_match{};
-  std::map<RowID, bool> _right_row_id_has_match{};
+
+  // The segment accessors of the evaluator are not thread-safe, so each cluster uses its own
+  std::vector<std::optional<MultiPredicateJoinEvaluator>> _multi_predicate_join_evaluators;
+
+  // these are used for outer joins where the primary predicate is not Equals. As the clusters are joined in
+  // parallel, each cluster tracks the matches separately.
+  std::vector<std::map<RowID, bool>> _left_row_id_has_match;
+  std::vector<std::map<RowID, bool>> _right_row_id_has_match;
 
   // the cluster count must be a power of two, i.e. 1, 2, 4, 8, 16, ...
   size_t _cluster_count;
 
+  // Each worker joins several clusters, so that skewed clusters do not leave the other workers idle
+  static constexpr auto CLUSTERS_PER_WORKER = size_t{4};
+
+  // Smaller clusters do not amortize the job that joins them
+  static constexpr auto MIN_CLUSTER_SIZE = size_t{2'048};
+
   // Contains the output row ids for each cluster
   std::vector<std::shared_ptr<PosList>> _output_pos_lists_left;
   std::vector<std::shared_ptr<PosList>> _output_pos_lists_right;
@@ -175,15 +190,21 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
 
   /**
   * Determines the number of clusters to be used for the join.
+  * The clusters are joined in parallel, so we aim for CLUSTERS_PER_WORKER clusters per worker of the scheduler. For
+  * small inputs, fewer clusters are used so that each cluster has at least MIN_CLUSTER_SIZE rows.
   * The number of clusters must be a power of two, i.e. 1, 2, 4, 8, 16...
-  * TODO(anyone): How should we determine the number of clusters?
   **/
   size_t _determine_number_of_clusters() {
-    // Get the next lower power of two of the bigger chunk number
-    // Note: this is only provisional. There should be a reasonable calculation here based on hardware stats.
-    size_t chunk_count_left = _sort_merge_join.input_table_left()->chunk_count();
-    size_t chunk_count_right = _sort_merge_join.input_table_right()->chunk_count();
-    return static_cast<size_t>(std::pow(2, std::floor(std::log2(std::max(chunk_count_left, chunk_count_right)))));
+    const auto row_count = std::max(_sort_merge_join.input_table_left()->row_count(),
+                                    _sort_merge_join.input_table_right()->row_count());
+    const auto worker_count =
+        CurrentScheduler::is_set() ? std::max(Topology::get().num_cpus(), size_t{1}) : size_t{1};
+
+    const auto max_cluster_count = std::max(static_cast<size_t>(row_count / MIN_CLUSTER_SIZE), size_t{1});
+    const auto cluster_count = std::min(worker_count * CLUSTERS_PER_WORKER, max_cluster_count);
+
+    // Get the next lower power of two
+    return size_t{1} << static_cast<size_t>(std::floor(std::log2(cluster_count)));
   }
 
   /**
@@ -272,7 +293,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     * where also the secondary predicates are satisfied.
     **/
   void _emit_qualified_combinations(size_t output_cluster, TableRange left_range, TableRange right_range) {
-    if (_multi_predicate_join_evaluator) {
+    if (!_secondary_join_predicates.empty()) {
       if (_mode == JoinMode::Inner) {
         _emit_combinations_multi_predicated_inner(output_cluster, left_range, right_range);
       } else if (_mode == JoinMode::Left) {
@@ -300,7 +321,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
   void _emit_combinations_multi_predicated_inner(size_t output_cluster, TableRange left_range, TableRange right_range) {
     left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
       right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-        if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+        if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
           _emit_combination(output_cluster, left_row_id, right_row_id);
         }
       });
@@ -319,7 +340,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
       left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
         bool left_row_id_matched = false;
         right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
             left_row_id_matched = true;
           }
@@ -331,11 +352,11 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     } else {
       // primary predicate is <, <=, >, or >=
       left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
-        _left_row_id_has_match.emplace(left_row_id, false);
+        _left_row_id_has_match[output_cluster].emplace(left_row_id, false);
         right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
-            _left_row_id_has_match[left_row_id] = true;
+            _left_row_id_has_match[output_cluster][left_row_id] = true;
           }
         });
       });
@@ -354,7 +375,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
       right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
         bool right_row_id_matched = false;
         left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
             right_row_id_matched = true;
           }
@@ -366,11 +387,11 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     } else {
       // primary predicate is <, <=, >, or >=
       right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-        _right_row_id_has_match.emplace(right_row_id, false);
+        _right_row_id_has_match[output_cluster].emplace(right_row_id, false);
         left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
-            _right_row_id_has_match[right_row_id] = true;
+            _right_row_id_has_match[output_cluster][right_row_id] = true;
           }
         });
       });
@@ -392,7 +413,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
       left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
         bool left_row_id_matched = false;
         right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
             left_row_id_matched = true;
             matched_right_row_ids.insert(right_row_id);
@@ -411,15 +432,17 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
       });
     } else {
       left_range.for_every_row_id(_sorted_left_table, [&](RowID left_row_id) {
-        // If left_row_id not yet in _left_row_id_has_match, this initializes it to false
-        _left_row_id_has_match[left_row_id];
+        auto& left_row_id_has_match = _left_row_id_has_match[output_cluster];
+        auto& right_row_id_has_match = _right_row_id_has_match[output_cluster];
+        // If left_row_id not yet in left_row_id_has_match, this initializes it to false
+        left_row_id_has_match[left_row_id];
         right_range.for_every_row_id(_sorted_right_table, [&](RowID right_row_id) {
-          // If right_row_id not yet in _right_row_id_has_match, this initializes it to false
-          _right_row_id_has_match[right_row_id];
-          if (_multi_predicate_join_evaluator->satisfies_all_predicates(left_row_id, right_row_id)) {
+          // If right_row_id not yet in right_row_id_has_match, this initializes it to false
+          right_row_id_has_match[right_row_id];
+          if (_multi_predicate_join_evaluators[output_cluster]->satisfies_all_predicates(left_row_id, right_row_id)) {
             _emit_combination(output_cluster, left_row_id, right_row_id);
-            _left_row_id_has_match[left_row_id] = true;
-            _right_row_id_has_match[right_row_id] = true;
+            left_row_id_has_match[left_row_id] = true;
+            right_row_id_has_match[right_row_id] = true;
           }
         });
       });
@@ -478,6 +501,12 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
   * This constitutes the merge phase of the join. The output combinations of row ids are determined by _join_runs.
   **/
   void _join_cluster(size_t cluster_number) {
+    if (!_secondary_join_predicates.empty()) {
+      _multi_predicate_join_evaluators[cluster_number].emplace(*_sort_merge_join.input_table_left(),
+                                                               *_sort_merge_join.input_table_right(),
+                                                               _secondary_join_predicates);
+    }
+
     auto& left_cluster = (*_sorted_left_table)[cluster_number];
     auto& right_cluster = (*_sorted_right_table)[cluster_number];
 
@@ -604,6 +633,19 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     return {};
   }
 
+  /**
+  * Merges the matches that were tracked per cluster. A row has a match if it found one in any of the clusters.
+  **/
+  static std::map<RowID, bool> _merge_row_id_matches(const std::vector<std::map<RowID, bool>>& row_id_has_match) {
+    auto merged_row_id_has_match = std::map<RowID, bool>{};
+    for (const auto& cluster_row_id_has_match : row_id_has_match) {
+      for (const auto& [row_id, has_match] : cluster_row_id_has_match) {
+        merged_row_id_has_match[row_id] |= has_match;
+      }
+    }
+    return merged_row_id_has_match;
+  }
+
   /**
   * Adds the rows without matches for right outer joins for non-equi operators (<, <=, >, >=).
   * This method adds those rows from the right table to the output that do not find a join partner.
@@ -646,7 +688,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
 
     // Add null-combinations for right row ids where the primary predicate was satisfied but the
     // secondary predicates were not.
-    for (const auto& right_row_id : _right_row_id_has_match) {
+    for (const auto& right_row_id : _merge_row_id_matches(_right_row_id_has_match)) {
       if (!right_row_id.second) {
         _emit_combination(0, NULL_ROW_ID, right_row_id.first);
       }
@@ -695,7 +737,7 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
 
     // Add null-combinations for left row ids where the primary predicate was satisfied but the
     // secondary predicates were not.
-    for (const auto& left_row_id : _left_row_id_has_match) {
+    for (const auto& left_row_id : _merge_row_id_matches(_left_row_id_has_match)) {
       if (!left_row_id.second) {
         _emit_combination(0, left_row_id.first, NULL_ROW_ID);
       }
@@ -738,27 +780,6 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     }
   }
 
-  /**
-  * Concatenates a vector of pos lists into a single new pos list.
-  **/
-  std::shared_ptr<PosList> _concatenate_pos_lists(std::vector<std::shared_ptr<PosList>>& pos_lists) {
-    auto output = std::make_shared<PosList>();
-
-    // Determine the required space
-    size_t total_size = 0;
-    for (auto& pos_list : pos_lists) {
-      total_size += pos_list->size();
-    }
-
-    // Move the entries over the output pos list
-    output->reserve(total_size);
-    for (auto& pos_list : pos_lists) {
-      output->insert(output->end(), pos_list->begin(), pos_list->end());
-    }
-
-    return output;
-  }
-
   /**
   * Adds the segments from an input table to the output table
   **/
@@ -840,40 +861,58 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
     _end_of_left_table = _end_of_table(_sorted_left_table);
     _end_of_right_table = _end_of_table(_sorted_right_table);
 
-    if (!_secondary_join_predicates.empty()) {
-      _multi_predicate_join_evaluator.emplace(*_sort_merge_join._input_left->get_output(),
-                                              *_sort_merge_join.input_right()->get_output(),
-                                              _secondary_join_predicates);
-    }
-
     _perform_join();
 
-    // merge the pos lists into single pos lists
-    auto output_left = _concatenate_pos_lists(_output_pos_lists_left);
-    auto output_right = _concatenate_pos_lists(_output_pos_lists_right);
-
-    // Add the outer join rows which had a null value in their join column
-    if (include_null_left) {
-      for (auto row_id_left : *_null_rows_left) {
-        output_left->push_back(row_id_left);
-        output_right->push_back(NULL_ROW_ID);
+    // Add the outer join rows which had a null value in their join column as an additional output chunk
+    if (include_null_left || include_null_right) {
+      auto output_left = std::make_shared<PosList>();
+      auto output_right = std::make_shared<PosList>();
+      if (include_null_left) {
+        for (auto row_id_left : *_null_rows_left) {
+          output_left->push_back(row_id_left);
+          output_right->push_back(NULL_ROW_ID);
+        }
       }
-    }
-    if (include_null_right) {
-      for (auto row_id_right : *_null_rows_right) {
-        output_left->push_back(NULL_ROW_ID);
-        output_right->push_back(row_id_right);
+      if (include_null_right) {
+        for (auto row_id_right : *_null_rows_right) {
+          output_left->push_back(NULL_ROW_ID);
+          output_right->push_back(row_id_right);
+        }
       }
+      _output_pos_lists_left.emplace_back(std::move(output_left));
+      _output_pos_lists_right.emplace_back(std::move(output_right));
     }
 
-    // Add the segments from both input tables to the output
-    Segments output_segments;
-    _add_output_segments(output_segments, _sort_merge_join.input_table_left(), output_left);
-    _add_output_segments(output_segments, _sort_merge_join.input_table_right(), output_right);
+    // Add the segments from both input tables to the output. Each cluster becomes an output chunk, whose pos lists
+    // are dereferenced in parallel.
+    auto output_chunks = std::vector<Segments>(_output_pos_lists_left.size());
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    for (size_t chunk_id = 0; chunk_id < output_chunks.size(); ++chunk_id) {
+      if (_output_pos_lists_left[chunk_id]->empty()) continue;
+
+      jobs.push_back(std::make_shared<JobTask>([this, &output_chunks, chunk_id] {
+        _add_output_segments(output_chunks[chunk_id], _sort_merge_join.input_table_left(),
+                             _output_pos_lists_left[chunk_id]);
+        _add_output_segments(output_chunks[chunk_id], _sort_merge_join.input_table_right(),
+                             _output_pos_lists_right[chunk_id]);
+      }));
+      jobs.back()->schedule();
+    }
+    CurrentScheduler::wait_for_tasks(jobs);
 
-    // Build the output_table with one Chunk
     auto output_table = _sort_merge_join._initialize_output_table();
-    output_table->append_chunk(output_segments);
+    for (auto& output_segments : output_chunks) {
+      if (!output_segments.empty()) output_table->append_chunk(output_segments);
+    }
+
+    // If there are no matches at all, the output consists of a single empty chunk
+    if (output_table->chunk_count() == 0) {
+      Segments output_segments;
+      _add_output_segments(output_segments, _sort_merge_join.input_table_left(), std::make_shared<PosList>());
+      _add_output_segments(output_segments, _sort_merge_join.input_table_right(), std::make_shared<PosList>());
+      output_table->append_chunk(output_segments);
+    }
+
     return output_table;
   }
 };
@@ -0,0 +1,166 @@
+#include "morsel_pipeline.hpp"
+
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "table_wrapper.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MorselPipeline::MorselPipeline(const std::shared_ptr<const AbstractOperator>& input,
+                               const std::shared_ptr<const AbstractOperator>& pipeline_root,
+                               const std::shared_ptr<const AbstractOperator>& pipeline_input)
+    : AbstractReadOnlyOperator(OperatorType::MorselPipeline, input),
+      _pipeline_root(pipeline_root),
+      _pipeline_input(pipeline_input) {}
+
+const std::string MorselPipeline::name() const { return "MorselPipeline"; }
+
+const std::string MorselPipeline::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream desc;
+  desc << "[MorselPipeline]";
+  for (auto op = _pipeline_root; op != _pipeline_input; op = op->input_left()) {
+    desc << separator << op->description();
+  }
+  return desc.str();
+}
+
+const std::shared_ptr<const AbstractOperator>& MorselPipeline::pipeline_root() const { return _pipeline_root; }
+
+std::shared_ptr<const Table> MorselPipeline::_on_execute() {
+  const auto in_table = input_table_left();
+
+  // The morsels share the chunks (and thus the MVCC data) of the input table. They are only read, so the chunks are
+  // appended as non-const. A table without chunks is a single empty morsel, so that the output has the columns of the
+  // pipeline.
+  auto morsels = std::vector<std::shared_ptr<const Table>>{};
+  morsels.reserve(in_table->chunk_count());
+  const auto max_chunk_size =
+      in_table->type() == TableType::Data ? std::optional<uint32_t>{in_table->max_chunk_size()} : std::nullopt;
+  for (auto chunk_id = ChunkID{0}; chunk_id < in_table->chunk_count(); ++chunk_id) {
+    const auto morsel =
+        std::make_shared<Table>(in_table->column_definitions(), in_table->type(), max_chunk_size, in_table->has_mvcc());
+    morsel->append_chunk(std::const_pointer_cast<Chunk>(in_table->get_chunk(chunk_id)));
+    morsels.emplace_back(morsel);
+  }
+  if (morsels.empty()) morsels.emplace_back(in_table);
+
+  auto morsel_outputs = std::vector<std::shared_ptr<const Table>>(morsels.size());
+  if (CurrentScheduler::is_set() && morsels.size() > 1) {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(morsels.size());
+    for (auto morsel_id = size_t{0}; morsel_id < morsels.size(); ++morsel_id) {
+      jobs.emplace_back(std::make_shared<JobTask>(
+          [&, morsel_id]() { morsel_outputs[morsel_id] = _execute_morsel(morsels[morsel_id]); }));
+    }
+    CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+  } else {
+    for (auto morsel_id = size_t{0}; morsel_id < morsels.size(); ++morsel_id) {
+      morsel_outputs[morsel_id] = _execute_morsel(morsels[morsel_id]);
+    }
+  }
+
+  const auto& first_output = morsel_outputs.front();
+  const auto output_max_chunk_size =
+      first_output->type() == TableType::Data ? std::optional<uint32_t>{first_output->max_chunk_size()} : std::nullopt;
+  const auto output = std::make_shared<Table>(first_output->column_definitions(), first_output->type(),
+                                              output_max_chunk_size, first_output->has_mvcc());
+  for (auto morsel_id = size_t{0}; morsel_id < morsels.size(); ++morsel_id) {
+    const auto& morsel_output = morsel_outputs[morsel_id];
+    DebugAssert(morsel_output->type() == output->type(), "All morsels must produce the same type of table");
+    for (auto chunk_id = ChunkID{0}; chunk_id < morsel_output->chunk_count(); ++chunk_id) {
+      const auto chunk = morsel_output->get_chunk(chunk_id);
+      if (chunk->size() == 0) continue;
+      if (morsels[morsel_id] == in_table) {
+        output->append_chunk(std::const_pointer_cast<Chunk>(chunk));
+      } else {
+        output->append_chunk(_rebase_chunk(chunk, morsels[morsel_id], in_table, static_cast<ChunkID>(morsel_id)));
+      }
+    }
+  }
+
+  return output;
+}
+
+std::shared_ptr<const Table> MorselPipeline::_execute_morsel(const std::shared_ptr<const Table>& morsel) const {
+  auto copied_ops = std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>{};
+  copied_ops.emplace(_pipeline_input.get(), std::make_shared<TableWrapper>(morsel));
+  const auto morsel_root = _pipeline_root->deep_copy(copied_ops);
+
+  if (transaction_context_is_set()) morsel_root->set_transaction_context_recursively(transaction_context());
+  morsel_root->set_parameters(_parameters);
+
+  // Execute the operators bottom-up. The intermediate results are released together with the operators.
+  auto operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+  for (auto op = morsel_root; op; op = op->mutable_input_left()) {
+    operators.emplace_back(op);
+  }
+  for (auto op_iter = operators.rbegin(); op_iter != operators.rend(); ++op_iter) {
+    (*op_iter)->execute();
+  }
+
+  return morsel_root->get_output();
+}
+
+std::shared_ptr<Chunk> MorselPipeline::_rebase_chunk(const std::shared_ptr<const Chunk>& chunk,
+                                                     const std::shared_ptr<const Table>& morsel,
+                                                     const std::shared_ptr<const Table>& in_table,
+                                                     const ChunkID morsel_chunk_id) {
+  // Operators above the pipeline (e.g., joins) expect all ReferenceSegments of a column to reference the same table.
+  // Thus, the references to the single chunk of a morsel are redirected to the corresponding chunk of the input table.
+  // Segments that share a PosList keep sharing it.
+  auto rebased_pos_lists = std::unordered_map<std::shared_ptr<const PosList>, std::shared_ptr<const PosList>>{};
+  auto segments = Segments{};
+  segments.reserve(chunk->column_count());
+  for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+    const auto segment = chunk->get_segment(column_id);
+    const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment);
+    if (!reference_segment || reference_segment->referenced_table() != morsel) {
+      segments.emplace_back(segment);
+      continue;
+    }
+
+    const auto& pos_list = reference_segment->pos_list();
+    auto rebased_pos_list_iter = rebased_pos_lists.find(pos_list);
+    if (rebased_pos_list_iter == rebased_pos_lists.end()) {
+      auto rebased_pos_list = std::make_shared<PosList>(pos_list->size());
+      for (auto chunk_offset = size_t{0}; chunk_offset < pos_list->size(); ++chunk_offset) {
+        const auto& row_id = (*pos_list)[chunk_offset];
+        (*rebased_pos_list)[chunk_offset] =
+            row_id.is_null() ? row_id : RowID{morsel_chunk_id, row_id.chunk_offset};
+      }
+      rebased_pos_list->guarantee_single_chunk();
+      rebased_pos_list_iter = rebased_pos_lists.emplace(pos_list, rebased_pos_list).first;
+    }
+
+    segments.emplace_back(std::make_shared<ReferenceSegment>(in_table, reference_segment->referenced_column_id(),
+                                                             rebased_pos_list_iter->second));
+  }
+
+  return std::make_shared<Chunk>(segments);
+}
+
+std::shared_ptr<AbstractOperator> MorselPipeline::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_input_left,
+    const std::shared_ptr<AbstractOperator>& copied_input_right) const {
+  // The template is never executed, so the copies can share it
+  return std::make_shared<MorselPipeline>(copied_input_left, _pipeline_root, _pipeline_input);
+}
+
+void MorselPipeline::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  // The parameters are set on the copies of the pipeline for each morsel
+  _parameters = parameters;
+}
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "abstract_read_only_operator.hpp"
+
+namespace opossum {
+
+/**
+ * Executes a chain of operators morsel by morsel instead of operator at a time. Each chunk of the input table is a
+ * morsel, which is pushed through all operators of the pipeline before the next morsel is processed. Thus, only the
+ * output of the last operator is materialized for the whole input, and the intermediate results of a morsel are
+ * released once the morsel is done, while they are still in the cache.
+ *
+ * The pipeline is a chain of unary operators that process each chunk independently (e.g., TableScan, Validate and
+ * Projection). It is given as a template whose bottom operator has the @param pipeline_input placeholder as its input.
+ * For each morsel, the template is copied onto a TableWrapper that contains the chunk of the morsel. If a scheduler is
+ * set, each morsel is executed as a separate JobTask. The output chunks are appended in the order of the input chunks.
+ * References to the table of a morsel are redirected to the input table, so that the output has the same RowIDs as the
+ * output of the regular operators.
+ *
+ * Operators whose output depends on more than a single chunk (e.g., hash builds, aggregates and sorts) are pipeline
+ * breakers and must not be part of the pipeline. Use the MorselAwareLQPTranslator to create MorselPipelines.
+ */
+class MorselPipeline : public AbstractReadOnlyOperator {
+ public:
+  MorselPipeline(const std::shared_ptr<const AbstractOperator>& input,
+                 const std::shared_ptr<const AbstractOperator>& pipeline_root,
+                 const std::shared_ptr<const AbstractOperator>& pipeline_input);
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+  const std::shared_ptr<const AbstractOperator>& pipeline_root() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_input_left,
+      const std::shared_ptr<AbstractOperator>& copied_input_right) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+ private:
+  std::shared_ptr<const Table> _execute_morsel(const std::shared_ptr<const Table>& morsel) const;
+
+  static std::shared_ptr<Chunk> _rebase_chunk(const std::shared_ptr<const Chunk>& chunk,
+                                              const std::shared_ptr<const Table>& morsel,
+                                              const std::shared_ptr<const Table>& in_table,
+                                              const ChunkID morsel_chunk_id);
+
+  // The template of the pipeline is never executed itself
+  const std::shared_ptr<const AbstractOperator> _pipeline_root;
+  const std::shared_ptr<const AbstractOperator> _pipeline_input;
+
+  std::unordered_map<ParameterID, AllTypeVariant> _parameters;
+};
+
+}  // namespace opossum
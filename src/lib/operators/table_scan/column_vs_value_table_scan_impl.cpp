@@ -1,15 +1,21 @@
 #include "column_vs_value_table_scan_impl.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "sorted_segment_search.hpp"
 #include "storage/base_dictionary_segment.hpp"
 #include "storage/create_iterable_from_segment.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "storage/resolve_encoded_segment_type.hpp"
 #include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 
 #include "resolve_type.hpp"
 #include "type_comparison.hpp"
@@ -43,6 +49,12 @@ void ColumnVsValueTableScanImpl::_scan_non_reference_segment(
     // Select optimized or generic scanning implementation based on segment type
     if (const auto* dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment)) {
       _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+    } else if (const auto* encoded_segment = dynamic_cast<const BaseEncodedSegment*>(&segment);
+               encoded_segment && !position_filter && encoded_segment->encoding_type() == EncodingType::RunLength) {
+      _scan_run_length_segment(segment, chunk_id, matches);
+    } else if (encoded_segment && !position_filter &&
+               encoded_segment->encoding_type() == EncodingType::FrameOfReference) {
+      _scan_frame_of_reference_segment(segment, chunk_id, matches);
     } else {
       _scan_generic_segment(segment, chunk_id, matches, position_filter);
     }
@@ -133,6 +145,115 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(const BaseDictionarySe
   });
 }
 
+void ColumnVsValueTableScanImpl::_scan_run_length_segment(const BaseSegment& segment, const ChunkID chunk_id,
+                                                          PosList& matches) const {
+  resolve_data_type(_in_table->column_data_type(_column_id), [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    const auto& run_length_segment = static_cast<const RunLengthSegment<ColumnDataType>&>(segment);
+    const auto& values = *run_length_segment.values();
+    const auto& null_values = *run_length_segment.null_values();
+    const auto& end_positions = *run_length_segment.end_positions();
+
+    const auto typed_value = type_cast_variant<ColumnDataType>(_value);
+
+    with_comparator(_predicate_condition, [&](auto predicate_comparator) {
+      auto run_begin = ChunkOffset{0};
+      for (auto run_index = size_t{0}; run_index < values.size(); ++run_index) {
+        const auto run_end = static_cast<ChunkOffset>(end_positions[run_index] + 1);
+
+        // All rows of a run share the same value, so a matching run is emitted as a whole
+        if (!null_values[run_index] && predicate_comparator(values[run_index], typed_value)) {
+          auto output_index = matches.size();
+          matches.resize(matches.size() + (run_end - run_begin));
+
+          for (auto chunk_offset = run_begin; chunk_offset < run_end; ++chunk_offset) {
+            matches[output_index++] = RowID{chunk_id, chunk_offset};
+          }
+        }
+
+        run_begin = run_end;
+      }
+    });
+  });
+}
+
+void ColumnVsValueTableScanImpl::_scan_frame_of_reference_segment(const BaseSegment& segment, const ChunkID chunk_id,
+                                                                  PosList& matches) const {
+  resolve_data_type(_in_table->column_data_type(_column_id), [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    if constexpr (hana::value(encoding_supports_data_type(enum_c<EncodingType, EncodingType::FrameOfReference>,
+                                                          hana::type_c<ColumnDataType>))) {
+      using Segment = FrameOfReferenceSegment<ColumnDataType>;
+
+      const auto& frame_of_reference_segment = static_cast<const Segment&>(segment);
+      const auto& block_minima = frame_of_reference_segment.block_minima();
+      const auto& null_values = frame_of_reference_segment.null_values();
+      const auto segment_size = static_cast<ChunkOffset>(frame_of_reference_segment.size());
+
+      const auto typed_value = type_cast_variant<ColumnDataType>(_value);
+
+      // Matches are written unconditionally and the output index only advances for matching rows. The vector is
+      // shrunk to the actual number of matches in the end.
+      auto output_index = matches.size();
+      matches.resize(matches.size() + segment_size);
+
+      resolve_compressed_vector_type(frame_of_reference_segment.offset_values(), [&](const auto& offset_values) {
+        auto offset_it = offset_values.cbegin();
+
+        with_comparator(_predicate_condition, [&](auto predicate_comparator) {
+          for (auto block_index = size_t{0}; block_index < block_minima.size(); ++block_index) {
+            const auto block_begin = static_cast<ChunkOffset>(block_index * Segment::block_size);
+            const auto block_end = std::min(static_cast<ChunkOffset>(block_begin + Segment::block_size), segment_size);
+            const auto block_minimum = block_minima[block_index];
+
+            /**
+             * Translate the search value into the offset domain of the block, i.e., subtract the block's minimum. If
+             * the result is not representable as an offset, the predicate yields the same result for all rows of the
+             * block: A search value below the minimum is smaller than all offsets, one above the largest possible
+             * offset is greater than all of them.
+             */
+            auto block_result = std::optional<bool>{};
+            auto search_offset = uint32_t{0};
+            if (typed_value < block_minimum) {
+              block_result = predicate_comparator(uint32_t{1}, uint32_t{0});
+            } else {
+              const auto difference = static_cast<uint64_t>(typed_value) - static_cast<uint64_t>(block_minimum);
+              if (difference > std::numeric_limits<uint32_t>::max()) {
+                block_result = predicate_comparator(uint32_t{0}, uint32_t{1});
+              } else {
+                search_offset = static_cast<uint32_t>(difference);
+              }
+            }
+
+            if (block_result) {
+              if (*block_result) {
+                for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset) {
+                  matches[output_index] = RowID{chunk_id, chunk_offset};
+                  output_index += !null_values[chunk_offset];
+                }
+              }
+              std::advance(offset_it, block_end - block_begin);
+              continue;
+            }
+
+            for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset, ++offset_it) {
+              matches[output_index] = RowID{chunk_id, chunk_offset};
+              output_index += predicate_comparator(static_cast<uint32_t>(*offset_it), search_offset) &
+                              !null_values[chunk_offset];
+            }
+          }
+        });
+      });
+
+      matches.resize(output_index);
+    } else {
+      Fail("Frame-of-reference encoding does not support this data type");
+    }
+  });
+}
+
 void ColumnVsValueTableScanImpl::_scan_sorted_segment(const BaseSegment& segment, const ChunkID chunk_id,
                                                       PosList& matches,
                                                       const std::shared_ptr<const PosList>& position_filter,
@@ -21,6 +21,9 @@ namespace opossum {
  * - For dictionary segments, we basically look up the value ID of the constant value in the dictionary
  *   in order to avoid having to look up each value ID of the attribute vector in the dictionary. This also
  *   enables us to detect if all or none of the values in the segment satisfy the expression.
+ * - For run-length segments, the predicate is evaluated once per run and whole runs are emitted
+ * - For frame-of-reference segments, the value is translated into each block's offset domain so that the
+ *   offsets can be compared without decoding them
  */
 class ColumnVsValueTableScanImpl : public AbstractSingleColumnTableScanImpl {
  public:
@@ -38,6 +41,10 @@ class ColumnVsValueTableScanImpl : public AbstractSingleColumnTableScanImpl {
   void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, PosList& matches,
                                 const std::shared_ptr<const PosList>& position_filter) const;
 
+  // Both expect the segment to be scanned completely, i.e., without a position filter
+  void _scan_run_length_segment(const BaseSegment& segment, const ChunkID chunk_id, PosList& matches) const;
+  void _scan_frame_of_reference_segment(const BaseSegment& segment, const ChunkID chunk_id, PosList& matches) const;
+
   void _scan_sorted_segment(const BaseSegment& segment, const ChunkID chunk_id, PosList& matches,
                             const std::shared_ptr<const PosList>& position_filter,
                             const OrderByMode order_by_mode) const;
@@ -3,11 +3,15 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "all_parameter_variant.hpp"
 #include "constant_mappings.hpp"
+#include "expression/abstract_predicate_expression.hpp"
+#include "expression/lqp_column_expression.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "logical_query_plan/predicate_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
@@ -32,27 +36,58 @@ std::string IndexScanRule::name() const { return "Index Scan Rule"; }
 
 void IndexScanRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) const {
   if (node->type == LQPNodeType::Predicate) {
-    const auto& child = node->left_input();
+    const auto predicate_node = std::static_pointer_cast<PredicateNode>(node);
 
-    if (child->type == LQPNodeType::StoredTable) {
-      const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
-      const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(child);
-      const auto table = StorageManager::get().get_table(stored_table_node->table_name);
+    // The indexes are those of the stored table that the predicate's column originates from. The PredicateNode does
+    // not need to directly follow the StoredTableNode (e.g., there might be a ValidateNode in between).
+    const auto stored_column = _find_stored_column(*predicate_node);
+    if (stored_column) {
+      const auto& [table, column_id] = *stored_column;
 
       const auto index_infos = table->get_indexes();
       for (const auto& index_info : index_infos) {
-        if (_is_index_scan_applicable(index_info, predicate_node)) {
+        if (_is_index_scan_applicable(index_info, predicate_node, *table, column_id)) {
           predicate_node->scan_type = ScanType::IndexScan;
         }
       }
+
+      if (_is_hash_index_scan_applicable(*table, column_id, predicate_node)) {
+        predicate_node->scan_type = ScanType::IndexScan;
+      }
     }
   }
 
   _apply_to_inputs(node);
 }
 
+std::optional<std::pair<std::shared_ptr<Table>, ColumnID>> IndexScanRule::_find_stored_column(
+    const PredicateNode& predicate_node) const {
+  const auto predicate = std::dynamic_pointer_cast<AbstractPredicateExpression>(predicate_node.predicate());
+  if (!predicate || predicate->arguments.empty()) return std::nullopt;
+
+  const auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->arguments[0]);
+  if (!column_expression) return std::nullopt;
+
+  const auto stored_table_node =
+      std::dynamic_pointer_cast<const StoredTableNode>(column_expression->column_reference.original_node());
+  if (!stored_table_node) return std::nullopt;
+
+  // The IndexScan intersects the index results with the rows of the stored table that its input references. Thus, only
+  // predicates and validates may be in between. Other nodes (e.g., the group-by columns of an AggregateNode or the
+  // output of a ProjectionNode) do not reference the stored table's rows, even though their columns originate from it.
+  auto input_node = predicate_node.left_input();
+  while (input_node->type == LQPNodeType::Predicate || input_node->type == LQPNodeType::Validate) {
+    input_node = input_node->left_input();
+  }
+  if (input_node != stored_table_node) return std::nullopt;
+
+  return std::pair{StorageManager::get().get_table(stored_table_node->table_name),
+                   column_expression->column_reference.original_column_id()};
+}
+
 bool IndexScanRule::_is_index_scan_applicable(const IndexInfo& index_info,
-                                              const std::shared_ptr<PredicateNode>& predicate_node) const {
+                                              const std::shared_ptr<PredicateNode>& predicate_node, const Table& table,
+                                              const ColumnID stored_column_id) const {
   if (!_is_single_segment_index(index_info)) return false;
 
   if (index_info.type != SegmentIndexType::GroupKey) return false;
@@ -64,19 +99,45 @@ bool IndexScanRule::_is_index_scan_applicable(const IndexInfo& index_info,
 
   const auto& operator_predicate = (*operator_predicates)[0];
 
-  // Currently, we do not support two-column predicates
-  if (is_column_id(operator_predicate.value)) return false;
+  // Currently, we do not support two-column predicates. Parameters (e.g., in the plans of the
+  // SQLParameterizedPlanCache) are not supported either, as the IndexScan needs to know the values when it is created.
+  if (!is_variant(operator_predicate.value)) return false;
+  if (operator_predicate.value2 && !is_variant(*operator_predicate.value2)) return false;
 
-  if (index_info.column_ids[0] != operator_predicate.column_id) return false;
+  if (index_info.column_ids[0] != stored_column_id) return false;
 
-  const auto row_count_table = predicate_node->left_input()->derive_statistics_from(nullptr, nullptr)->row_count();
+  const auto row_count_table = predicate_node->left_input()->get_statistics()->row_count();
   if (row_count_table < INDEX_SCAN_ROW_COUNT_THRESHOLD) return false;
 
   const auto row_count_predicate =
       predicate_node->derive_statistics_from(predicate_node->left_input(), nullptr)->row_count();
   const float selectivity = row_count_predicate / row_count_table;
 
-  return selectivity <= INDEX_SCAN_SELECTIVITY_THRESHOLD;
+  if (selectivity > INDEX_SCAN_SELECTIVITY_THRESHOLD) return false;
+
+  // On a reference input, the index yields the matches in the entire stored table, which are then intersected with
+  // the input. This only pays off if there are fewer of them than input rows.
+  if (predicate_node->left_input()->type != LQPNodeType::StoredTable) {
+    const auto row_count_stored_table = static_cast<float>(table.row_count());
+    if (selectivity * row_count_stored_table > row_count_table) return false;
+  }
+
+  return true;
+}
+
+bool IndexScanRule::_is_hash_index_scan_applicable(const Table& table, const ColumnID stored_column_id,
+                                                   const std::shared_ptr<PredicateNode>& predicate_node) const {
+  const auto operator_predicates =
+      OperatorScanPredicate::from_expression(*predicate_node->predicate(), *predicate_node);
+  if (!operator_predicates) return false;
+  if (operator_predicates->size() != 1) return false;
+
+  const auto& operator_predicate = (*operator_predicates)[0];
+  if (operator_predicate.predicate_condition != PredicateCondition::Equals) return false;
+  if (!is_variant(operator_predicate.value)) return false;
+
+  // A point lookup in a table-wide hash index only touches the matching rows, so the table size does not matter
+  return table.get_hash_index({stored_column_id}) != nullptr;
 }
 
 inline bool IndexScanRule::_is_single_segment_index(const IndexInfo& index_info) const {
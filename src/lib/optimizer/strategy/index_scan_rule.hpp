@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_rule.hpp"
@@ -12,17 +14,24 @@ namespace opossum {
 
 class AbstractLQPNode;
 class PredicateNode;
+class Table;
 
 /**
- * This optimizer rule finds PredicateNodes whose inputs are StoredTableNodes. These PredicateNodes are candidates
- * for being executed by IndexScans. If the expected selectivity of the predicate falls below a certain threshold, the
- * ScanType of the PredicateNode is set to IndexScan.
+ * This optimizer rule finds PredicateNodes on columns of stored tables. These PredicateNodes are candidates for being
+ * executed by IndexScans. If the expected selectivity of the predicate falls below a certain threshold, the ScanType
+ * of the PredicateNode is set to IndexScan.
+ *
+ * The PredicateNode does not need to directly follow the StoredTableNode. If ValidateNodes or other PredicateNodes are
+ * in between, the IndexScan intersects the index results with its reference input. As the index yields the matches of
+ * the entire stored table, this is only chosen if these are expected to be fewer than the input rows. Predicates above
+ * any other nodes (e.g., AggregateNodes or ProjectionNodes) are not executed as IndexScans.
  *
  * Note:
  * For now this rule is only applicable to single-column indexes. Multi-column predicates (i.e. WHERE a < b) are also
  * not supported. We also assume that if chunks have an index, all of them are of the same type, we do not mix GroupKey
- * and ART indexes. In addition, chains of IndexScans are not possible since an IndexScan's input must be a GetTable.
- * Currently, only GroupKeyIndexes are supported.
+ * and ART indexes. Currently, only GroupKeyIndexes are supported.
+ *
+ * Equality predicates on a column with a table-wide hash index (see TableHashIndex) are always executed as IndexScans.
  */
 
 class IndexScanRule : public AbstractRule {
@@ -31,8 +40,14 @@ class IndexScanRule : public AbstractRule {
   void apply_to(const std::shared_ptr<AbstractLQPNode>& node) const override;
 
  protected:
-  bool _is_index_scan_applicable(const IndexInfo& index_info,
-                                 const std::shared_ptr<PredicateNode>& predicate_node) const;
+  // Returns the stored table and the column within it that the predicate's (first) column originates from
+  std::optional<std::pair<std::shared_ptr<Table>, ColumnID>> _find_stored_column(
+      const PredicateNode& predicate_node) const;
+
+  bool _is_index_scan_applicable(const IndexInfo& index_info, const std::shared_ptr<PredicateNode>& predicate_node,
+                                 const Table& table, const ColumnID stored_column_id) const;
+  bool _is_hash_index_scan_applicable(const Table& table, const ColumnID stored_column_id,
+                                      const std::shared_ptr<PredicateNode>& predicate_node) const;
   inline bool _is_single_segment_index(const IndexInfo& index_info) const;
 };
 
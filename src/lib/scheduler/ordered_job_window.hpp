@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+/**
+ * Processes a sequence of items (e.g., the chunks of a table) with tasks that run in parallel, but finishes the items
+ * in the order in which they were added (e.g., appends parsed chunks to a table in file order). To bound the memory
+ * used by unfinished items, only MAX_PENDING_ITEMS_PER_WORKER items per worker are in flight. Adding another item
+ * first waits for the tasks of the oldest item and finishes it.
+ *
+ * The items are kept in a std::list, so the tasks of an item can refer to it until it is finished. finish_all() has
+ * to be called after the last item was added.
+ */
+template <typename Item>
+class OrderedJobWindow {
+ public:
+  static constexpr auto MAX_PENDING_ITEMS_PER_WORKER = size_t{2};
+
+  // @param finish is called for each item once its tasks are done
+  explicit OrderedJobWindow(std::function<void(Item&)> finish)
+      : _finish(std::move(finish)), _max_pending_items(MAX_PENDING_ITEMS_PER_WORKER * _worker_count()) {}
+
+  /**
+   * Adds the item and schedules the tasks returned by `create_tasks(Item& item)`. The reference passed to
+   * `create_tasks` stays valid until the item is finished.
+   */
+  template <typename CreateTasks>
+  void add(Item item, const CreateTasks& create_tasks) {
+    auto& pending_item = _pending_items.emplace_back(std::move(item), std::vector<std::shared_ptr<AbstractTask>>{});
+    pending_item.second = create_tasks(pending_item.first);
+    for (const auto& task : pending_item.second) {
+      task->schedule();
+    }
+
+    while (_pending_items.size() > _max_pending_items) {
+      _finish_oldest_item();
+    }
+  }
+
+  // Waits for the tasks of the remaining items and finishes them
+  void finish_all() {
+    while (!_pending_items.empty()) {
+      _finish_oldest_item();
+    }
+  }
+
+  size_t max_pending_items() const { return _max_pending_items; }
+
+ private:
+  static size_t _worker_count() {
+    return CurrentScheduler::is_set() ? std::max(Topology::get().num_cpus(), size_t{1}) : size_t{1};
+  }
+
+  void _finish_oldest_item() {
+    auto& [item, tasks] = _pending_items.front();
+    CurrentScheduler::wait_for_tasks(tasks);
+    _finish(item);
+    _pending_items.pop_front();
+  }
+
+  const std::function<void(Item&)> _finish;
+  const size_t _max_pending_items;
+  std::list<std::pair<Item, std::vector<std::shared_ptr<AbstractTask>>>> _pending_items;
+};
+
+}  // namespace opossum
@@ -0,0 +1,129 @@
+#include "cached_query_result.hpp"
+
+#include <set>
+
+#include "expression/expression_utils.hpp"
+#include "expression/pqp_subquery_expression.hpp"
+#include "operators/abstract_operator.hpp"
+#include "operators/get_table.hpp"
+#include "operators/limit.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Adds the names of the tables read by @param op and its inputs (including subqueries) to @param table_names. Returns
+// false if @param op or one of its inputs is not known to be free of side effects.
+bool collect_table_names(const std::shared_ptr<const AbstractOperator>& op, std::set<std::string>& table_names) {
+  if (!op) return true;
+
+  auto expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
+
+  switch (op->type()) {
+    case OperatorType::GetTable:
+      table_names.emplace(std::static_pointer_cast<const GetTable>(op)->table_name());
+      break;
+
+    case OperatorType::Projection:
+      expressions = std::static_pointer_cast<const Projection>(op)->expressions;
+      break;
+
+    case OperatorType::TableScan:
+      expressions.emplace_back(std::static_pointer_cast<const TableScan>(op)->predicate());
+      break;
+
+    case OperatorType::Limit:
+      expressions.emplace_back(std::static_pointer_cast<const Limit>(op)->row_count_expression());
+      break;
+
+    case OperatorType::Aggregate:
+    case OperatorType::Alias:
+    case OperatorType::Difference:
+    case OperatorType::IndexScan:
+    case OperatorType::JitOperatorWrapper:
+    case OperatorType::JoinBand:
+    case OperatorType::JoinHash:
+    case OperatorType::JoinIndex:
+    case OperatorType::JoinMPSM:
+    case OperatorType::JoinNestedLoop:
+    case OperatorType::JoinSortMerge:
+    case OperatorType::MorselPipeline:
+    case OperatorType::Product:
+    case OperatorType::Sort:
+    case OperatorType::TableWrapper:
+    case OperatorType::UnionAll:
+    case OperatorType::UnionPositions:
+    case OperatorType::Validate:
+      break;
+
+    default:
+      return false;
+  }
+
+  auto subqueries_are_cacheable = true;
+  for (const auto& expression : expressions) {
+    visit_expression(expression, [&](const auto& sub_expression) {
+      const auto pqp_subquery_expression = std::dynamic_pointer_cast<PQPSubqueryExpression>(sub_expression);
+      if (!pqp_subquery_expression) return ExpressionVisitation::VisitArguments;
+
+      subqueries_are_cacheable &= collect_table_names(pqp_subquery_expression->pqp, table_names);
+      return ExpressionVisitation::DoNotVisitArguments;
+    });
+  }
+
+  return subqueries_are_cacheable && collect_table_names(op->input_left(), table_names) &&
+         collect_table_names(op->input_right(), table_names);
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::shared_ptr<CachedQueryResult> CachedQueryResult::create(const std::shared_ptr<const Table>& result_table,
+                                                             const std::shared_ptr<const AbstractOperator>& pqp,
+                                                             const CommitID snapshot_commit_id) {
+  if (!result_table || result_table->estimate_memory_usage() > MAX_MEMORY_USAGE) return nullptr;
+
+  auto table_names = std::set<std::string>{};
+  if (!collect_table_names(pqp, table_names)) return nullptr;
+
+  // A table was dropped while the plan was executed
+  for (const auto& table_name : table_names) {
+    if (!StorageManager::get().has_table(table_name)) return nullptr;
+  }
+
+  return std::make_shared<CachedQueryResult>(result_table, snapshot_commit_id,
+                                             std::vector<std::string>(table_names.begin(), table_names.end()));
+}
+
+CachedQueryResult::CachedQueryResult(const std::shared_ptr<const Table>& result_table,
+                                     const CommitID snapshot_commit_id, const std::vector<std::string>& table_names)
+    : result_table(result_table),
+      snapshot_commit_id(snapshot_commit_id),
+      memory_usage(result_table->estimate_memory_usage()) {
+  for (const auto& table_name : table_names) {
+    _table_snapshots.emplace_back(TableSnapshot{table_name, StorageManager::get().get_table(table_name)});
+  }
+}
+
+bool CachedQueryResult::is_valid() const {
+  const auto& storage_manager = StorageManager::get();
+
+  for (const auto& table_snapshot : _table_snapshots) {
+    if (!storage_manager.has_table(table_snapshot.table_name)) return false;
+
+    const auto table = storage_manager.get_table(table_snapshot.table_name);
+    if (table != table_snapshot.table.lock()) return false;
+
+    // A later commit modified the table, so the result might not be what a new transaction would see
+    if (table->last_commit_id() > snapshot_commit_id) return false;
+  }
+
+  return true;
+}
+
+}  // namespace opossum
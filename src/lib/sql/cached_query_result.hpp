@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class Table;
+
+/**
+ * The result of a read-only statement, stored in the SQLQueryResultCache so that repeated executions of the statement
+ * return the result without executing a plan.
+ *
+ * The result was computed by a transaction that saw all commits up to its snapshot commit ID. As long as no later
+ * commit inserted or deleted rows in one of the tables that the plan reads (see Table::last_commit_id()), a new
+ * transaction would compute the same result. Once a table is modified, dropped, or replaced, the entry is invalid.
+ */
+class CachedQueryResult final {
+ public:
+  // Larger results are not cached. Together with the capacity of the SQLQueryResultCache, this bounds its memory usage.
+  static constexpr auto MAX_MEMORY_USAGE = size_t{1'000'000};
+
+  /**
+   * @param pqp                 the executed plan, used to find the tables it reads
+   * @param snapshot_commit_id  the snapshot commit ID of the transaction that executed @param pqp
+   * @return the entry for @param result_table, or nullptr if the result must not be cached, i.e., if the plan might
+   *         have side effects (e.g., modify tables or write files), reads tables that are not tracked, or the result is
+   *         larger than MAX_MEMORY_USAGE
+   */
+  static std::shared_ptr<CachedQueryResult> create(const std::shared_ptr<const Table>& result_table,
+                                                   const std::shared_ptr<const AbstractOperator>& pqp,
+                                                   const CommitID snapshot_commit_id);
+
+  // Prefer create(), which finds the tables that the plan reads
+  CachedQueryResult(const std::shared_ptr<const Table>& result_table, const CommitID snapshot_commit_id,
+                    const std::vector<std::string>& table_names);
+
+  bool is_valid() const;
+
+  const std::shared_ptr<const Table> result_table;
+  const CommitID snapshot_commit_id;
+  const size_t memory_usage;
+
+ private:
+  struct TableSnapshot {
+    std::string table_name;
+    std::weak_ptr<const Table> table;
+  };
+
+  std::vector<TableSnapshot> _table_snapshots;
+};
+
+}  // namespace opossum
@@ -0,0 +1,72 @@
+#include "parameterized_plan.hpp"
+
+#include <set>
+#include <unordered_map>
+
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "operators/abstract_operator.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ParameterizedPlan::ParameterizedPlan(const std::shared_ptr<AbstractOperator>& pqp,
+                                     const std::vector<ParameterID>& parameter_ids, const UseMvcc use_mvcc,
+                                     const std::shared_ptr<AbstractLQPNode>& lqp)
+    : pqp(pqp), parameter_ids(parameter_ids), use_mvcc(use_mvcc) {
+  auto table_names = std::set<std::string>{};
+  for (const auto& root : lqp_find_subplan_roots(lqp)) {
+    visit_lqp(root, [&](const auto& node) {
+      if (const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(node)) {
+        table_names.emplace(stored_table_node->table_name);
+      }
+      return LQPVisitation::VisitInputs;
+    });
+  }
+
+  for (const auto& table_name : table_names) {
+    const auto table = StorageManager::get().get_table(table_name);
+    _table_snapshots.emplace_back(TableSnapshot{table_name, table, table->row_count()});
+  }
+}
+
+bool ParameterizedPlan::is_valid() const {
+  const auto& storage_manager = StorageManager::get();
+
+  for (const auto& table_snapshot : _table_snapshots) {
+    if (!storage_manager.has_table(table_snapshot.table_name)) return false;
+
+    const auto table = storage_manager.get_table(table_snapshot.table_name);
+    if (table != table_snapshot.table.lock()) return false;
+
+    const auto row_count = static_cast<double>(table->row_count());
+    const auto snapshot_row_count = static_cast<double>(table_snapshot.row_count);
+    if (row_count > snapshot_row_count * ROW_COUNT_DRIFT_FACTOR ||
+        row_count * ROW_COUNT_DRIFT_FACTOR < snapshot_row_count) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<AbstractOperator> ParameterizedPlan::instantiate(
+    const std::vector<AllTypeVariant>& parameter_values) const {
+  Assert(parameter_values.size() == parameter_ids.size(),
+         std::string("Incorrect number of parameters supplied - expected ") + std::to_string(parameter_ids.size()) +
+             " got " + std::to_string(parameter_values.size()));
+
+  auto parameters = std::unordered_map<ParameterID, AllTypeVariant>{};
+  for (auto parameter_idx = size_t{0}; parameter_idx < parameter_values.size(); ++parameter_idx) {
+    parameters.emplace(parameter_ids[parameter_idx], parameter_values[parameter_idx]);
+  }
+
+  const auto instantiated_pqp = pqp->deep_copy();
+  instantiated_pqp->set_parameters(parameters);
+
+  return instantiated_pqp;
+}
+
+}  // namespace opossum
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+class AbstractOperator;
+class Table;
+
+/**
+ * A physical query plan for a normalized query (see normalize_sql_query()), in which the extracted literals are
+ * replaced by CorrelatedParameterExpressions. It is instantiated for a concrete query by setting the parameters to the
+ * query's literals. As the plan is optimized without knowing the values, optimizations that depend on them (e.g.,
+ * chunk pruning or index scans) are not applied.
+ *
+ * A plan becomes invalid if one of the tables it reads is dropped or replaced (as the plan might refer to columns
+ * that do not exist anymore) or if the row count of one of the tables drifted so far that the plan's join order and
+ * predicate order are likely to be outdated.
+ */
+class ParameterizedPlan final {
+ public:
+  // A plan is invalidated once the row count of one of its tables grew or shrank by more than this factor
+  static constexpr auto ROW_COUNT_DRIFT_FACTOR = 2.0;
+
+  /**
+   * @param lqp  the optimized LQP that @param pqp was translated from, used to find the tables the plan reads
+   */
+  ParameterizedPlan(const std::shared_ptr<AbstractOperator>& pqp, const std::vector<ParameterID>& parameter_ids,
+                    const UseMvcc use_mvcc, const std::shared_ptr<AbstractLQPNode>& lqp);
+
+  bool is_valid() const;
+
+  /**
+   * @return A copy of the plan, with the parameters set to @param parameter_values
+   */
+  std::shared_ptr<AbstractOperator> instantiate(const std::vector<AllTypeVariant>& parameter_values) const;
+
+  const std::shared_ptr<AbstractOperator> pqp;
+  const std::vector<ParameterID> parameter_ids;
+  const UseMvcc use_mvcc;
+
+ private:
+  struct TableSnapshot {
+    std::string table_name;
+    std::weak_ptr<const Table> table;
+    uint64_t row_count;
+  };
+
+  std::vector<TableSnapshot> _table_snapshots;
+};
+
+}  // namespace opossum
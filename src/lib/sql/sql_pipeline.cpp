@@ -15,7 +15,9 @@ namespace opossum {
 
 SQLPipeline::SQLPipeline(const std::string& sql, std::shared_ptr<TransactionContext> transaction_context,
                          const UseMvcc use_mvcc, const std::shared_ptr<LQPTranslator>& lqp_translator,
-                         const std::shared_ptr<Optimizer>& optimizer, const CleanupTemporaries cleanup_temporaries)
+                         const std::shared_ptr<Optimizer>& optimizer, const CleanupTemporaries cleanup_temporaries,
+                         const UseParameterizedPlanCache use_parameterized_plan_cache,
+                         const UseResultCache use_result_cache)
     : _sql(sql), _transaction_context(transaction_context), _optimizer(optimizer) {
   DebugAssert(!_transaction_context || _transaction_context->phase() == TransactionPhase::Active,
               "The transaction context cannot have been committed already.");
@@ -73,9 +75,9 @@ SQLPipeline::SQLPipeline(const std::string& sql, std::shared_ptr<TransactionCont
     const auto statement_string = boost::trim_copy(sql.substr(sql_string_offset, statement_string_length));
     sql_string_offset += statement_string_length;
 
-    auto pipeline_statement =
-        std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement), use_mvcc,
-                                               transaction_context, lqp_translator, optimizer, cleanup_temporaries);
+    auto pipeline_statement = std::make_shared<SQLPipelineStatement>(
+        statement_string, std::move(parsed_statement), use_mvcc, transaction_context, lqp_translator, optimizer,
+        cleanup_temporaries, use_parameterized_plan_cache, use_result_cache);
     _sql_pipeline_statements.push_back(std::move(pipeline_statement));
   }
 
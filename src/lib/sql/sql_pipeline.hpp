@@ -35,7 +35,8 @@ class SQLPipeline : public Noncopyable {
   // Prefer using the SQLPipelineBuilder interface for constructing SQLPipelines conveniently
   SQLPipeline(const std::string& sql, std::shared_ptr<TransactionContext> transaction_context, const UseMvcc use_mvcc,
               const std::shared_ptr<LQPTranslator>& lqp_translator, const std::shared_ptr<Optimizer>& optimizer,
-              const CleanupTemporaries cleanup_temporaries);
+              const CleanupTemporaries cleanup_temporaries,
+              const UseParameterizedPlanCache use_parameterized_plan_cache, const UseResultCache use_result_cache);
 
   // Returns the original SQL string
   const std::string get_sql() const;
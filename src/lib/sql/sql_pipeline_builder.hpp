@@ -28,6 +28,8 @@ class Optimizer;
  *  - MVCC is enabled
  *  - The default Optimizer (Optimizer::create_default_optimizer()) is used.
  *  - No JIT operators
+ *  - The SQLParameterizedPlanCache is not used
+ *  - The SQLQueryResultCache is not used
  *
  * Favour this interface over calling the SQLPipeline[Statement] constructors with their long parameter list.
  * See SQLPipeline[Statement] doc for these classes, in short SQLPipeline ist for queries with multiple statement,
@@ -42,6 +44,18 @@ class SQLPipelineBuilder final {
   SQLPipelineBuilder& with_optimizer(const std::shared_ptr<Optimizer>& optimizer);
   SQLPipelineBuilder& with_transaction_context(const std::shared_ptr<TransactionContext>& transaction_context);
 
+  /**
+   * Look up and store plans in the SQLParameterizedPlanCache, so that queries that only differ in their literals share
+   * a plan. See SQLPipelineStatement.
+   */
+  SQLPipelineBuilder& with_parameterized_plan_cache(const UseParameterizedPlanCache use_parameterized_plan_cache);
+
+  /**
+   * Look up and store the results of read-only statements in the SQLQueryResultCache, so that repeated statements are
+   * not executed as long as the tables they read are not modified. See SQLPipelineStatement.
+   */
+  SQLPipelineBuilder& with_result_cache(const UseResultCache use_result_cache);
+
   /**
    * Short for with_mvcc(UseMvcc::No)
    */
@@ -68,6 +82,8 @@ class SQLPipelineBuilder final {
   std::shared_ptr<LQPTranslator> _lqp_translator;
   std::shared_ptr<Optimizer> _optimizer;
   CleanupTemporaries _cleanup_temporaries{true};
+  UseParameterizedPlanCache _use_parameterized_plan_cache{UseParameterizedPlanCache::No};
+  UseResultCache _use_result_cache{UseResultCache::No};
 };
 
 }  // namespace opossum
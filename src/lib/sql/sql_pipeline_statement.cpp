@@ -2,19 +2,28 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <utility>
 
 #include "SQLParser.h"
 #include "concurrency/transaction_manager.hpp"
 #include "create_sql_parser_error_message.hpp"
+#include "expression/correlated_parameter_expression.hpp"
 #include "expression/value_expression.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
 #include "optimizer/optimizer.hpp"
+#include "resolve_type.hpp"
 #include "scheduler/current_scheduler.hpp"
+#include "sql/cached_query_result.hpp"
+#include "sql/parameterized_plan.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_plan_cache.hpp"
 #include "sql/sql_translator.hpp"
+#include "storage/prepared_plan.hpp"
 #include "utils/assert.hpp"
 #include "utils/tracing/probes.hpp"
 
@@ -25,7 +34,9 @@ SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_p
                                            const std::shared_ptr<TransactionContext>& transaction_context,
                                            const std::shared_ptr<LQPTranslator>& lqp_translator,
                                            const std::shared_ptr<Optimizer>& optimizer,
-                                           const CleanupTemporaries cleanup_temporaries)
+                                           const CleanupTemporaries cleanup_temporaries,
+                                           const UseParameterizedPlanCache use_parameterized_plan_cache,
+                                           const UseResultCache use_result_cache)
     : _sql_string(sql),
       _use_mvcc(use_mvcc),
       _auto_commit(_use_mvcc == UseMvcc::Yes && !transaction_context),
@@ -34,7 +45,9 @@ SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_p
       _optimizer(optimizer),
       _parsed_sql_statement(std::move(parsed_sql)),
       _metrics(std::make_shared<SQLPipelineStatementMetrics>()),
-      _cleanup_temporaries(cleanup_temporaries) {
+      _cleanup_temporaries(cleanup_temporaries),
+      _use_parameterized_plan_cache(use_parameterized_plan_cache),
+      _use_result_cache(use_result_cache) {
   Assert(!_parsed_sql_statement || _parsed_sql_statement->size() == 1,
          "SQLPipelineStatement must hold exactly one SQL statement");
   DebugAssert(!_sql_string.empty(), "An SQLPipelineStatement should always contain a SQL statement string for caching");
@@ -149,6 +162,11 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
     _physical_plan = (*cached_physical_plan)->deep_copy();
     _metrics->query_plan_cache_hit = true;
 
+  } else if (const auto parameterized_plan = _get_parameterized_plan()) {
+    // Reset time to exclude the creation of the generic plan
+    started = std::chrono::high_resolution_clock::now();
+    _physical_plan = parameterized_plan->instantiate(_normalized_sql_query->parameter_values);
+
   } else {
     // "Normal" mode in which the query plan is created
     const auto& lqp = get_optimized_logical_plan();
@@ -172,6 +190,81 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
   return _physical_plan;
 }
 
+std::shared_ptr<ParameterizedPlan> SQLPipelineStatement::_get_parameterized_plan() {
+  if (_use_parameterized_plan_cache == UseParameterizedPlanCache::No) return nullptr;
+
+  _normalized_sql_query = normalize_sql_query(_sql_string);
+  if (!_normalized_sql_query) return nullptr;
+
+  const auto cache_key = _normalized_sql_query->cache_key();
+  const auto& parameter_values = _normalized_sql_query->parameter_values;
+
+  if (const auto cached_plan = SQLParameterizedPlanCache::get().try_get(cache_key)) {
+    // Plans that are invalid or were created for the other MVCC setting are replaced below
+    if ((*cached_plan)->use_mvcc == _use_mvcc && (*cached_plan)->is_valid()) {
+      _metrics->parameterized_plan_cache_hit = true;
+      return *cached_plan;
+    }
+  }
+
+  auto started = std::chrono::high_resolution_clock::now();
+
+  hsql::SQLParserResult parse_result;
+  hsql::SQLParser::parse(_normalized_sql_query->sql, &parse_result);
+  if (!parse_result.isValid() || parse_result.size() != 1) return nullptr;
+
+  SQLTranslator sql_translator{_use_mvcc};
+  const auto lqp = sql_translator.translate_parser_result(parse_result).front();
+  const auto parameter_ids = sql_translator.parameter_ids_of_value_placeholders();
+  Assert(parameter_ids.size() == parameter_values.size(), "Expected one placeholder per extracted literal");
+
+  // Replace the placeholders by CorrelatedParameterExpressions. As opposed to PlaceholderExpressions, they have a data
+  // type and can thus be optimized. Their values are set when the plan is instantiated.
+  auto parameters = std::vector<std::shared_ptr<AbstractExpression>>{};
+  parameters.reserve(parameter_ids.size());
+  for (auto parameter_idx = size_t{0}; parameter_idx < parameter_ids.size(); ++parameter_idx) {
+    const auto data_type = data_type_from_all_type_variant(parameter_values[parameter_idx]);
+    parameters.emplace_back(std::make_shared<CorrelatedParameterExpression>(
+        parameter_ids[parameter_idx], CorrelatedParameterExpression::ReferencedExpressionInfo{data_type, "?"}));
+  }
+  const auto generic_lqp = PreparedPlan{lqp, parameter_ids}.instantiate(parameters);
+
+  auto done = std::chrono::high_resolution_clock::now();
+  _metrics->sql_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
+
+  started = std::chrono::high_resolution_clock::now();
+  const auto optimized_lqp = _optimizer->optimize(generic_lqp);
+  done = std::chrono::high_resolution_clock::now();
+  _metrics->optimization_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
+
+  const auto pqp = _lqp_translator->translate_node(optimized_lqp);
+  const auto parameterized_plan = std::make_shared<ParameterizedPlan>(pqp, parameter_ids, _use_mvcc, optimized_lqp);
+  SQLParameterizedPlanCache::get().set(cache_key, parameterized_plan);
+
+  return parameterized_plan;
+}
+
+std::string SQLPipelineStatement::_result_cache_key() {
+  if (!_normalized_sql_query) _normalized_sql_query = normalize_sql_query(_sql_string);
+  if (!_normalized_sql_query) return _sql_string;
+
+  // Prefix the values with their type and length, so that values of different types (e.g., 1 and '1') and string
+  // values containing the separators cannot be confused. Floating-point values are written with as many digits as
+  // needed to tell all doubles apart, as the default precision of six digits would map different literals to one key.
+  auto cache_key = _normalized_sql_query->cache_key();
+  auto value_stream = std::ostringstream{};
+  value_stream.precision(std::numeric_limits<double>::max_digits10);
+  for (const auto& parameter_value : _normalized_sql_query->parameter_values) {
+    value_stream.str("");
+    value_stream << parameter_value;
+    const auto value_string = value_stream.str();
+    cache_key += "\n" + std::to_string(parameter_value.which()) + ":" + std::to_string(value_string.size()) + ":" +
+                 value_string;
+  }
+
+  return cache_key;
+}
+
 const std::vector<std::shared_ptr<OperatorTask>>& SQLPipelineStatement::get_tasks() {
   if (!_tasks.empty()) {
     return _tasks;
@@ -186,6 +279,19 @@ const std::shared_ptr<const Table>& SQLPipelineStatement::get_result_table() {
     return _result_table;
   }
 
+  // Results can only be reused if this statement's transaction has not been used yet, i.e., no plan was created
+  const auto use_result_cache = _use_result_cache == UseResultCache::Yes && _auto_commit;
+  const auto result_cache_key = use_result_cache ? _result_cache_key() : std::string{};
+  if (use_result_cache && !_physical_plan) {
+    if (const auto cached_result = SQLQueryResultCache::get().try_get(result_cache_key)) {
+      if ((*cached_result)->is_valid()) {
+        _result_table = (*cached_result)->result_table;
+        _metrics->result_cache_hit = true;
+        return _result_table;
+      }
+    }
+  }
+
   const auto& tasks = get_tasks();
 
   const auto started = std::chrono::high_resolution_clock::now();
@@ -205,6 +311,35 @@ const std::shared_ptr<const Table>& SQLPipelineStatement::get_result_table() {
   _result_table = tasks.back()->get_operator()->get_output();
   if (_result_table == nullptr) _query_has_output = false;
 
+  if (use_result_cache && _transaction_context->phase() == TransactionPhase::Committed) {
+    if (const auto cached_result = CachedQueryResult::create(_result_table, _physical_plan,
+                                                             _transaction_context->snapshot_commit_id())) {
+      // Cost-aware policies prefer keeping results that took long to compute and use little memory
+      const auto cost = static_cast<double>((_metrics->sql_translation_duration + _metrics->optimization_duration +
+                                             _metrics->lqp_translation_duration + _metrics->plan_execution_duration)
+                                                .count());
+      SQLQueryResultCache::get().set(result_cache_key, cached_result, std::max(cost, 1.0),
+                                     static_cast<double>(cached_result->memory_usage));
+    }
+  }
+
+  // Cached plans might read tables or views that were just dropped or replaced
+  switch (_physical_plan->type()) {
+    case OperatorType::CreateTable:
+    case OperatorType::CreateView:
+    case OperatorType::DropTable:
+    case OperatorType::DropView:
+    case OperatorType::ImportBinary:
+    case OperatorType::ImportCsv:
+      SQLPhysicalPlanCache::get().clear();
+      SQLLogicalPlanCache::get().clear();
+      SQLParameterizedPlanCache::get().clear();
+      SQLQueryResultCache::get().clear();
+      break;
+    default:
+      break;
+  }
+
   DTRACE_PROBE8(HYRISE, SUMMARY, _sql_string.c_str(), _metrics->sql_translation_duration.count(),
                 _metrics->optimization_duration.count(), _metrics->lqp_translation_duration.count(),
                 _metrics->plan_execution_duration.count(), _metrics->query_plan_cache_hit, get_tasks().size(),
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "SQLParserResult.h"
@@ -7,10 +8,13 @@
 #include "concurrency/transaction_context.hpp"
 #include "logical_query_plan/lqp_translator.hpp"
 #include "optimizer/optimizer.hpp"
+#include "sql/sql_query_normalizer.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
 
+class ParameterizedPlan;
+
 // Holds relevant information about the execution of an SQLPipelineStatement.
 struct SQLPipelineStatementMetrics {
   std::chrono::nanoseconds sql_translation_duration{};
@@ -19,6 +23,8 @@ struct SQLPipelineStatementMetrics {
   std::chrono::nanoseconds plan_execution_duration{};
 
   bool query_plan_cache_hit = false;
+  bool parameterized_plan_cache_hit = false;
+  bool result_cache_hit = false;
 };
 
 /**
@@ -33,6 +39,21 @@ struct SQLPipelineStatementMetrics {
  * NOTE:
  *  If a physical plan for an SQL statement is in the SQLPhysicalPlanCache, it will be used instead of translating the optimized
  *  LQP (get_optimized_logical_plans()) into a PQP. Thus, in this case, the optimized LQP and PQP could be different.
+ *
+ * NOTE:
+ *  If the SQLParameterizedPlanCache is enabled and the SQLPhysicalPlanCache holds no plan for the statement, the
+ *  statement's literals are extracted (see normalize_sql_query()) and the plan is instantiated from a generic plan for
+ *  the normalized statement. If no valid generic plan is cached, the normalized statement is translated and optimized
+ *  with its literals replaced by parameters, and the result is cached. The optimized LQP is not created in this case.
+ *  Executing a statement that creates or drops tables or views clears all plan caches.
+ *
+ * NOTE:
+ *  If the SQLQueryResultCache is enabled, get_result_table() returns the cached result of an earlier execution of the
+ *  same (normalized) statement without creating or executing a plan, as long as none of the tables it reads was
+ *  modified since (see CachedQueryResult). The cache is only used for statements that run in their own transaction,
+ *  i.e., not for statements that run in an explicitly passed TransactionContext (which might have modified tables
+ *  itself) or without MVCC (whose modifications are not tracked). In case of a cache hit, no TransactionContext is
+ *  created. Only results of read-only plans are cached.
  */
 class SQLPipelineStatement : public Noncopyable {
  public:
@@ -40,7 +61,9 @@ class SQLPipelineStatement : public Noncopyable {
   SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
                        const UseMvcc use_mvcc, const std::shared_ptr<TransactionContext>& transaction_context,
                        const std::shared_ptr<LQPTranslator>& lqp_translator,
-                       const std::shared_ptr<Optimizer>& optimizer, const CleanupTemporaries cleanup_temporaries);
+                       const std::shared_ptr<Optimizer>& optimizer, const CleanupTemporaries cleanup_temporaries,
+                       const UseParameterizedPlanCache use_parameterized_plan_cache,
+                       const UseResultCache use_result_cache);
 
   // Returns the raw SQL string.
   const std::string& get_sql_string();
@@ -72,6 +95,14 @@ class SQLPipelineStatement : public Noncopyable {
   const std::shared_ptr<SQLPipelineStatementMetrics>& metrics() const;
 
  private:
+  // Returns the generic plan for the normalized statement from the SQLParameterizedPlanCache or creates and caches it.
+  // Returns nullptr if the statement cannot be normalized.
+  std::shared_ptr<ParameterizedPlan> _get_parameterized_plan();
+
+  // Returns the key of the statement in the SQLQueryResultCache, so that statements which only differ in their
+  // formatting share a cached result
+  std::string _result_cache_key();
+
   const std::string _sql_string;
   const UseMvcc _use_mvcc;
 
@@ -98,6 +129,11 @@ class SQLPipelineStatement : public Noncopyable {
 
   // Delete temporary tables
   const CleanupTemporaries _cleanup_temporaries;
+
+  const UseParameterizedPlanCache _use_parameterized_plan_cache;
+  std::optional<NormalizedSQLQuery> _normalized_sql_query;
+
+  const UseResultCache _use_result_cache;
 };
 
 }  // namespace opossum
@@ -9,8 +9,16 @@ namespace opossum {
 
 class AbstractOperator;
 class AbstractLQPNode;
+class CachedQueryResult;
+class ParameterizedPlan;
 
 using SQLPhysicalPlanCache = Cache<std::shared_ptr<AbstractOperator>, std::string>;
 using SQLLogicalPlanCache = Cache<std::shared_ptr<AbstractLQPNode>, std::string>;
 
+// Keyed by NormalizedSQLQuery::cache_key(), so that queries which only differ in their literals share a plan
+using SQLParameterizedPlanCache = Cache<std::shared_ptr<ParameterizedPlan>, std::string>;
+
+// Keyed by the normalized query and its parameter values, see SQLPipelineStatement
+using SQLQueryResultCache = Cache<std::shared_ptr<CachedQueryResult>, std::string>;
+
 }  // namespace opossum
@@ -0,0 +1,259 @@
+#include "sql_query_normalizer.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The token preceding a literal decides whether the literal is extracted
+enum class PrecedingToken { Other, Comparison, BetweenBound };
+
+bool is_identifier_start(const char character) {
+  return std::isalpha(static_cast<unsigned char>(character)) || character == '_';
+}
+
+bool is_identifier_character(const char character) {
+  return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+}
+
+bool is_digit(const char character) { return std::isdigit(static_cast<unsigned char>(character)); }
+
+// Returns the length of the comparison operator at the position or 0 if there is none
+size_t comparison_operator_length(const std::string& sql, const size_t position) {
+  for (const auto* const comparison_operator : {"<=", ">=", "<>", "!=", "=="}) {
+    if (sql.compare(position, 2, comparison_operator) == 0) return 2;
+  }
+  if (sql[position] == '=' || sql[position] == '<' || sql[position] == '>') return 1;
+  return 0;
+}
+
+// A literal that is followed by an arithmetic operator is not the entire operand of the comparison (e.g., in
+// `a < '1995-01-01' + INTERVAL '1' DAY`) and must stay in place
+bool ends_operand(const std::string& sql, size_t position) {
+  while (position < sql.size() && std::isspace(static_cast<unsigned char>(sql[position]))) ++position;
+  if (position == sql.size()) return true;
+
+  const auto character = sql[position];
+  return character != '+' && character != '-' && character != '*' && character != '/' && character != '%' &&
+         character != '|' && character != '.';
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::string NormalizedSQLQuery::cache_key() const {
+  auto key = sql;
+  key += '\n';
+  for (const auto& value : parameter_values) {
+    key += data_type_to_string.left.at(data_type_from_all_type_variant(value));
+    key += ',';
+  }
+  return key;
+}
+
+std::optional<NormalizedSQLQuery> normalize_sql_query(const std::string& sql) {
+  auto normalized_query = NormalizedSQLQuery{};
+  auto& normalized_sql = normalized_query.sql;
+  normalized_sql.reserve(sql.size());
+
+  auto is_first_word = true;
+  auto in_filter_clause = false;
+  // Set between BETWEEN and the AND separating its bounds
+  auto in_between = false;
+  auto preceding_token = PrecedingToken::Other;
+
+  // Whitespace and comments are collapsed into a single space, so that the formatting of a query does not matter
+  auto pending_whitespace = false;
+  const auto append = [&](const std::string& token) {
+    if (pending_whitespace && !normalized_sql.empty()) normalized_sql += ' ';
+    pending_whitespace = false;
+    normalized_sql += token;
+  };
+
+  const auto extract_literal = [&](const size_t literal_end) {
+    return in_filter_clause && preceding_token != PrecedingToken::Other && ends_operand(sql, literal_end);
+  };
+
+  auto position = size_t{0};
+  while (position < sql.size()) {
+    const auto character = sql[position];
+
+    if (std::isspace(static_cast<unsigned char>(character))) {
+      pending_whitespace = true;
+      ++position;
+      continue;
+    }
+
+    if (sql.compare(position, 2, "--") == 0) {
+      position = std::min(sql.find('\n', position), sql.size());
+      pending_whitespace = true;
+      continue;
+    }
+
+    if (sql.compare(position, 2, "/*") == 0) {
+      const auto comment_end = sql.find("*/", position + 2);
+      if (comment_end == std::string::npos) return std::nullopt;
+      position = comment_end + 2;
+      pending_whitespace = true;
+      continue;
+    }
+
+    if (character == '\'') {
+      // String literal, quotes within it are escaped by doubling them
+      auto value = pmr_string{};
+      auto literal_end = position + 1;
+      while (true) {
+        if (literal_end >= sql.size()) return std::nullopt;
+        if (sql[literal_end] == '\'') {
+          if (literal_end + 1 < sql.size() && sql[literal_end + 1] == '\'') {
+            value += '\'';
+            literal_end += 2;
+            continue;
+          }
+          break;
+        }
+        value += sql[literal_end];
+        ++literal_end;
+      }
+      ++literal_end;
+
+      if (extract_literal(literal_end)) {
+        append("?");
+        normalized_query.parameter_values.emplace_back(value);
+      } else {
+        append(sql.substr(position, literal_end - position));
+      }
+
+      preceding_token = PrecedingToken::Other;
+      position = literal_end;
+      continue;
+    }
+
+    if (character == '"' || character == '`') {
+      // Quoted identifier
+      const auto identifier_end = sql.find(character, position + 1);
+      if (identifier_end == std::string::npos) return std::nullopt;
+      append(sql.substr(position, identifier_end + 1 - position));
+
+      preceding_token = PrecedingToken::Other;
+      position = identifier_end + 1;
+      continue;
+    }
+
+    if (is_digit(character) || (character == '.' && position + 1 < sql.size() && is_digit(sql[position + 1]))) {
+      auto literal_end = position;
+      auto is_float = false;
+
+      while (literal_end < sql.size() && is_digit(sql[literal_end])) ++literal_end;
+      if (literal_end < sql.size() && sql[literal_end] == '.') {
+        is_float = true;
+        ++literal_end;
+        while (literal_end < sql.size() && is_digit(sql[literal_end])) ++literal_end;
+      }
+      if (literal_end < sql.size() && (sql[literal_end] == 'e' || sql[literal_end] == 'E')) {
+        auto exponent_end = literal_end + 1;
+        if (exponent_end < sql.size() && (sql[exponent_end] == '+' || sql[exponent_end] == '-')) ++exponent_end;
+        if (exponent_end < sql.size() && is_digit(sql[exponent_end])) {
+          is_float = true;
+          literal_end = exponent_end;
+          while (literal_end < sql.size() && is_digit(sql[literal_end])) ++literal_end;
+        }
+      }
+
+      // Something like `1abc` is not a number - leave it to the parser to complain about it
+      if (literal_end < sql.size() && is_identifier_character(sql[literal_end])) return std::nullopt;
+
+      const auto literal = sql.substr(position, literal_end - position);
+
+      if (extract_literal(literal_end)) {
+        if (is_float) {
+          normalized_query.parameter_values.emplace_back(std::strtod(literal.c_str(), nullptr));
+        } else {
+          // Integers that fit into 32 bits are translated to int32_t, all others to int64_t (see SQLTranslator)
+          errno = 0;
+          const auto value = std::strtoll(literal.c_str(), nullptr, 10);
+          if (errno == ERANGE) return std::nullopt;
+
+          if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+            normalized_query.parameter_values.emplace_back(static_cast<int32_t>(value));
+          } else {
+            normalized_query.parameter_values.emplace_back(static_cast<int64_t>(value));
+          }
+        }
+        append("?");
+      } else {
+        append(literal);
+      }
+
+      preceding_token = PrecedingToken::Other;
+      position = literal_end;
+      continue;
+    }
+
+    if (is_identifier_start(character)) {
+      auto word_end = position;
+      while (word_end < sql.size() && is_identifier_character(sql[word_end])) ++word_end;
+
+      const auto word = sql.substr(position, word_end - position);
+      const auto keyword = boost::to_upper_copy(word);
+
+      if (is_first_word) {
+        if (keyword != "SELECT") return std::nullopt;
+        is_first_word = false;
+      }
+
+      if (keyword == "WHERE" || keyword == "ON" || keyword == "HAVING") {
+        in_filter_clause = true;
+      } else if (keyword == "SELECT" || keyword == "FROM" || keyword == "GROUP" || keyword == "ORDER" ||
+                 keyword == "LIMIT" || keyword == "UNION" || keyword == "INTERSECT" || keyword == "EXCEPT") {
+        in_filter_clause = false;
+        in_between = false;
+      }
+
+      preceding_token = PrecedingToken::Other;
+      if (keyword == "BETWEEN") {
+        in_between = true;
+        preceding_token = PrecedingToken::BetweenBound;
+      } else if (keyword == "AND" && in_between) {
+        in_between = false;
+        preceding_token = PrecedingToken::BetweenBound;
+      }
+
+      append(word);
+      position = word_end;
+      continue;
+    }
+
+    // The query is a prepared statement or a syntax error, either way, we do not touch it
+    if (character == '?') return std::nullopt;
+
+    if (const auto operator_length = comparison_operator_length(sql, position)) {
+      append(sql.substr(position, operator_length));
+      preceding_token = PrecedingToken::Comparison;
+      position += operator_length;
+      continue;
+    }
+
+    append(std::string(1, character));
+    preceding_token = PrecedingToken::Other;
+    ++position;
+  }
+
+  if (normalized_query.parameter_values.empty()) return std::nullopt;
+
+  return normalized_query;
+}
+
+}  // namespace opossum
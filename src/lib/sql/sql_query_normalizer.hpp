@@ -0,0 +1,39 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+
+namespace opossum {
+
+struct NormalizedSQLQuery {
+  // The query with the extracted literals replaced by `?` and comments and redundant whitespace removed
+  std::string sql;
+
+  // The extracted literals in the order of their placeholders. Their types match those the SQLTranslator would use for
+  // the literals, i.e., int32_t/int64_t for integers, double for floats, and pmr_string for strings.
+  std::vector<AllTypeVariant> parameter_values;
+
+  // Queries that only differ in the values of their extracted literals share the same key. As the data types of the
+  // literals affect the translation, they are part of the key.
+  std::string cache_key() const;
+};
+
+/**
+ * Extracts the literals of a SELECT statement that can be replaced by parameters without changing the structure of
+ * its query plan, so that, e.g., `SELECT * FROM t WHERE id = 1` and `SELECT * FROM t WHERE id = 2` are normalized to
+ * the same query. Only literals that are the right operand of a comparison (=, <>, <, <=, >, >=) or the bounds of a
+ * BETWEEN within a WHERE, ON, or HAVING clause are extracted. Literals elsewhere (e.g., in the SELECT list, in LIMIT,
+ * or in IN lists) often determine the structure of the plan or cannot be replaced by parameters.
+ *
+ * This works on the SQL string rather than on the parsed statement so that normalizing is cheap compared to parsing
+ * and translating the query.
+ *
+ * Returns std::nullopt if the query is not a SELECT statement, contains no extractable literals, or already contains
+ * placeholders.
+ */
+std::optional<NormalizedSQLQuery> normalize_sql_query(const std::string& sql);
+
+}  // namespace opossum
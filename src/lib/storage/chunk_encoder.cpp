@@ -1,5 +1,7 @@
 #include "chunk_encoder.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -8,49 +10,125 @@
 #include "table.hpp"
 #include "types.hpp"
 
+#include "scheduler/job_task.hpp"
+#include "scheduler/ordered_job_window.hpp"
 #include "statistics/chunk_statistics/chunk_statistics.hpp"
 #include "statistics/chunk_statistics/segment_statistics.hpp"
 #include "storage/base_encoded_segment.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "utils/assert.hpp"
 
-namespace opossum {
+namespace {
 
-void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<DataType>& column_data_types,
+using namespace opossum;  // NOLINT
+
+// Encodes a single segment of the chunk (if requested) and returns the statistics of the resulting segment
+std::shared_ptr<SegmentStatistics> encode_segment_of_chunk(const std::shared_ptr<Chunk>& chunk,
+                                                           const ColumnID column_id, const DataType data_type,
+                                                           const SegmentEncodingSpec& spec) {
+  const auto base_segment = chunk->get_segment(column_id);
+  const auto value_segment = std::dynamic_pointer_cast<const BaseValueSegment>(base_segment);
+
+  Assert(value_segment != nullptr, "All segments of the chunk need to be of type ValueSegment<T>");
+
+  if (spec.encoding_type == EncodingType::Unencoded) {
+    // No need to encode, but we still want to have statistics for the now immutable value segment
+    return SegmentStatistics::build_statistics(data_type, value_segment);
+  }
+
+  auto encoded_segment = encode_segment(spec.encoding_type, data_type, value_segment, spec.vector_compression_type);
+  chunk->replace_segment(column_id, encoded_segment);
+  return SegmentStatistics::build_statistics(data_type, encoded_segment);
+}
+
+void verify_chunk_encoding_spec(const std::shared_ptr<Chunk>& chunk, const std::vector<DataType>& column_data_types,
                                 const ChunkEncodingSpec& chunk_encoding_spec) {
   Assert((column_data_types.size() == chunk->column_count()),
          "Number of column types must match the chunk’s column count.");
   Assert((chunk_encoding_spec.size() == chunk->column_count()),
          "Number of column encoding specs must match the chunk’s column count.");
+}
 
-  std::vector<std::shared_ptr<SegmentStatistics>> column_statistics;
-  for (ColumnID column_id{0}; column_id < chunk->column_count(); ++column_id) {
-    const auto spec = chunk_encoding_spec[column_id];
-
-    const auto data_type = column_data_types[column_id];
-    const auto base_segment = chunk->get_segment(column_id);
-    const auto value_segment = std::dynamic_pointer_cast<const BaseValueSegment>(base_segment);
-
-    Assert(value_segment != nullptr, "All segments of the chunk need to be of type ValueSegment<T>");
-
-    if (spec.encoding_type == EncodingType::Unencoded) {
-      // No need to encode, but we still want to have statistics for the now immutable value segment
-      column_statistics.push_back(SegmentStatistics::build_statistics(data_type, value_segment));
-    } else {
-      auto encoded_segment = encode_segment(spec.encoding_type, data_type, value_segment, spec.vector_compression_type);
-      chunk->replace_segment(column_id, encoded_segment);
-      column_statistics.push_back(SegmentStatistics::build_statistics(data_type, encoded_segment));
-    }
-  }
-
+// Called once all segments of the chunk are encoded
+void finish_chunk(const std::shared_ptr<Chunk>& chunk,
+                  const std::vector<std::shared_ptr<SegmentStatistics>>& segment_statistics) {
   chunk->mark_immutable();
-  chunk->set_statistics(std::make_shared<ChunkStatistics>(column_statistics));
+  chunk->set_statistics(std::make_shared<ChunkStatistics>(segment_statistics));
 
   if (chunk->has_mvcc_data()) {
     chunk->get_scoped_mvcc_data_lock()->shrink();
   }
 }
 
+/**
+ * Encodes the given chunks with one JobTask per segment. The statistics of a segment are built by the same task right
+ * after it is encoded. Chunks are finished in the order they are passed. To bound the memory that the encoders use
+ * for their intermediate data, only a few chunks per worker are encoded at the same time.
+ */
+void encode_chunks_in_parallel(const std::shared_ptr<Table>& table, const std::vector<ChunkID>& chunk_ids,
+                               const std::function<ChunkEncodingSpec(ChunkID)>& get_chunk_encoding_spec) {
+  const auto column_data_types = table->column_data_types();
+
+  struct PendingChunk {
+    std::shared_ptr<Chunk> chunk;
+    std::vector<std::shared_ptr<SegmentStatistics>> segment_statistics;
+  };
+  auto pending_chunks = OrderedJobWindow<PendingChunk>{
+      [](PendingChunk& pending_chunk) { finish_chunk(pending_chunk.chunk, pending_chunk.segment_statistics); }};
+
+  for (const auto chunk_id : chunk_ids) {
+    Assert(chunk_id < table->chunk_count(), "Chunk with given ID does not exist.");
+
+    const auto chunk = table->get_chunk(chunk_id);
+    const auto chunk_encoding_spec = get_chunk_encoding_spec(chunk_id);
+    verify_chunk_encoding_spec(chunk, column_data_types, chunk_encoding_spec);
+
+    pending_chunks.add(PendingChunk{chunk, {}}, [&](PendingChunk& pending_chunk) {
+      pending_chunk.segment_statistics.resize(chunk->column_count());
+
+      auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      jobs.reserve(chunk->column_count());
+      for (ColumnID column_id{0}; column_id < chunk->column_count(); ++column_id) {
+        auto& segment_statistics = pending_chunk.segment_statistics[column_id];
+        const auto data_type = column_data_types[column_id];
+        const auto spec = chunk_encoding_spec[column_id];
+
+        jobs.emplace_back(std::make_shared<JobTask>([chunk, column_id, data_type, spec, &segment_statistics]() {
+          segment_statistics = encode_segment_of_chunk(chunk, column_id, data_type, spec);
+        }));
+      }
+      return jobs;
+    });
+  }
+
+  pending_chunks.finish_all();
+}
+
+std::vector<ChunkID> all_chunk_ids(const Table& table) {
+  auto chunk_ids = std::vector<ChunkID>(table.chunk_count());
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    chunk_ids[chunk_id] = chunk_id;
+  }
+  return chunk_ids;
+}
+
+}  // namespace
+
+namespace opossum {
+
+void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<DataType>& column_data_types,
+                                const ChunkEncodingSpec& chunk_encoding_spec) {
+  verify_chunk_encoding_spec(chunk, column_data_types, chunk_encoding_spec);
+
+  std::vector<std::shared_ptr<SegmentStatistics>> column_statistics;
+  for (ColumnID column_id{0}; column_id < chunk->column_count(); ++column_id) {
+    column_statistics.push_back(
+        encode_segment_of_chunk(chunk, column_id, column_data_types[column_id], chunk_encoding_spec[column_id]));
+  }
+
+  finish_chunk(chunk, column_statistics);
+}
+
 void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<DataType>& column_data_types,
                                 const SegmentEncodingSpec& segment_encoding_spec) {
   const auto chunk_encoding_spec = ChunkEncodingSpec{chunk->column_count(), segment_encoding_spec};
@@ -59,65 +137,37 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::
 
 void ChunkEncoder::encode_chunks(const std::shared_ptr<Table>& table, const std::vector<ChunkID>& chunk_ids,
                                  const std::map<ChunkID, ChunkEncodingSpec>& chunk_encoding_specs) {
-  const auto column_data_types = table->column_data_types();
-
-  for (auto chunk_id : chunk_ids) {
-    Assert(chunk_id < table->chunk_count(), "Chunk with given ID does not exist.");
-
-    auto chunk = table->get_chunk(chunk_id);
-    const auto& chunk_encoding_spec = chunk_encoding_specs.at(chunk_id);
-
-    encode_chunk(chunk, column_data_types, chunk_encoding_spec);
-  }
+  encode_chunks_in_parallel(table, chunk_ids,
+                            [&](const ChunkID chunk_id) { return chunk_encoding_specs.at(chunk_id); });
 }
 
 void ChunkEncoder::encode_chunks(const std::shared_ptr<Table>& table, const std::vector<ChunkID>& chunk_ids,
                                  const SegmentEncodingSpec& segment_encoding_spec) {
-  const auto column_data_types = table->column_data_types();
-
-  for (auto chunk_id : chunk_ids) {
-    Assert(chunk_id < table->chunk_count(), "Chunk with given ID does not exist.");
-    auto chunk = table->get_chunk(chunk_id);
-
-    encode_chunk(chunk, column_data_types, segment_encoding_spec);
-  }
+  const auto chunk_encoding_spec = ChunkEncodingSpec{table->column_count(), segment_encoding_spec};
+  encode_chunks_in_parallel(table, chunk_ids, [&](const ChunkID) { return chunk_encoding_spec; });
 }
 
 void ChunkEncoder::encode_all_chunks(const std::shared_ptr<Table>& table,
                                      const std::vector<ChunkEncodingSpec>& chunk_encoding_specs) {
-  const auto column_types = table->column_data_types();
   const auto chunk_count = static_cast<size_t>(table->chunk_count());
   Assert(chunk_encoding_specs.size() == chunk_count, "Number of encoding specs must match table’s chunk count.");
 
-  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
-    auto chunk = table->get_chunk(chunk_id);
-    const auto chunk_encoding_spec = chunk_encoding_specs[chunk_id];
-
-    encode_chunk(chunk, column_types, chunk_encoding_spec);
-  }
+  encode_chunks_in_parallel(table, all_chunk_ids(*table),
+                            [&](const ChunkID chunk_id) { return chunk_encoding_specs[chunk_id]; });
 }
 
 void ChunkEncoder::encode_all_chunks(const std::shared_ptr<Table>& table,
                                      const ChunkEncodingSpec& chunk_encoding_spec) {
   Assert(chunk_encoding_spec.size() == table->column_count(),
          "Number of encoding specs must match table’s column count.");
-  const auto column_types = table->column_data_types();
 
-  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
-    auto chunk = table->get_chunk(chunk_id);
-    encode_chunk(chunk, column_types, chunk_encoding_spec);
-  }
+  encode_chunks_in_parallel(table, all_chunk_ids(*table), [&](const ChunkID) { return chunk_encoding_spec; });
 }
 
 void ChunkEncoder::encode_all_chunks(const std::shared_ptr<Table>& table,
                                      const SegmentEncodingSpec& segment_encoding_spec) {
-  const auto column_types = table->column_data_types();
-
-  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
-    auto chunk = table->get_chunk(chunk_id);
-
-    encode_chunk(chunk, column_types, segment_encoding_spec);
-  }
+  const auto chunk_encoding_spec = ChunkEncodingSpec{table->column_count(), segment_encoding_spec};
+  encode_chunks_in_parallel(table, all_chunk_ids(*table), [&](const ChunkID) { return chunk_encoding_spec; });
 }
 
 }  // namespace opossum
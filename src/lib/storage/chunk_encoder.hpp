@@ -34,6 +34,9 @@ using ChunkEncodingSpec = std::vector<SegmentEncodingSpec>;
  *
  * The methods provided are not thread-safe and might lead to race conditions
  * if there are other operations manipulating the chunks at the same time.
+ *
+ * encode_chunks() and encode_all_chunks() encode each segment in its own JobTask,
+ * which also builds the segment's statistics. Without a scheduler, they run sequentially.
  */
 class ChunkEncoder {
  public:
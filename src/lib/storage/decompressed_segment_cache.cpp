@@ -0,0 +1,196 @@
+#include "decompressed_segment_cache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <memory>
+
+#include "cache/gdfs_cache.hpp"
+
+namespace std {
+
+size_t hash<opossum::DecompressedBlockKey>::operator()(const opossum::DecompressedBlockKey& key) const {
+  auto hash = size_t{0};
+  boost::hash_combine(hash, key.segment_id);
+  boost::hash_combine(hash, key.block_index);
+  return hash;
+}
+
+}  // namespace std
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+size_t shard_count_for_capacity(const size_t capacity) {
+  return std::clamp(capacity / DecompressedSegmentCache::MIN_SHARD_CAPACITY, size_t{1},
+                    DecompressedSegmentCache::MAX_SHARD_COUNT);
+}
+
+// Distributes the capacity evenly across the shards
+size_t shard_capacity(const size_t capacity, const size_t shard_count, const size_t shard_id) {
+  return capacity / shard_count + (shard_id < capacity % shard_count ? 1 : 0);
+}
+
+// As every block is accounted with at least BLOCK_OVERHEAD bytes, a policy with this capacity never evicts on its own,
+// even when a block is inserted into a full shard
+size_t entry_capacity(const size_t shard_capacity) {
+  return shard_capacity / DecompressedSegmentCache::BLOCK_OVERHEAD + 1;
+}
+
+}  // namespace
+
+namespace opossum {
+
+DecompressedSegmentCache::DecompressedSegmentCache()
+    : _make_impl([](const size_t entry_capacity) {
+        return std::make_unique<GDFSCache<DecompressedBlockKey, Block>>(entry_capacity);
+      }) {
+  _create_shards(DEFAULT_CAPACITY);
+}
+
+uint64_t DecompressedSegmentCache::next_segment_id() {
+  static auto segment_id_counter = std::atomic<uint64_t>{0};
+  return segment_id_counter++;
+}
+
+bool DecompressedSegmentCache::is_enabled() const { return _capacity.load(std::memory_order_relaxed) > 0; }
+
+size_t DecompressedSegmentCache::capacity() const { return _capacity; }
+
+size_t DecompressedSegmentCache::size() const {
+  auto size = size_t{0};
+  for (const auto& shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size += shard.impl->size();
+  }
+  return size;
+}
+
+size_t DecompressedSegmentCache::size_in_bytes() const {
+  auto size_in_bytes = size_t{0};
+  for (const auto& shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_in_bytes += shard.size_in_bytes;
+  }
+  return size_in_bytes;
+}
+
+size_t DecompressedSegmentCache::shard_count() const { return _shard_count; }
+
+void DecompressedSegmentCache::resize(const size_t capacity) {
+  if (shard_count_for_capacity(capacity) != _shard_count) {
+    _create_shards(capacity);
+    return;
+  }
+
+  for (auto shard_id = size_t{0}; shard_id < _shard_count; ++shard_id) {
+    auto& shard = _shards[shard_id];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.capacity = shard_capacity(capacity, _shard_count, shard_id);
+    _evict(shard, shard.capacity);
+    shard.impl->resize(entry_capacity(shard.capacity));
+  }
+  _capacity = capacity;
+}
+
+void DecompressedSegmentCache::clear() {
+  for (auto& shard : _shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.impl->clear();
+    shard.block_sizes.clear();
+    shard.size_in_bytes = 0;
+  }
+}
+
+DecompressedSegmentCache::Metrics DecompressedSegmentCache::metrics() const {
+  return Metrics{_hits.load(), _misses.load(), _evictions.load()};
+}
+
+void DecompressedSegmentCache::reset_metrics() {
+  _hits = 0;
+  _misses = 0;
+  _evictions = 0;
+}
+
+DecompressedSegmentCache::Block DecompressedSegmentCache::_try_get(const DecompressedBlockKey& key) {
+  auto& shard = _shard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (!shard.impl->has(key)) {
+    ++_misses;
+    return nullptr;
+  }
+
+  ++_hits;
+  return shard.impl->get(key);
+}
+
+void DecompressedSegmentCache::_set(const DecompressedBlockKey& key, const Block& block, const double cost) {
+  const auto block_size = block->size() + BLOCK_OVERHEAD;
+
+  auto& shard = _shard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  // Blocks that were inserted by a concurrent miss are kept. Blocks that do not fit (e.g., because the cache is
+  // disabled) are not cached.
+  if (shard.impl->has(key) || block_size > shard.capacity) return;
+
+  shard.impl->set(key, block, cost, static_cast<double>(block_size));
+  shard.block_sizes.emplace(key, block_size);
+  shard.size_in_bytes += block_size;
+
+  // Evicting below the capacity avoids an eviction for every following miss
+  if (shard.size_in_bytes > shard.capacity) {
+    _evict(shard, static_cast<size_t>(static_cast<double>(shard.capacity) * EVICTION_THRESHOLD));
+  }
+}
+
+void DecompressedSegmentCache::_evict(Shard& shard, const size_t size_in_bytes) {
+  // The policies evict by entry count. Thus, their capacity is lowered temporarily so that they choose the blocks to
+  // evict. The number of blocks to evict is estimated from the average block size.
+  const auto entry_capacity = shard.impl->capacity();
+  while (shard.size_in_bytes > size_in_bytes) {
+    const auto entry_count = shard.impl->size();
+    const auto average_block_size = shard.size_in_bytes / entry_count;
+    const auto excess = shard.size_in_bytes - size_in_bytes;
+    const auto eviction_count = std::min((excess + average_block_size - 1) / average_block_size, entry_count);
+
+    shard.impl->resize(entry_count - eviction_count);
+    shard.impl->resize(entry_capacity);
+
+    for (auto iter = shard.block_sizes.begin(); iter != shard.block_sizes.end();) {
+      if (shard.impl->has(iter->first)) {
+        ++iter;
+        continue;
+      }
+
+      shard.size_in_bytes -= iter->second;
+      iter = shard.block_sizes.erase(iter);
+      ++_evictions;
+    }
+  }
+}
+
+void DecompressedSegmentCache::_create_shards(const size_t capacity) {
+  const auto shard_count = shard_count_for_capacity(capacity);
+
+  // Unused shards have a capacity of zero, so that blocks inserted by readers that still use the previous shard count
+  // are not cached
+  for (auto shard_id = size_t{0}; shard_id < MAX_SHARD_COUNT; ++shard_id) {
+    auto& shard = _shards[shard_id];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.capacity = shard_id < shard_count ? shard_capacity(capacity, shard_count, shard_id) : 0;
+    shard.impl = _make_impl(entry_capacity(shard.capacity));
+    shard.block_sizes.clear();
+    shard.size_in_bytes = 0;
+  }
+
+  _shard_count = shard_count;
+  _capacity = capacity;
+}
+
+DecompressedSegmentCache::Shard& DecompressedSegmentCache::_shard(const DecompressedBlockKey& key) {
+  return _shards[std::hash<DecompressedBlockKey>{}(key) % _shard_count.load(std::memory_order_relaxed)];
+}
+
+}  // namespace opossum
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cache/abstract_cache_impl.hpp"
+#include "types.hpp"
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+// Identifies a block of an encoded segment. Segment ids are handed out by DecompressedSegmentCache::next_segment_id.
+struct DecompressedBlockKey {
+  uint64_t segment_id;
+  size_t block_index;
+
+  bool operator==(const DecompressedBlockKey& other) const {
+    return segment_id == other.segment_id && block_index == other.block_index;
+  }
+};
+
+}  // namespace opossum
+
+namespace std {
+
+template <>
+struct hash<opossum::DecompressedBlockKey> {
+  size_t operator()(const opossum::DecompressedBlockKey& key) const;
+};
+
+}  // namespace std
+
+namespace opossum {
+
+/**
+ * Global cache of decompressed blocks of heavyweight encoded segments (currently LZ4). Decompressing a block again
+ * for every access is expensive, so hot blocks that are read by many point accesses are kept in their decompressed
+ * form. Reading an entire segment does not go through the cache, as it would evict the hot blocks for blocks that are
+ * read only once.
+ *
+ * The capacity is given in bytes. Each block is accounted with its decompressed size plus BLOCK_OVERHEAD. Per
+ * default, the GDFS policy is used with the time it took to decompress a block as its cost and its accounted size as
+ * its size. A capacity of zero disables the cache.
+ *
+ * Like Cache, the blocks are distributed across shards by the hash of their keys, so that concurrent readers do not
+ * contend for a single mutex. Each shard has its own policy and an equal share of the capacity. When a shard exceeds
+ * its capacity, its policy evicts blocks until the shard is filled to EVICTION_THRESHOLD of its capacity.
+ *
+ * Cached blocks are handed out as shared pointers, so evicting a block does not invalidate it for current readers.
+ * get_or_decompress(), is_enabled(), size(), size_in_bytes(), clear(), and resize() are thread-safe.
+ * replace_cache_impl() must not be called concurrently to resize() or itself.
+ */
+class DecompressedSegmentCache : public Singleton<DecompressedSegmentCache> {
+ public:
+  using Block = std::shared_ptr<const std::vector<char>>;
+
+  static constexpr auto DEFAULT_CAPACITY = size_t{64 * 1024 * 1024};
+
+  // Approximates the memory used by the shared pointer, the vector, and the bookkeeping of a cached block
+  static constexpr auto BLOCK_OVERHEAD = size_t{64};
+
+  // Each shard holds at least this many bytes. Caches with a smaller capacity have a single shard.
+  static constexpr auto MIN_SHARD_CAPACITY = size_t{1024 * 1024};
+  static constexpr auto MAX_SHARD_COUNT = size_t{16};
+
+  static constexpr auto EVICTION_THRESHOLD = 0.875;
+
+  struct Metrics {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+  };
+
+  // Returns a new id for a segment whose blocks are to be cached. Ids are never reused, so entries of a deleted
+  // segment cannot be confused with those of a new one.
+  static uint64_t next_segment_id();
+
+  /**
+   * Returns the block from the cache. On a miss, the block is decompressed by calling
+   * `decompress(std::vector<char>& block)` and inserted. The decompression does not hold the shard's lock, so
+   * concurrent misses on the same block might decompress it more than once.
+   */
+  template <typename Decompress>
+  Block get_or_decompress(const DecompressedBlockKey& key, const Decompress& decompress) {
+    if (const auto block = _try_get(key)) {
+      return block;
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    auto decompressed_block = std::make_shared<std::vector<char>>();
+    decompress(*decompressed_block);
+    const auto decompression_time = std::chrono::steady_clock::now() - begin;
+
+    // Nanoseconds are a fine enough unit for the cost. Zero costs are avoided.
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(decompression_time).count();
+    const auto cost = static_cast<double>(nanoseconds) + 1.0;
+
+    auto block = Block{std::move(decompressed_block)};
+    _set(key, block, cost);
+    return block;
+  }
+
+  // Returns false if the capacity is zero. In that case, callers can skip the indirection. Does not lock.
+  bool is_enabled() const;
+
+  // Capacity in bytes
+  size_t capacity() const;
+
+  // Number of cached blocks
+  size_t size() const;
+
+  // Accounted size of the cached blocks, which does not exceed the capacity
+  size_t size_in_bytes() const;
+
+  size_t shard_count() const;
+
+  // Changes the capacity (in bytes). If the number of shards changes, the cached blocks are dropped.
+  void resize(const size_t capacity);
+  void clear();
+
+  // Replaces the underlying cache policy (e.g., with LRUKCache). The cached blocks are dropped.
+  template <class CacheImpl>
+  void replace_cache_impl(const size_t capacity) {
+    _make_impl = [](const size_t entry_capacity) { return std::make_unique<CacheImpl>(entry_capacity); };
+    _create_shards(capacity);
+  }
+
+  Metrics metrics() const;
+  void reset_metrics();
+
+ protected:
+  friend class Singleton;
+
+  struct Shard {
+    std::unique_ptr<AbstractCacheImpl<DecompressedBlockKey, Block>> impl;
+
+    // The policies do not expose the sizes of their entries, so they are tracked here
+    std::unordered_map<DecompressedBlockKey, size_t> block_sizes;
+    size_t size_in_bytes{0};
+    size_t capacity{0};
+
+    mutable std::mutex mutex;
+  };
+
+  DecompressedSegmentCache();
+
+  Block _try_get(const DecompressedBlockKey& key);
+  void _set(const DecompressedBlockKey& key, const Block& block, const double cost);
+
+  // Evicts blocks from the shard until its size does not exceed the given size. Requires the shard's lock.
+  void _evict(Shard& shard, const size_t size_in_bytes);
+
+  void _create_shards(const size_t capacity);
+
+  Shard& _shard(const DecompressedBlockKey& key);
+
+  std::array<Shard, MAX_SHARD_COUNT> _shards;
+  std::atomic<size_t> _shard_count{1};
+  std::atomic<size_t> _capacity{0};
+
+  // Creates the policy of a shard with the given capacity in entries
+  std::function<std::unique_ptr<AbstractCacheImpl<DecompressedBlockKey, Block>>(size_t)> _make_impl;
+
+  std::atomic<size_t> _hits{0};
+  std::atomic<size_t> _misses{0};
+  std::atomic<size_t> _evictions{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,199 @@
+#include "encoding_advisor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/base_segment_encoder.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/timer.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The sample is taken in this many contiguous blocks
+constexpr auto SAMPLE_BLOCK_COUNT = size_t{10};
+
+// The scan of a sample is repeated and the fastest run is used, which makes the measurement less noisy
+constexpr auto SCAN_REPETITIONS = size_t{3};
+
+constexpr auto VECTOR_COMPRESSION_TYPES =
+    std::array<VectorCompressionType, 2>{VectorCompressionType::FixedSizeByteAligned, VectorCompressionType::SimdBp128};
+
+template <typename T>
+std::shared_ptr<const ValueSegment<T>> create_sample(const std::shared_ptr<const BaseValueSegment>& base_segment,
+                                                     const size_t sample_size) {
+  const auto& segment = static_cast<const ValueSegment<T>&>(*base_segment);
+  const auto segment_size = segment.size();
+  if (segment_size <= sample_size) {
+    return std::static_pointer_cast<const ValueSegment<T>>(base_segment);
+  }
+
+  const auto block_size = std::max(sample_size / SAMPLE_BLOCK_COUNT, size_t{1});
+  const auto block_count = sample_size / block_size;
+  const auto block_stride = segment_size / block_count;
+
+  auto values = std::vector<T>{};
+  auto null_values = std::vector<bool>{};
+  values.reserve(block_count * block_size);
+  null_values.reserve(segment.is_nullable() ? block_count * block_size : 0);
+
+  for (auto block_index = size_t{0}; block_index < block_count; ++block_index) {
+    const auto block_begin = block_index * block_stride;
+    for (auto offset = block_begin; offset < block_begin + block_size; ++offset) {
+      values.push_back(segment.values()[offset]);
+      if (segment.is_nullable()) null_values.push_back(segment.null_values()[offset]);
+    }
+  }
+
+  if (segment.is_nullable()) {
+    return std::make_shared<ValueSegment<T>>(std::move(values), std::move(null_values));
+  }
+  return std::make_shared<ValueSegment<T>>(std::move(values));
+}
+
+// Iterates over the segment the way a table scan with an equals predicate would. The sequential iteration decompresses
+// LZ4 segments as a whole, which bypasses the DecompressedSegmentCache. Thus, every repetition pays for the
+// decompression and the blocks of the sample do not displace cached blocks of the stored tables.
+template <typename T>
+std::chrono::nanoseconds measure_scan_time(const BaseSegment& segment, const T& search_value) {
+  auto fastest_scan_time = std::chrono::nanoseconds::max();
+  for (auto repetition = size_t{0}; repetition < SCAN_REPETITIONS; ++repetition) {
+    auto match_count = size_t{0};
+
+    auto timer = Timer{};
+    segment_iterate<T>(segment, [&](const auto& position) {
+      match_count += !position.is_null() && position.value() == search_value;
+    });
+    const auto scan_time = timer.lap();
+
+    // Prevents the compiler from dropping the scan
+    Assert(match_count <= segment.size(), "Scan found more matches than rows");
+
+    fastest_scan_time = std::min(fastest_scan_time, scan_time);
+  }
+
+  return fastest_scan_time;
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::ostream& operator<<(std::ostream& stream, const EncodingEstimate& estimate) {
+  stream << encoding_type_to_string.left.at(estimate.spec.encoding_type);
+  if (estimate.spec.vector_compression_type) {
+    stream << " (" << vector_compression_type_to_string.left.at(*estimate.spec.vector_compression_type) << ")";
+  }
+  stream << ": " << estimate.memory_usage << " bytes, " << estimate.scan_time.count() << " ns scan";
+  return stream;
+}
+
+EncodingAdvisor::EncodingAdvisor(const float memory_weight, const size_t sample_size)
+    : _memory_weight{memory_weight}, _sample_size{sample_size} {
+  Assert(_memory_weight >= 0.0f && _memory_weight <= 1.0f, "Memory weight must be between 0 and 1");
+  Assert(_sample_size >= SAMPLE_BLOCK_COUNT, "Sample is too small");
+}
+
+SegmentEncodingDecision EncodingAdvisor::advise_segment(const std::shared_ptr<const BaseValueSegment>& segment) const {
+  const auto data_type = segment->data_type();
+  auto decision = SegmentEncodingDecision{};
+
+  resolve_data_type(data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto sample = create_sample<ColumnDataType>(segment, _sample_size);
+    if (sample->size() == 0) {
+      decision.chosen = EncodingEstimate{SegmentEncodingSpec{EncodingType::Unencoded}, 0, std::chrono::nanoseconds{0}};
+      decision.candidates = {decision.chosen};
+      return;
+    }
+
+    const auto search_value = sample->values()[0];
+    const auto extrapolation_factor = static_cast<double>(segment->size()) / static_cast<double>(sample->size());
+
+    const auto add_candidate = [&](const SegmentEncodingSpec& spec, const BaseSegment& encoded_sample) {
+      const auto memory_usage = static_cast<double>(encoded_sample.estimate_memory_usage()) * extrapolation_factor;
+      const auto scan_time =
+          static_cast<double>(measure_scan_time(encoded_sample, search_value).count()) * extrapolation_factor;
+      decision.candidates.push_back(EncodingEstimate{spec, static_cast<size_t>(memory_usage),
+                                                     std::chrono::nanoseconds{static_cast<int64_t>(scan_time)}});
+    };
+
+    add_candidate(SegmentEncodingSpec{EncodingType::Unencoded}, *sample);
+
+    for (const auto encoding_type : encoding_type_enum_values) {
+      if (encoding_type == EncodingType::Unencoded || !encoding_supports_data_type(encoding_type, data_type)) continue;
+
+      if (!create_encoder(encoding_type)->uses_vector_compression()) {
+        add_candidate(SegmentEncodingSpec{encoding_type}, *encode_segment(encoding_type, data_type, sample));
+        continue;
+      }
+
+      for (const auto vector_compression_type : VECTOR_COMPRESSION_TYPES) {
+        add_candidate(SegmentEncodingSpec{encoding_type, vector_compression_type},
+                      *encode_segment(encoding_type, data_type, sample, vector_compression_type));
+      }
+    }
+  });
+
+  if (decision.candidates.size() == 1) return decision;
+
+  // Zero values are avoided, so that the relative comparison is well-defined
+  auto min_memory_usage = std::numeric_limits<double>::max();
+  auto min_scan_time = std::numeric_limits<double>::max();
+  for (const auto& candidate : decision.candidates) {
+    min_memory_usage = std::min(min_memory_usage, std::max(static_cast<double>(candidate.memory_usage), 1.0));
+    min_scan_time = std::min(min_scan_time, std::max(static_cast<double>(candidate.scan_time.count()), 1.0));
+  }
+
+  auto best_score = std::numeric_limits<double>::max();
+  for (const auto& candidate : decision.candidates) {
+    const auto relative_memory_usage = std::max(static_cast<double>(candidate.memory_usage), 1.0) / min_memory_usage;
+    const auto relative_scan_time = std::max(static_cast<double>(candidate.scan_time.count()), 1.0) / min_scan_time;
+    const auto score = _memory_weight * relative_memory_usage + (1.0 - _memory_weight) * relative_scan_time;
+
+    if (score < best_score) {
+      best_score = score;
+      decision.chosen = candidate;
+    }
+  }
+
+  return decision;
+}
+
+std::vector<SegmentEncodingDecision> EncodingAdvisor::advise_chunk(const Chunk& chunk) const {
+  auto decisions = std::vector<SegmentEncodingDecision>{};
+  decisions.reserve(chunk.column_count());
+
+  for (ColumnID column_id{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto value_segment = std::dynamic_pointer_cast<const BaseValueSegment>(chunk.get_segment(column_id));
+    Assert(value_segment, "All segments of the chunk need to be of type ValueSegment<T>");
+
+    decisions.push_back(advise_segment(value_segment));
+  }
+
+  return decisions;
+}
+
+ChunkEncodingSpec EncodingAdvisor::to_chunk_encoding_spec(const std::vector<SegmentEncodingDecision>& decisions) {
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  chunk_encoding_spec.reserve(decisions.size());
+  for (const auto& decision : decisions) {
+    chunk_encoding_spec.push_back(decision.chosen.spec);
+  }
+  return chunk_encoding_spec;
+}
+
+}  // namespace opossum
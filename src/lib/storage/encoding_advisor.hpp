@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "storage/chunk_encoder.hpp"
+
+namespace opossum {
+
+class BaseValueSegment;
+class Chunk;
+
+// Size and scan time of a segment if it were encoded using the given spec. Both are extrapolated from a sample.
+struct EncodingEstimate {
+  SegmentEncodingSpec spec;
+  size_t memory_usage;
+  std::chrono::nanoseconds scan_time;
+};
+
+std::ostream& operator<<(std::ostream& stream, const EncodingEstimate& estimate);
+
+struct SegmentEncodingDecision {
+  EncodingEstimate chosen;
+
+  // All encodings that were considered, including the chosen one
+  std::vector<EncodingEstimate> candidates;
+};
+
+/**
+ * Chooses the encoding for immutable value segments based on their data. A sample of the segment is encoded using
+ * every encoding type (and every VectorCompressionType, if the encoding uses vector compression) that supports the
+ * segment's data type. Leaving the segment unencoded is considered as well. For each candidate, the memory usage and
+ * the time to iterate over the sample are measured and extrapolated to the size of the segment.
+ *
+ * The sample consists of a few contiguous blocks spread across the segment, so that runs and value ranges, which
+ * RunLength and FrameOfReference benefit from, are preserved.
+ *
+ * The candidates are compared relative to the smallest and the fastest candidate, respectively:
+ *   score = memory_weight * memory_usage / min_memory_usage + (1 - memory_weight) * scan_time / min_scan_time
+ * The candidate with the lowest score is chosen. Thus, a memory_weight of 1 picks the smallest encoding, a
+ * memory_weight of 0 the fastest one.
+ */
+class EncodingAdvisor {
+ public:
+  static constexpr auto DEFAULT_SAMPLE_SIZE = size_t{10'000};
+
+  explicit EncodingAdvisor(const float memory_weight = 0.5f, const size_t sample_size = DEFAULT_SAMPLE_SIZE);
+
+  SegmentEncodingDecision advise_segment(const std::shared_ptr<const BaseValueSegment>& segment) const;
+
+  // Returns one decision per segment of the chunk. All segments need to be value segments.
+  std::vector<SegmentEncodingDecision> advise_chunk(const Chunk& chunk) const;
+
+  // Turns the decisions for a chunk into a spec that can be passed to the ChunkEncoder
+  static ChunkEncodingSpec to_chunk_encoding_spec(const std::vector<SegmentEncodingDecision>& decisions);
+
+ private:
+  const float _memory_weight;
+  const size_t _sample_size;
+};
+
+}  // namespace opossum
@@ -0,0 +1,150 @@
+#include "table_hash_index.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_iterate.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TableHashIndex::TableHashIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& column_data_types)
+    : _column_ids{column_ids}, _column_data_types{column_data_types} {
+  Assert(!_column_ids.empty(), "Index needs at least one column");
+  Assert(_column_ids.size() == _column_data_types.size(), "Need a data type for each indexed column");
+}
+
+const std::vector<ColumnID>& TableHashIndex::column_ids() const { return _column_ids; }
+
+PosList TableHashIndex::lookup(const Key& key) const {
+  Assert(key.size() == _column_ids.size(), "Key does not match the indexed columns");
+
+  // Cast the values to the column types, as e.g., an int64_t value is not equal to the same int32_t value
+  auto typed_key = Key{};
+  typed_key.reserve(key.size());
+  for (auto column_index = size_t{0}; column_index < key.size(); ++column_index) {
+    if (variant_is_null(key[column_index])) return {};
+
+    resolve_data_type(_column_data_types[column_index], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      typed_key.emplace_back(type_cast_variant<ColumnDataType>(key[column_index]));
+    });
+  }
+
+  const auto hash = KeyHash{}(typed_key);
+  const auto& shard = _shard(hash);
+
+  auto matches = PosList{};
+
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  const auto [range_begin, range_end] = shard.entries.equal_range(typed_key);
+  for (auto entry_it = range_begin; entry_it != range_end; ++entry_it) {
+    matches.emplace_back(entry_it->second);
+  }
+
+  return matches;
+}
+
+void TableHashIndex::insert(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+                            const ChunkOffset end_offset) {
+  const auto keys = _keys(chunk, begin_offset, end_offset);
+
+  for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset) {
+    const auto& key = keys[chunk_offset - begin_offset];
+    if (!key) continue;
+
+    auto& shard = _shard(KeyHash{}(*key));
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.entries.emplace(*key, RowID{chunk_id, chunk_offset});
+  }
+}
+
+void TableHashIndex::erase(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+                           const ChunkOffset end_offset) {
+  const auto keys = _keys(chunk, begin_offset, end_offset);
+
+  for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset) {
+    const auto& key = keys[chunk_offset - begin_offset];
+    if (!key) continue;
+
+    auto& shard = _shard(KeyHash{}(*key));
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    const auto [range_begin, range_end] = shard.entries.equal_range(*key);
+    for (auto entry_it = range_begin; entry_it != range_end; ++entry_it) {
+      if (entry_it->second == RowID{chunk_id, chunk_offset}) {
+        shard.entries.erase(entry_it);
+        break;
+      }
+    }
+  }
+}
+
+size_t TableHashIndex::size() const {
+  auto size = size_t{0};
+  for (const auto& shard : _shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    size += shard.entries.size();
+  }
+  return size;
+}
+
+size_t TableHashIndex::estimate_memory_usage() const {
+  auto memory_usage = sizeof(*this);
+  for (const auto& shard : _shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    // Each entry is a node holding the key's vector, the key's values, and the RowID
+    memory_usage += shard.entries.bucket_count() * sizeof(void*);
+    memory_usage += shard.entries.size() *
+                    (sizeof(std::pair<const Key, RowID>) + sizeof(void*) + _column_ids.size() * sizeof(AllTypeVariant));
+  }
+  return memory_usage;
+}
+
+size_t TableHashIndex::KeyHash::operator()(const Key& key) const {
+  auto hash = size_t{0};
+  for (const auto& value : key) {
+    boost::hash_combine(hash, std::hash<AllTypeVariant>{}(value));
+  }
+  return hash;
+}
+
+std::vector<std::optional<TableHashIndex::Key>> TableHashIndex::_keys(const Chunk& chunk,
+                                                                      const ChunkOffset begin_offset,
+                                                                      const ChunkOffset end_offset) const {
+  DebugAssert(begin_offset <= end_offset && end_offset <= chunk.size(), "Invalid row range");
+
+  const auto row_count = static_cast<size_t>(end_offset - begin_offset);
+  auto keys = std::vector<std::optional<Key>>(row_count, Key{});
+
+  for (const auto column_id : _column_ids) {
+    segment_with_iterators(*chunk.get_segment(column_id), [&](auto it, const auto /* end */) {
+      it += begin_offset;
+      for (auto row = size_t{0}; row < row_count; ++row, ++it) {
+        auto& key = keys[row];
+        if (!key) continue;
+
+        const auto position = *it;
+        if (position.is_null()) {
+          key.reset();
+        } else {
+          key->emplace_back(position.value());
+        }
+      }
+    });
+  }
+
+  return keys;
+}
+
+TableHashIndex::Shard& TableHashIndex::_shard(const size_t hash) { return _shards[hash % SHARD_COUNT]; }
+
+const TableHashIndex::Shard& TableHashIndex::_shard(const size_t hash) const { return _shards[hash % SHARD_COUNT]; }
+
+}  // namespace opossum
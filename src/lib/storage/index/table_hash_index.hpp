@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "storage/pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+/**
+ * Table-wide hash index that maps the values of one or more columns to the RowIDs of the rows holding them. In
+ * contrast to the chunk indexes (see BaseIndex), a point lookup does not need to probe the index of every chunk but
+ * directly yields the matching rows. It is meant for primary keys and other highly selective equality predicates.
+ *
+ * The index is not aware of transactions: It contains every row version that has been inserted, including
+ * uncommitted and invalidated ones. Lookups therefore return candidates whose visibility needs to be checked, e.g.,
+ * by the Validate operator. Rows are indexed when they are added to the table (Insert, Table::append,
+ * Table::append_chunk). Delete leaves the entries untouched, as the old row versions remain visible to older
+ * transactions. Rolled back inserts are removed, as they never become visible. Update is a Delete followed by an
+ * Insert and thus indexes the new row versions.
+ *
+ * Rows with a NULL in any of the indexed columns are not indexed, as they never satisfy an equality predicate.
+ *
+ * The entries are distributed across shards, each protected by its own shared_mutex, so that concurrent inserts and
+ * lookups rarely contend.
+ */
+class TableHashIndex : private Noncopyable {
+ public:
+  using Key = std::vector<AllTypeVariant>;
+
+  TableHashIndex(const std::vector<ColumnID>& column_ids, const std::vector<DataType>& column_data_types);
+
+  const std::vector<ColumnID>& column_ids() const;
+
+  // Returns the RowIDs of all rows whose indexed columns equal the key. The key's values are cast to the data types
+  // of the indexed columns.
+  PosList lookup(const Key& key) const;
+
+  // Adds or removes the rows [begin_offset, end_offset) of the chunk with the given id
+  void insert(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset, const ChunkOffset end_offset);
+  void erase(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset, const ChunkOffset end_offset);
+
+  // Number of indexed rows
+  size_t size() const;
+
+  size_t estimate_memory_usage() const;
+
+ protected:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_multimap<Key, RowID, KeyHash> entries;
+  };
+
+  static constexpr auto SHARD_COUNT = size_t{64};
+
+  // Returns the keys of the rows [begin_offset, end_offset). Rows with NULLs have no key.
+  std::vector<std::optional<Key>> _keys(const Chunk& chunk, const ChunkOffset begin_offset,
+                                        const ChunkOffset end_offset) const;
+
+  Shard& _shard(const size_t hash);
+  const Shard& _shard(const size_t hash) const;
+
+  const std::vector<ColumnID> _column_ids;
+  const std::vector<DataType> _column_data_types;
+  std::array<Shard, SHARD_COUNT> _shards;
+};
+
+}  // namespace opossum
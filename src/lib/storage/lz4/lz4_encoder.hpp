@@ -48,31 +48,16 @@ class LZ4Encoder : public SegmentEncoder<LZ4Encoder> {
       }
     });
 
-    /**
-     * Use the LZ4 high compression API to compress the copied values. As C-library LZ4 needs raw pointers as input
-     * and output. To avoid directly handling raw pointers we use std::vectors as input and output. The input vector
-     * contains the data that needs to be compressed and the output vector is allocated enough memory to contain
-     * the compression result. Via the .data() call we can supply LZ4 with raw pointers to the memory the vectors use.
-     * These are cast to char-pointers since LZ4 expects char pointers.
-     */
     DebugAssert(values.size() * sizeof(T) <= std::numeric_limits<int>::max(),
                 "Input of LZ4 encoder contains too many bytes to fit into a 32-bit signed integer sized vector that is"
                 " used by the LZ4 library.");
 
     const auto input_size = values.size() * sizeof(T);
-    // estimate the (maximum) output size
-    const auto output_size = LZ4_compressBound(static_cast<int>(input_size));
-    auto compressed_data = pmr_vector<char>{alloc};
-    compressed_data.resize(static_cast<size_t>(output_size));
-    const int compression_result = LZ4_compress_HC(reinterpret_cast<char*>(values.data()), compressed_data.data(),
-                                                   static_cast<int>(input_size), output_size, LZ4HC_CLEVEL_MAX);
-    Assert(compression_result > 0, "LZ4 compression failed");
-
-    // shrink the vector to the actual size of the compressed result
-    compressed_data.resize(static_cast<size_t>(compression_result));
-    compressed_data.shrink_to_fit();
-
-    return std::allocate_shared<LZ4Segment<T>>(alloc, std::move(compressed_data), std::move(null_values), input_size);
+    auto compressed_blocks = _compress(reinterpret_cast<const char*>(values.data()), input_size, alloc);
+
+    return std::allocate_shared<LZ4Segment<T>>(alloc, std::move(compressed_blocks.blocks), std::move(null_values),
+                                               std::move(compressed_blocks.dictionary), _block_size,
+                                               compressed_blocks.last_block_size, compressed_blocks.compressed_size);
   }
 
   std::shared_ptr<BaseEncodedSegment> _on_encode(const std::shared_ptr<const ValueSegment<pmr_string>>& value_segment) {
@@ -135,35 +120,109 @@ class LZ4Encoder : public SegmentEncoder<LZ4Encoder> {
      * cause an error). Therefore we can return the encoded segment already.
      */
     if (!num_chars) {
-      return std::allocate_shared<LZ4Segment<pmr_string>>(alloc, pmr_vector<char>{alloc}, std::move(null_values),
-                                                          std::move(offsets), 0u);
+      return std::allocate_shared<LZ4Segment<pmr_string>>(alloc, pmr_vector<pmr_vector<char>>{alloc},
+                                                          std::move(null_values), pmr_vector<char>{alloc},
+                                                          std::move(offsets), _block_size, 0u, 0u);
     }
 
-    /**
-     * Use the LZ4 high compression API to compress the copied values. As C-library LZ4 needs raw pointers as input
-     * and output. To avoid directly handling raw pointers we use std::vectors as input and output. The input vector
-     * contains the data that needs to be compressed and the output vector is allocated enough memory to contain
-     * the compression result. Via the .data() call we can supply LZ4 with raw pointers to the memory the vectors use.
-     * These are cast to char-pointers since LZ4 expects char pointers.
-     */
     DebugAssert(values.size() <= std::numeric_limits<int>::max(),
                 "String input of LZ4 encoder contains too many characters to fit into a 32-bit signed integer sized "
                 "vector that is used by the LZ4 library.");
-    const auto input_size = values.size();
-    // estimate the (maximum) output size
-    const auto output_size = LZ4_compressBound(static_cast<int>(input_size));
-    auto compressed_data = pmr_vector<char>{alloc};
-    compressed_data.resize(static_cast<size_t>(output_size));
-    const int compression_result = LZ4_compress_HC(values.data(), compressed_data.data(), static_cast<int>(input_size),
-                                                   output_size, LZ4HC_CLEVEL_MAX);
-    Assert(compression_result > 0, "LZ4 compression failed");
-
-    // shrink the vector to the actual size of the compressed result
-    compressed_data.resize(static_cast<size_t>(compression_result));
-    compressed_data.shrink_to_fit();
-
-    return std::allocate_shared<LZ4Segment<pmr_string>>(alloc, std::move(compressed_data), std::move(null_values),
-                                                        std::move(offsets), input_size);
+
+    auto compressed_blocks = _compress(values.data(), values.size(), alloc);
+
+    return std::allocate_shared<LZ4Segment<pmr_string>>(
+        alloc, std::move(compressed_blocks.blocks), std::move(null_values), std::move(compressed_blocks.dictionary),
+        std::move(offsets), _block_size, compressed_blocks.last_block_size, compressed_blocks.compressed_size);
+  }
+
+ private:
+  // Decompressed size of the blocks. Values of all supported fixed-size types evenly divide it.
+  static constexpr auto _block_size = size_t{16'384};
+
+  // The dictionary is made up of samples of this size and takes up at most 1/_dictionary_size_ratio of the input
+  static constexpr auto _dictionary_sample_size = size_t{64};
+  static constexpr auto _dictionary_size_ratio = size_t{16};
+
+  struct CompressedBlocks {
+    pmr_vector<pmr_vector<char>> blocks;
+    pmr_vector<char> dictionary;
+    size_t last_block_size;
+    size_t compressed_size;
+  };
+
+  /**
+   * Builds the dictionary for data that spans multiple blocks. LZ4 dictionaries are plain data that the compressed
+   * blocks may refer back to, so samples spread evenly over the input are used. This gives each block some of the
+   * context it would have had if the data had been compressed as a whole.
+   */
+  static pmr_vector<char> _build_dictionary(const char* data, const size_t input_size,
+                                            const PolymorphicAllocator<char>& alloc) {
+    auto dictionary = pmr_vector<char>{alloc};
+    if (input_size <= _block_size) return dictionary;
+
+    const auto sample_count = std::min(_block_size, input_size / _dictionary_size_ratio) / _dictionary_sample_size;
+    if (sample_count == 0) return dictionary;
+
+    const auto sample_stride = input_size / sample_count;
+    dictionary.reserve(sample_count * _dictionary_sample_size);
+    for (auto sample_index = size_t{0}; sample_index < sample_count; ++sample_index) {
+      const auto* const sample_begin = data + sample_index * sample_stride;
+      dictionary.insert(dictionary.cend(), sample_begin, sample_begin + _dictionary_sample_size);
+    }
+
+    return dictionary;
+  }
+
+  /**
+   * Splits the input into blocks of _block_size bytes and compresses each of them independently using the LZ4 high
+   * compression API. As C-library LZ4 needs raw pointers as input and output, the output vectors are allocated with
+   * enough memory to contain the compression result and shrunk afterwards.
+   */
+  static CompressedBlocks _compress(const char* data, const size_t input_size,
+                                    const PolymorphicAllocator<char>& alloc) {
+    auto compressed_blocks = CompressedBlocks{pmr_vector<pmr_vector<char>>{alloc},
+                                              _build_dictionary(data, input_size, alloc), 0u, 0u};
+    if (input_size == 0) return compressed_blocks;
+
+    const auto block_count = (input_size + _block_size - 1) / _block_size;
+    compressed_blocks.blocks.reserve(block_count);
+
+    auto stream = std::unique_ptr<LZ4_streamHC_t, decltype(&LZ4_freeStreamHC)>{LZ4_createStreamHC(), &LZ4_freeStreamHC};
+    Assert(stream, "Could not create LZ4 stream");
+
+    const auto& dictionary = compressed_blocks.dictionary;
+    for (auto block_index = size_t{0}; block_index < block_count; ++block_index) {
+      const auto* const block_data = data + block_index * _block_size;
+      const auto decompressed_block_size = std::min(_block_size, input_size - block_index * _block_size);
+
+      const auto output_size = LZ4_compressBound(static_cast<int>(decompressed_block_size));
+      auto compressed_block = pmr_vector<char>{alloc};
+      compressed_block.resize(static_cast<size_t>(output_size));
+
+      auto compression_result = int{0};
+      if (dictionary.empty()) {
+        compression_result = LZ4_compress_HC(block_data, compressed_block.data(),
+                                             static_cast<int>(decompressed_block_size), output_size, LZ4HC_CLEVEL_MAX);
+      } else {
+        // Each block starts from a freshly loaded dictionary so that it can be decompressed on its own
+        LZ4_resetStreamHC(stream.get(), LZ4HC_CLEVEL_MAX);
+        LZ4_loadDictHC(stream.get(), dictionary.data(), static_cast<int>(dictionary.size()));
+        compression_result = LZ4_compress_HC_continue(stream.get(), block_data, compressed_block.data(),
+                                                      static_cast<int>(decompressed_block_size), output_size);
+      }
+      Assert(compression_result > 0, "LZ4 compression failed");
+
+      // shrink the vector to the actual size of the compressed result
+      compressed_block.resize(static_cast<size_t>(compression_result));
+      compressed_block.shrink_to_fit();
+
+      compressed_blocks.compressed_size += compressed_block.size();
+      compressed_blocks.last_block_size = decompressed_block_size;
+      compressed_blocks.blocks.emplace_back(std::move(compressed_block));
+    }
+
+    return compressed_blocks;
   }
 };
 
@@ -2,7 +2,14 @@
 
 #include <lz4.h>
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include "resolve_type.hpp"
+#include "storage/decompressed_segment_cache.hpp"
 #include "storage/vector_compression/base_compressed_vector.hpp"
 #include "utils/assert.hpp"
 #include "utils/performance_warning.hpp"
@@ -10,22 +17,35 @@
 namespace opossum {
 
 template <typename T>
-LZ4Segment<T>::LZ4Segment(pmr_vector<char>&& compressed_data, pmr_vector<bool>&& null_values,
-                          pmr_vector<size_t>&& offsets, const size_t decompressed_size)
+LZ4Segment<T>::LZ4Segment(pmr_vector<pmr_vector<char>>&& lz4_blocks, pmr_vector<bool>&& null_values,
+                          pmr_vector<char>&& dictionary, pmr_vector<size_t>&& offsets, const size_t block_size,
+                          const size_t last_block_size, const size_t compressed_size)
     : BaseEncodedSegment{data_type_from_type<T>()},
-      _compressed_data{std::move(compressed_data)},
+      _lz4_blocks{std::move(lz4_blocks)},
       _null_values{std::move(null_values)},
+      _dictionary{std::move(dictionary)},
       _offsets{std::move(offsets)},
-      _decompressed_size{decompressed_size} {}
+      _block_size{block_size},
+      _last_block_size{last_block_size},
+      _compressed_size{compressed_size},
+      _cache_id{DecompressedSegmentCache::next_segment_id()} {}
 
 template <typename T>
-LZ4Segment<T>::LZ4Segment(pmr_vector<char>&& compressed_data, pmr_vector<bool>&& null_values,
-                          const size_t decompressed_size)
+LZ4Segment<T>::LZ4Segment(pmr_vector<pmr_vector<char>>&& lz4_blocks, pmr_vector<bool>&& null_values,
+                          pmr_vector<char>&& dictionary, const size_t block_size, const size_t last_block_size,
+                          const size_t compressed_size)
     : BaseEncodedSegment{data_type_from_type<T>()},
-      _compressed_data{std::move(compressed_data)},
+      _lz4_blocks{std::move(lz4_blocks)},
       _null_values{std::move(null_values)},
+      _dictionary{std::move(dictionary)},
       _offsets{std::nullopt},
-      _decompressed_size{decompressed_size} {}
+      _block_size{block_size},
+      _last_block_size{last_block_size},
+      _compressed_size{compressed_size},
+      _cache_id{DecompressedSegmentCache::next_segment_id()} {
+  // Values must not span multiple blocks so that a single block has to be decompressed for a point access
+  Assert(_block_size % sizeof(T) == 0, "Block size must be a multiple of the data type's size");
+}
 
 template <typename T>
 const AllTypeVariant LZ4Segment<T>::operator[](const ChunkOffset chunk_offset) const {
@@ -41,15 +61,13 @@ const AllTypeVariant LZ4Segment<T>::operator[](const ChunkOffset chunk_offset) c
 
 template <typename T>
 const std::optional<T> LZ4Segment<T>::get_typed_value(const ChunkOffset chunk_offset) const {
-  PerformanceWarning("LZ4::get_typed_value: decompressing the whole LZ4 segment");
-  auto decompressed_segment = decompress();
-
   const auto is_null = _null_values[chunk_offset];
   if (is_null) {
     return std::nullopt;
   }
 
-  return decompressed_segment[chunk_offset];
+  auto decompressed_block = std::shared_ptr<const std::vector<char>>{};
+  return decompress(chunk_offset, std::nullopt, decompressed_block).first;
 }
 
 template <typename T>
@@ -62,19 +80,98 @@ const std::optional<const pmr_vector<size_t>> LZ4Segment<T>::offsets() const {
   return _offsets;
 }
 
+template <typename T>
+const pmr_vector<char>& LZ4Segment<T>::dictionary() const {
+  return _dictionary;
+}
+
+template <typename T>
+const pmr_vector<pmr_vector<char>>& LZ4Segment<T>::lz4_blocks() const {
+  return _lz4_blocks;
+}
+
+template <typename T>
+size_t LZ4Segment<T>::block_size() const {
+  return _block_size;
+}
+
+template <typename T>
+size_t LZ4Segment<T>::last_block_size() const {
+  return _last_block_size;
+}
+
+template <typename T>
+size_t LZ4Segment<T>::compressed_size() const {
+  return _compressed_size;
+}
+
 template <typename T>
 size_t LZ4Segment<T>::size() const {
   return _null_values.size();
 }
 
+template <typename T>
+size_t LZ4Segment<T>::_decompressed_size() const {
+  if (_lz4_blocks.empty()) return 0u;
+  return (_lz4_blocks.size() - 1) * _block_size + _last_block_size;
+}
+
+template <typename T>
+size_t LZ4Segment<T>::_decompressed_block_size(const size_t block_index) const {
+  return block_index + 1 == _lz4_blocks.size() ? _last_block_size : _block_size;
+}
+
+template <typename T>
+void LZ4Segment<T>::_decompress_block(const size_t block_index, char* destination) const {
+  DebugAssert(block_index < _lz4_blocks.size(), "Block index out of range");
+
+  const auto& compressed_block = _lz4_blocks[block_index];
+  const auto decompressed_block_size = _decompressed_block_size(block_index);
+
+  auto decompressed_result = int{0};
+  if (_dictionary.empty()) {
+    decompressed_result = LZ4_decompress_safe(compressed_block.data(), destination,
+                                              static_cast<int>(compressed_block.size()),
+                                              static_cast<int>(decompressed_block_size));
+  } else {
+    decompressed_result = LZ4_decompress_safe_usingDict(
+        compressed_block.data(), destination, static_cast<int>(compressed_block.size()),
+        static_cast<int>(decompressed_block_size), _dictionary.data(), static_cast<int>(_dictionary.size()));
+  }
+  Assert(decompressed_result > 0 && static_cast<size_t>(decompressed_result) == decompressed_block_size,
+         "LZ4 decompression failed");
+}
+
+template <typename T>
+std::shared_ptr<const std::vector<char>> LZ4Segment<T>::_get_block(const size_t block_index) const {
+  const auto decompress_block = [&](std::vector<char>& block) {
+    block.resize(_decompressed_block_size(block_index));
+    _decompress_block(block_index, block.data());
+  };
+
+  auto& cache = DecompressedSegmentCache::get();
+  if (!cache.is_enabled()) {
+    auto block = std::make_shared<std::vector<char>>();
+    decompress_block(*block);
+    return block;
+  }
+
+  return cache.get_or_decompress(DecompressedBlockKey{_cache_id, block_index}, decompress_block);
+}
+
+template <typename T>
+void LZ4Segment<T>::_decompress_blocks(char* destination) const {
+  // The blocks are decompressed directly into the destination. Going through the DecompressedSegmentCache would
+  // require a copy and evict the blocks of point accesses for blocks that are likely read only once.
+  for (auto block_index = size_t{0}; block_index < _lz4_blocks.size(); ++block_index) {
+    _decompress_block(block_index, destination + block_index * _block_size);
+  }
+}
+
 template <typename T>
 std::vector<T> LZ4Segment<T>::decompress() const {
-  auto decompressed_data = std::vector<T>(_decompressed_size / sizeof(T));
-  auto compressed_size = static_cast<int>(_compressed_data.size());
-  const int decompressed_result =
-      LZ4_decompress_safe(_compressed_data.data(), reinterpret_cast<char*>(decompressed_data.data()), compressed_size,
-                          static_cast<int>(_decompressed_size));
-  Assert(decompressed_result > 0, "LZ4 decompression failed");
+  auto decompressed_data = std::vector<T>(_decompressed_size() / sizeof(T));
+  _decompress_blocks(reinterpret_cast<char*>(decompressed_data.data()));
 
   return decompressed_data;
 }
@@ -85,15 +182,13 @@ std::vector<pmr_string> LZ4Segment<pmr_string>::decompress() const {
    * If the input segment only contained empty strings the original size is 0. That can't be decompressed and instead
    * we can just return as many empty strings as the input contained.
    */
-  if (!_decompressed_size) {
+  const auto decompressed_size = _decompressed_size();
+  if (!decompressed_size) {
     return std::vector<pmr_string>(_null_values.size());
   }
 
-  auto decompressed_data = std::vector<char>(_decompressed_size);
-  auto compressed_size = static_cast<int>(_compressed_data.size());
-  const int decompressed_result = LZ4_decompress_safe(_compressed_data.data(), decompressed_data.data(),
-                                                      compressed_size, static_cast<int>(_decompressed_size));
-  Assert(decompressed_result > 0, "LZ4 decompression failed");
+  auto decompressed_data = std::vector<char>(decompressed_size);
+  _decompress_blocks(decompressed_data.data());
 
   /**
    * Decode the previously encoded string data. These strings are all appended and separated along the stored offsets.
@@ -103,11 +198,12 @@ std::vector<pmr_string> LZ4Segment<pmr_string>::decompress() const {
    * indicated by the end of the data vector.
    */
   auto decompressed_strings = std::vector<pmr_string>();
+  decompressed_strings.reserve(_offsets->size());
   for (auto it = _offsets->cbegin(); it != _offsets->cend(); ++it) {
     auto start_char_offset = *it;
     size_t end_char_offset;
     if (it + 1 == _offsets->cend()) {
-      end_char_offset = _decompressed_size;
+      end_char_offset = decompressed_size;
     } else {
       end_char_offset = *(it + 1);
     }
@@ -120,18 +216,87 @@ std::vector<pmr_string> LZ4Segment<pmr_string>::decompress() const {
   return decompressed_strings;
 }
 
+template <typename T>
+std::pair<T, std::optional<size_t>> LZ4Segment<T>::decompress(
+    const ChunkOffset chunk_offset, const std::optional<size_t> cached_block_index,
+    std::shared_ptr<const std::vector<char>>& cached_block) const {
+  const auto memory_offset = static_cast<size_t>(chunk_offset) * sizeof(T);
+  const auto block_index = memory_offset / _block_size;
+
+  if (!cached_block_index || *cached_block_index != block_index) {
+    cached_block = _get_block(block_index);
+  }
+
+  // The block is not necessarily aligned for T
+  auto value = T{};
+  std::memcpy(&value, cached_block->data() + memory_offset % _block_size, sizeof(T));
+  return {value, block_index};
+}
+
+template <>
+std::pair<pmr_string, std::optional<size_t>> LZ4Segment<pmr_string>::decompress(
+    const ChunkOffset chunk_offset, const std::optional<size_t> cached_block_index,
+    std::shared_ptr<const std::vector<char>>& cached_block) const {
+  const auto start_char_offset = (*_offsets)[chunk_offset];
+  const auto end_char_offset =
+      static_cast<size_t>(chunk_offset) + 1 < _offsets->size() ? (*_offsets)[chunk_offset + 1] : _decompressed_size();
+
+  // Empty strings (and NULLs) do not occupy any characters and can be returned without touching the blocks
+  if (start_char_offset == end_char_offset) {
+    return {pmr_string{}, cached_block_index};
+  }
+
+  const auto start_block_index = start_char_offset / _block_size;
+  const auto end_block_index = (end_char_offset - 1) / _block_size;
+
+  if (start_block_index == end_block_index) {
+    if (!cached_block_index || *cached_block_index != start_block_index) {
+      cached_block = _get_block(start_block_index);
+    }
+
+    const auto string_begin = cached_block->cbegin() + static_cast<std::ptrdiff_t>(start_char_offset % _block_size);
+    return {pmr_string{string_begin, string_begin + static_cast<std::ptrdiff_t>(end_char_offset - start_char_offset)},
+            start_block_index};
+  }
+
+  // The string spans multiple blocks, which are fetched one after another. The last one is handed back.
+  auto value = pmr_string{};
+  value.reserve(end_char_offset - start_char_offset);
+  for (auto block_index = start_block_index; block_index <= end_block_index; ++block_index) {
+    if (!cached_block_index || *cached_block_index != block_index || block_index != start_block_index) {
+      cached_block = _get_block(block_index);
+    }
+
+    const auto block_begin = block_index * _block_size;
+    const auto copy_begin = std::max(start_char_offset, block_begin) - block_begin;
+    const auto copy_end = std::min(end_char_offset, block_begin + _block_size) - block_begin;
+    value.append(cached_block->data() + copy_begin, copy_end - copy_begin);
+  }
+
+  return {value, end_block_index};
+}
+
 template <typename T>
 std::shared_ptr<BaseSegment> LZ4Segment<T>::copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const {
-  auto new_compressed_data = pmr_vector<char>{_compressed_data, alloc};
+  auto new_lz4_blocks = pmr_vector<pmr_vector<char>>{alloc};
+  new_lz4_blocks.reserve(_lz4_blocks.size());
+  for (const auto& block : _lz4_blocks) {
+    // The polymorphic allocator passes itself on to the inner vectors
+    new_lz4_blocks.emplace_back(block);
+  }
+
   auto new_null_values = pmr_vector<bool>{_null_values, alloc};
+  auto new_dictionary = pmr_vector<char>{_dictionary, alloc};
 
   if (_offsets.has_value()) {
     auto new_offsets = pmr_vector<size_t>(*_offsets, alloc);
-    return std::allocate_shared<LZ4Segment>(alloc, std::move(new_compressed_data), std::move(new_null_values),
-                                            std::move(new_offsets), _decompressed_size);
+    return std::allocate_shared<LZ4Segment>(alloc, std::move(new_lz4_blocks), std::move(new_null_values),
+                                            std::move(new_dictionary), std::move(new_offsets), _block_size,
+                                            _last_block_size, _compressed_size);
   } else {
-    return std::allocate_shared<LZ4Segment>(alloc, std::move(new_compressed_data), std::move(new_null_values),
-                                            _decompressed_size);
+    return std::allocate_shared<LZ4Segment>(alloc, std::move(new_lz4_blocks), std::move(new_null_values),
+                                            std::move(new_dictionary), _block_size, _last_block_size,
+                                            _compressed_size);
   }
 }
 
@@ -140,7 +305,8 @@ size_t LZ4Segment<T>::estimate_memory_usage() const {
   auto bool_size = _null_values.size() * sizeof(bool);
   // _offsets is used only for strings
   auto offset_size = (_offsets.has_value() ? _offsets->size() * sizeof(size_t) : 0u);
-  return sizeof(*this) + _compressed_data.size() + bool_size + offset_size;
+  auto block_vector_size = _lz4_blocks.size() * sizeof(pmr_vector<char>);
+  return sizeof(*this) + _compressed_size + block_vector_size + _dictionary.size() + bool_size + offset_size;
 }
 
 template <typename T>
@@ -8,6 +8,9 @@
 
 #include <array>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "base_encoded_segment.hpp"
 #include "storage/vector_compression/base_compressed_vector.hpp"
@@ -17,6 +20,14 @@ namespace opossum {
 
 class BaseCompressedVector;
 
+/**
+ * @brief Segment implementing LZ4 compression
+ *
+ * The values are serialized into a byte stream (strings are concatenated without separators) that is split into
+ * blocks of block_size bytes. Each block is compressed independently, so that accessing single values only
+ * decompresses the block(s) that contain them. As small blocks lose a lot of the context LZ4 can refer back to, the
+ * blocks of a segment can be compressed against a shared dictionary (a sample of the segment's own data).
+ */
 template <typename T>
 class LZ4Segment : public BaseEncodedSegment {
  public:
@@ -24,25 +35,34 @@ class LZ4Segment : public BaseEncodedSegment {
    * This is a container for an LZ4 compressed segment. It contains the compressed data, the necessary
    * metadata and the ability to decompress the data again.
    *
-   * @param compressed_data The char vector that contains the LZ4 compressed segment data as binary blob.
+   * @param lz4_blocks The independently LZ4 compressed blocks of the segment's byte stream.
    * @param null_values Boolean vector that contains the information which row is null and which is not null.
+   * @param dictionary The dictionary that all blocks were compressed with. It is empty if no dictionary was used.
    * @param offsets If this segment is not a pmr_string segment this will be a std::nullopt (see the other constructor).
    *                Otherwise it contains the offsets for the compressed strings. The offset at position 0 is the
    *                character index of the string at index 0. Its (exclusive) end is at the offset at position 1. The
-   *                last string ends at the end of the compressed data (since there is offset after it that specifies
+   *                last string ends at the end of the decompressed data (since there is offset after it that specifies
    *                the end offset). Since these offsets are used the stored strings are not null-terminated
    *                (and may contain null bytes).
-   * @param compressed_size The size of the compressed data vector (the return value of LZ4)
-   * @param decompressed_size The size in bytes of the decompressed data vector.
+   * @param block_size The decompressed size in bytes of every block but the last one.
+   * @param last_block_size The decompressed size in bytes of the last block.
+   * @param compressed_size The sum of the sizes of the compressed blocks.
    */
-  explicit LZ4Segment(pmr_vector<char>&& compressed_data, pmr_vector<bool>&& null_values, pmr_vector<size_t>&& offsets,
-                      const size_t decompressed_size);
+  explicit LZ4Segment(pmr_vector<pmr_vector<char>>&& lz4_blocks, pmr_vector<bool>&& null_values,
+                      pmr_vector<char>&& dictionary, pmr_vector<size_t>&& offsets, const size_t block_size,
+                      const size_t last_block_size, const size_t compressed_size);
 
-  explicit LZ4Segment(pmr_vector<char>&& compressed_data, pmr_vector<bool>&& null_values,
-                      const size_t decompressed_size);
+  explicit LZ4Segment(pmr_vector<pmr_vector<char>>&& lz4_blocks, pmr_vector<bool>&& null_values,
+                      pmr_vector<char>&& dictionary, const size_t block_size, const size_t last_block_size,
+                      const size_t compressed_size);
 
   const pmr_vector<bool>& null_values() const;
   const std::optional<const pmr_vector<size_t>> offsets() const;
+  const pmr_vector<char>& dictionary() const;
+  const pmr_vector<pmr_vector<char>>& lz4_blocks() const;
+  size_t block_size() const;
+  size_t last_block_size() const;
+  size_t compressed_size() const;
 
   /**
    * @defgroup BaseSegment interface
@@ -55,8 +75,23 @@ class LZ4Segment : public BaseEncodedSegment {
 
   size_t size() const final;
 
+  /**
+   * Decompresses the whole segment.
+   */
   std::vector<T> decompress() const;
 
+  /**
+   * Decompresses the value at the given chunk offset, touching only the block(s) that contain it. The caller passes
+   * the block returned by a previous call and that block's index. If the value lies in that block, no decompression is
+   * necessary. Otherwise, the block is replaced. The index of the block that is held after the call (if any) is
+   * returned along with the value. NULL values are not considered, i.e., their placeholder value is returned.
+   *
+   * Blocks are obtained through the DecompressedSegmentCache, so blocks that other readers decompressed are reused.
+   */
+  std::pair<T, std::optional<size_t>> decompress(const ChunkOffset chunk_offset,
+                                                 const std::optional<size_t> cached_block_index,
+                                                 std::shared_ptr<const std::vector<char>>& cached_block) const;
+
   std::shared_ptr<BaseSegment> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
 
   size_t estimate_memory_usage() const final;
@@ -74,10 +109,30 @@ class LZ4Segment : public BaseEncodedSegment {
   /**@}*/
 
  private:
-  const pmr_vector<char> _compressed_data;
+  // Decompresses the block into the given memory, which needs to be large enough to hold the decompressed block
+  void _decompress_block(const size_t block_index, char* destination) const;
+
+  // Returns the decompressed block from the DecompressedSegmentCache or decompresses it
+  std::shared_ptr<const std::vector<char>> _get_block(const size_t block_index) const;
+
+  size_t _decompressed_block_size(const size_t block_index) const;
+
+  // Writes all blocks one after another into the given memory
+  void _decompress_blocks(char* destination) const;
+
+  // Size of the byte stream that was split into blocks
+  size_t _decompressed_size() const;
+
+  const pmr_vector<pmr_vector<char>> _lz4_blocks;
   const pmr_vector<bool> _null_values;
+  const pmr_vector<char> _dictionary;
   const std::optional<const pmr_vector<size_t>> _offsets;
-  const size_t _decompressed_size;
+  const size_t _block_size;
+  const size_t _last_block_size;
+  const size_t _compressed_size;
+
+  // Identifies the segment's blocks in the DecompressedSegmentCache
+  const uint64_t _cache_id;
 };
 
 }  // namespace opossum
@@ -94,6 +94,12 @@ void Table::append(const std::vector<AllTypeVariant>& values) {
   }
 
   _chunks.back()->append(values);
+
+  const auto chunk_id = static_cast<ChunkID>(_chunks.size() - 1);
+  const auto chunk_offset = static_cast<ChunkOffset>(_chunks.back()->size() - 1);
+  for (const auto& hash_index : _hash_indexes) {
+    hash_index->insert(chunk_id, *_chunks.back(), chunk_offset, chunk_offset + 1);
+  }
 }
 
 void Table::append_mutable_chunk() {
@@ -109,7 +115,8 @@ void Table::append_mutable_chunk() {
 
 uint64_t Table::row_count() const {
   uint64_t ret = 0;
-  for (const auto& chunk : _chunks) {
+  for (const auto& chunk_ptr : _chunks) {
+    const auto chunk = std::atomic_load(&chunk_ptr);
     if (chunk) ret += chunk->size();
   }
   return ret;
@@ -125,23 +132,28 @@ uint32_t Table::max_chunk_size() const { return _max_chunk_size; }
 
 std::shared_ptr<Chunk> Table::get_chunk(ChunkID chunk_id) {
   DebugAssert(chunk_id < _chunks.size(), "ChunkID " + std::to_string(chunk_id) + " out of range");
-  return _chunks[chunk_id];
+  // Chunks may be removed concurrently (see remove_chunk)
+  return std::atomic_load(&_chunks[chunk_id]);
 }
 
 std::shared_ptr<const Chunk> Table::get_chunk(ChunkID chunk_id) const {
   DebugAssert(chunk_id < _chunks.size(), "ChunkID " + std::to_string(chunk_id) + " out of range");
-  return _chunks[chunk_id];
+  return std::atomic_load(&_chunks[chunk_id]);
 }
 
 void Table::remove_chunk(ChunkID chunk_id) {
   DebugAssert(chunk_id < _chunks.size(), "ChunkID " + std::to_string(chunk_id) + " out of range");
-  DebugAssert(_chunks[chunk_id]->invalid_row_count() == _chunks[chunk_id]->size(),
+  const auto chunk = std::atomic_load(&_chunks[chunk_id]);
+  DebugAssert(chunk && chunk->invalid_row_count() == chunk->size(),
               "Physical delete of chunk prevented: Chunk needs to be fully invalidated before.");
+  for (const auto& hash_index : _hash_indexes) {
+    hash_index->erase(chunk_id, *chunk, 0, chunk->size());
+  }
   if (_table_statistics) {
-    auto invalidated_rows_count = _chunks[chunk_id]->size();
+    auto invalidated_rows_count = chunk->size();
     _table_statistics->decrease_invalid_row_count(invalidated_rows_count);
   }
-  _chunks[chunk_id] = nullptr;
+  std::atomic_store(&_chunks[chunk_id], std::shared_ptr<Chunk>{});
 }
 
 void Table::append_chunk(const Segments& segments, const std::optional<PolymorphicAllocator<Chunk>>& alloc) {
@@ -168,7 +180,7 @@ void Table::append_chunk(const Segments& segments, const std::optional<Polymorph
     mvcc_data = std::make_shared<MvccData>(chunk_size);
   }
 
-  _chunks.push_back(std::make_shared<Chunk>(segments, mvcc_data, alloc));
+  append_chunk(std::make_shared<Chunk>(segments, mvcc_data, alloc));
 }
 
 void Table::append_chunk(const std::shared_ptr<Chunk>& chunk) {
@@ -189,24 +201,72 @@ void Table::append_chunk(const std::shared_ptr<Chunk>& chunk) {
   DebugAssert(chunk->has_mvcc_data() == (_use_mvcc == UseMvcc::Yes),
               "Chunk does not have the same MVCC setting as the table.");
 
-  _chunks.push_back(chunk);
+  const auto chunk_it = _chunks.push_back(chunk);
+
+  if (!_hash_indexes.empty() && chunk->size() > 0) {
+    const auto chunk_id = static_cast<ChunkID>(std::distance(_chunks.begin(), chunk_it));
+    for (const auto& hash_index : _hash_indexes) {
+      hash_index->insert(chunk_id, *chunk, 0, chunk->size());
+    }
+  }
 }
 
 std::unique_lock<std::mutex> Table::acquire_append_mutex() { return std::unique_lock<std::mutex>(*_append_mutex); }
 
+CommitID Table::last_commit_id() const { return _last_commit_id.load(); }
+
+void Table::update_last_commit_id(const CommitID commit_id) const {
+  auto last_commit_id = _last_commit_id.load();
+  while (last_commit_id < commit_id && !_last_commit_id.compare_exchange_weak(last_commit_id, commit_id)) {
+  }
+}
+
 std::vector<IndexInfo> Table::get_indexes() const { return _indexes; }
 
+std::shared_ptr<TableHashIndex> Table::create_hash_index(const std::vector<ColumnID>& column_ids) {
+  Assert(_type == TableType::Data, "Hash indexes can only be created on data tables");
+  Assert(!get_hash_index(column_ids), "Hash index on these columns already exists");
+
+  auto column_data_types = std::vector<DataType>{};
+  for (const auto column_id : column_ids) {
+    column_data_types.emplace_back(column_data_type(column_id));
+  }
+
+  auto hash_index = std::make_shared<TableHashIndex>(column_ids, column_data_types);
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count(); ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (chunk) hash_index->insert(chunk_id, *chunk, 0, chunk->size());
+  }
+
+  _hash_indexes.emplace_back(hash_index);
+  return hash_index;
+}
+
+std::shared_ptr<TableHashIndex> Table::get_hash_index(const std::vector<ColumnID>& column_ids) const {
+  for (const auto& hash_index : _hash_indexes) {
+    if (hash_index->column_ids() == column_ids) return hash_index;
+  }
+  return nullptr;
+}
+
+const std::vector<std::shared_ptr<TableHashIndex>>& Table::hash_indexes() const { return _hash_indexes; }
+
 size_t Table::estimate_memory_usage() const {
   auto bytes = size_t{sizeof(*this)};
 
-  for (const auto& chunk : _chunks) {
-    bytes += chunk->estimate_memory_usage();
+  for (const auto& chunk_ptr : _chunks) {
+    const auto chunk = std::atomic_load(&chunk_ptr);
+    if (chunk) bytes += chunk->estimate_memory_usage();
   }
 
   for (const auto& column_definition : _column_definitions) {
     bytes += column_definition.name.size();
   }
 
+  for (const auto& hash_index : _hash_indexes) {
+    bytes += hash_index->estimate_memory_usage();
+  }
+
   // TODO(anybody) Statistics and Indices missing from Memory Usage Estimation
   // TODO(anybody) TableLayout missing
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -9,6 +10,7 @@
 #include "base_segment.hpp"
 #include "chunk.hpp"
 #include "storage/index/index_info.hpp"
+#include "storage/index/table_hash_index.hpp"
 #include "storage/table_column_definition.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -86,7 +88,7 @@ class Table : private Noncopyable {
   std::shared_ptr<const Chunk> get_chunk(ChunkID chunk_id) const;
 
   /*
-   * Removes the chunk with the given id.
+   * Removes the chunk with the given id. Its entry is set to nullptr, which may happen concurrently to get_chunk().
    * Makes sure that the the chunk was fully invalidated by the logical delete before deleting it physically.
   */
   void remove_chunk(ChunkID chunk_id);
@@ -131,7 +133,9 @@ class Table : private Noncopyable {
     Assert(column_id < column_count(), "column_id invalid");
 
     size_t row_counter = 0u;
-    for (auto& chunk : _chunks) {
+    for (const auto& chunk_ptr : _chunks) {
+      const auto chunk = std::atomic_load(&chunk_ptr);
+      if (!chunk) continue;
       size_t current_size = chunk->size();
       row_counter += current_size;
       if (row_counter > row_number) {
@@ -150,19 +154,41 @@ class Table : private Noncopyable {
 
   std::shared_ptr<TableStatistics> table_statistics() const { return _table_statistics; }
 
+  /**
+   * The ID of the latest commit that inserted or deleted rows of this table, or 0 if there was none. Used to detect
+   * outdated query results (see CachedQueryResult). Modifications that bypass the MVCC (e.g., append()) are not
+   * tracked.
+   */
+  CommitID last_commit_id() const;
+
+  // Called when a transaction that modified this table commits. Never decreases the last commit ID.
+  void update_last_commit_id(const CommitID commit_id) const;
+
   std::vector<IndexInfo> get_indexes() const;
 
   template <typename Index>
   void create_index(const std::vector<ColumnID>& column_ids, const std::string& name = "") {
     SegmentIndexType index_type = get_index_type_of<Index>();
 
-    for (auto& chunk : _chunks) {
-      chunk->create_index<Index>(column_ids);
+    for (const auto& chunk_ptr : _chunks) {
+      const auto chunk = std::atomic_load(&chunk_ptr);
+      if (chunk) chunk->create_index<Index>(column_ids);
     }
     IndexInfo i = {column_ids, name, index_type};
     _indexes.emplace_back(i);
   }
 
+  /**
+   * Creates a table-wide hash index on the given columns and adds all existing rows to it. See TableHashIndex for how
+   * the index is maintained. Not thread-safe with respect to concurrent modifications of the table.
+   */
+  std::shared_ptr<TableHashIndex> create_hash_index(const std::vector<ColumnID>& column_ids);
+
+  // Returns the hash index on exactly the given columns, or nullptr if there is none
+  std::shared_ptr<TableHashIndex> get_hash_index(const std::vector<ColumnID>& column_ids) const;
+
+  const std::vector<std::shared_ptr<TableHashIndex>>& hash_indexes() const;
+
   /**
    * For debugging purposes, makes an estimation about the memory used by this Table (including Chunk and Segments)
    */
@@ -177,5 +203,7 @@ class Table : private Noncopyable {
   std::shared_ptr<TableStatistics> _table_statistics;
   std::unique_ptr<std::mutex> _append_mutex;
   std::vector<IndexInfo> _indexes;
+  std::vector<std::shared_ptr<TableHashIndex>> _hash_indexes;
+  mutable std::atomic<CommitID> _last_commit_id{0};
 };
 }  // namespace opossum
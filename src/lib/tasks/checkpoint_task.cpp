@@ -0,0 +1,243 @@
+#include "checkpoint_task.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/export_binary.hpp"
+#include "operators/import_binary.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/base_dictionary_segment.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/vector_compression/fixed_size_byte_aligned/fixed_size_byte_aligned_utils.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/filesystem.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+const auto META_FILE_NAME = std::string{"checkpoint.meta"};
+
+// Whether the binary format can represent the segment without decoding it
+bool is_exportable(const BaseSegment& segment) {
+  if (dynamic_cast<const BaseValueSegment*>(&segment)) return true;
+
+  const auto* const dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment);
+  return dictionary_segment && dictionary_segment->encoding_type() == EncodingType::Dictionary &&
+         dictionary_segment->compressed_vector_type() &&
+         is_fixed_size_byte_aligned(*dictionary_segment->compressed_vector_type());
+}
+
+// Copies the visible rows of the segment into a ValueSegment. Invisible rows might still be written by an Insert and
+// are not read.
+std::shared_ptr<BaseSegment> materialize_segment(const BaseSegment& segment, const TableColumnDefinition& definition,
+                                                 const std::vector<bool>& row_is_visible) {
+  auto materialized_segment = std::shared_ptr<BaseSegment>{};
+  resolve_data_type(definition.data_type, [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    auto values = std::vector<ColumnDataType>(row_is_visible.size());
+    auto null_values = std::vector<bool>(definition.nullable ? row_is_visible.size() : 0);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_is_visible.size(); ++chunk_offset) {
+      if (!row_is_visible[chunk_offset]) continue;
+
+      const auto value = segment[chunk_offset];
+      if (variant_is_null(value)) {
+        null_values[chunk_offset] = true;
+      } else {
+        values[chunk_offset] = type_cast_variant<ColumnDataType>(value);
+      }
+    }
+
+    if (definition.nullable) {
+      materialized_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    } else {
+      materialized_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+    }
+  });
+  return materialized_segment;
+}
+
+std::string table_file_path(const std::string& checkpoint_directory, const size_t table_id) {
+  return checkpoint_directory + "/" + std::to_string(table_id);
+}
+
+}  // namespace
+
+namespace opossum {
+
+CheckpointTask::CheckpointTask(const std::string& checkpoint_directory) : _checkpoint_directory(checkpoint_directory) {}
+
+CommitID CheckpointTask::snapshot_commit_id() const {
+  DebugAssert(is_done(), "The snapshot commit id is only known once the task is done");
+  return _snapshot_commit_id;
+}
+
+void CheckpointTask::_on_execute() {
+  // The snapshot stays registered as active until the context is destroyed
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  _snapshot_commit_id = transaction_context->snapshot_commit_id();
+
+  const auto meta_file_path = _checkpoint_directory + "/" + META_FILE_NAME;
+  filesystem::create_directories(_checkpoint_directory);
+  filesystem::remove(meta_file_path);
+
+  auto table_names = std::vector<std::string>{};
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (const auto& [table_name, table] : StorageManager::get().tables()) {
+    const auto file_path = table_file_path(_checkpoint_directory, table_names.size());
+    table_names.emplace_back(table_name);
+
+    jobs.emplace_back(std::make_shared<JobTask>([table = table, file_path, snapshot_commit_id = _snapshot_commit_id]() {
+      _write_table(*table, snapshot_commit_id, file_path);
+    }));
+  }
+  CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+
+  {
+    auto meta_file = std::ofstream{meta_file_path + ".tmp"};
+    meta_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    meta_file << _snapshot_commit_id << '\n';
+    for (const auto& table_name : table_names) {
+      meta_file << table_name << '\n';
+    }
+  }
+  filesystem::rename(meta_file_path + ".tmp", meta_file_path);
+}
+
+void CheckpointTask::_write_table(const Table& table, const CommitID snapshot_commit_id, const std::string& file_path) {
+  const auto checkpoint_table = std::make_shared<Table>(table.column_definitions(), TableType::Data,
+                                                        table.max_chunk_size(), UseMvcc::No);
+  auto invisible_row_ids = std::vector<RowID>{};
+
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+
+    // Chunks that were physically deleted are replaced by empty chunks to keep the following ChunkIDs
+    if (!chunk) {
+      auto segments = Segments{};
+      for (const auto& column_definition : table.column_definitions()) {
+        resolve_data_type(column_definition.data_type, [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+          segments.emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(column_definition.nullable));
+        });
+      }
+      checkpoint_table->append_chunk(segments);
+      continue;
+    }
+
+    // Rows appended after this point are not visible to the snapshot and thus not needed
+    const auto row_count = chunk->size();
+    auto row_is_visible = std::vector<bool>(row_count, true);
+    if (chunk->has_mvcc_data()) {
+      const auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        row_is_visible[chunk_offset] = mvcc_data->begin_cids[chunk_offset] <= snapshot_commit_id &&
+                                       mvcc_data->end_cids[chunk_offset] > snapshot_commit_id;
+        if (!row_is_visible[chunk_offset]) invisible_row_ids.emplace_back(chunk_id, chunk_offset);
+      }
+    }
+
+    auto segments = Segments{};
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      segments.emplace_back(chunk->get_segment(column_id));
+    }
+
+    // Mutable chunks might still grow and contain rows that are being written
+    const auto keep_segments =
+        !chunk->is_mutable() &&
+        std::all_of(segments.cbegin(), segments.cend(), [](const auto& segment) { return is_exportable(*segment); });
+    if (!keep_segments) {
+      for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+        segments[column_id] = materialize_segment(*segments[column_id], table.column_definitions()[column_id],
+                                                  row_is_visible);
+      }
+    }
+
+    checkpoint_table->append_chunk(segments);
+  }
+
+  ExportBinary::write_binary(*checkpoint_table, file_path + ".bin");
+
+  auto invisible_file = std::ofstream{file_path + ".invisible", std::ios::binary};
+  invisible_file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  invisible_file.write(reinterpret_cast<const char*>(invisible_row_ids.data()),
+                       static_cast<std::streamsize>(invisible_row_ids.size() * sizeof(RowID)));
+}
+
+CommitID CheckpointTask::load_checkpoint(const std::string& checkpoint_directory) {
+  auto meta_file = std::ifstream{checkpoint_directory + "/" + META_FILE_NAME};
+  Assert(meta_file.is_open(), "No complete checkpoint found in '" + checkpoint_directory + "'");
+
+  auto snapshot_commit_id = CommitID{0};
+  meta_file >> snapshot_commit_id;
+  meta_file.ignore();
+
+  auto table_names = std::vector<std::string>{};
+  for (auto table_name = std::string{}; std::getline(meta_file, table_name);) {
+    table_names.emplace_back(table_name);
+  }
+
+  auto tables = std::vector<std::shared_ptr<Table>>(table_names.size());
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto table_id = size_t{0}; table_id < table_names.size(); ++table_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, table_id]() {
+      tables[table_id] = _read_table(table_file_path(checkpoint_directory, table_id));
+    }));
+  }
+  CurrentScheduler::schedule_and_wait_for_tasks(jobs);
+
+  for (auto table_id = size_t{0}; table_id < table_names.size(); ++table_id) {
+    StorageManager::get().add_table(table_names[table_id], tables[table_id]);
+  }
+
+  auto& transaction_manager = TransactionManager::get();
+  transaction_manager.restore_last_commit_id(std::max(transaction_manager.last_commit_id(), snapshot_commit_id));
+
+  return snapshot_commit_id;
+}
+
+std::shared_ptr<Table> CheckpointTask::_read_table(const std::string& file_path) {
+  const auto table = ImportBinary::read_binary(file_path + ".bin");
+
+  // Encoded chunks must not be appended to
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      if (!std::dynamic_pointer_cast<const BaseValueSegment>(chunk->get_segment(column_id))) {
+        chunk->mark_immutable();
+        break;
+      }
+    }
+  }
+
+  auto invisible_file = std::ifstream{file_path + ".invisible", std::ios::binary | std::ios::ate};
+  Assert(invisible_file.is_open(), "Could not open '" + file_path + ".invisible'");
+  auto invisible_row_ids = std::vector<RowID>(static_cast<size_t>(invisible_file.tellg()) / sizeof(RowID));
+  invisible_file.seekg(0);
+  invisible_file.read(reinterpret_cast<char*>(invisible_row_ids.data()),
+                      static_cast<std::streamsize>(invisible_row_ids.size() * sizeof(RowID)));
+
+  for (const auto& row_id : invisible_row_ids) {
+    const auto chunk = table->get_chunk(row_id.chunk_id);
+    chunk->get_scoped_mvcc_data_lock()->end_cids[row_id.chunk_offset] = CommitID{0};
+    chunk->increase_invalid_row_count(1);
+  }
+
+  return table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "scheduler/abstract_task.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * @brief Writes a consistent checkpoint of all tables without blocking transactions
+ *
+ * The checkpoint contains the rows that are visible to a snapshot taken when the task starts. Its snapshot commit id
+ * is recorded, so that only transactions that committed later have to be replayed from the log after the checkpoint
+ * was loaded (see recover_from_log()). While the checkpoint is written, the snapshot is registered as active. Thus,
+ * the MvccDeletePlugin does not remove chunks that are still visible to it.
+ *
+ * Each table is written in the binary format (see ExportBinary) by a separate job. Chunks keep their ChunkIDs and
+ * all of their rows, so that the RowIDs in the log remain valid. Rows that are not visible to the snapshot are written
+ * as placeholders and invalidated when the checkpoint is loaded. Immutable chunks are written with their encoding if
+ * the binary format supports it (i.e., for value segments and dictionary segments), so that they do not have to be
+ * encoded again after loading. All other chunks are written as value segments.
+ *
+ * The checkpoint directory contains the following files:
+ *   checkpoint.meta      the snapshot commit id and the names of the tables, one per line
+ *   <table id>.bin       the table in the binary format, with <table id> being its line in checkpoint.meta
+ *   <table id>.invisible the RowIDs of the rows that are not visible to the snapshot
+ *
+ * checkpoint.meta is written last, so that an incomplete checkpoint cannot be loaded. An existing checkpoint in the
+ * directory is replaced.
+ */
+class CheckpointTask : public AbstractTask {
+ public:
+  explicit CheckpointTask(const std::string& checkpoint_directory);
+
+  // Only valid once the task is done
+  CommitID snapshot_commit_id() const;
+
+  /**
+   * Adds the tables of the checkpoint to the StorageManager, which must not contain tables with the same names. Has to
+   * be called before the first transaction is executed.
+   *
+   * @return the snapshot commit id of the checkpoint, to be passed to recover_from_log()
+   */
+  static CommitID load_checkpoint(const std::string& checkpoint_directory);
+
+ protected:
+  void _on_execute() override;
+
+ private:
+  static void _write_table(const Table& table, const CommitID snapshot_commit_id, const std::string& file_path);
+  static std::shared_ptr<Table> _read_table(const std::string& file_path);
+
+  const std::string _checkpoint_directory;
+  CommitID _snapshot_commit_id{0};
+};
+
+}  // namespace opossum
@@ -13,11 +13,17 @@
 
 namespace opossum {
 
-ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id)
-    : ChunkCompressionTask{table_name, std::vector<ChunkID>{chunk_id}} {}
+ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id,
+                                           const std::optional<EncodingAdvisor>& encoding_advisor)
+    : ChunkCompressionTask{table_name, std::vector<ChunkID>{chunk_id}, encoding_advisor} {}
 
-ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids)
-    : _table_name{table_name}, _chunk_ids{chunk_ids} {}
+ChunkCompressionTask::ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                           const std::optional<EncodingAdvisor>& encoding_advisor)
+    : _table_name{table_name}, _chunk_ids{chunk_ids}, _encoding_advisor{encoding_advisor} {}
+
+const std::map<ChunkID, std::vector<SegmentEncodingDecision>>& ChunkCompressionTask::encoding_decisions() const {
+  return _encoding_decisions;
+}
 
 void ChunkCompressionTask::_on_execute() {
   auto table = StorageManager::get().get_table(_table_name);
@@ -32,7 +38,13 @@ void ChunkCompressionTask::_on_execute() {
     DebugAssert(_chunk_is_completed(chunk, table->max_chunk_size()),
                 "Chunk is not completed and thus can’t be compressed.");
 
-    ChunkEncoder::encode_chunk(chunk, table->column_data_types());
+    if (!_encoding_advisor) {
+      ChunkEncoder::encode_chunk(chunk, table->column_data_types());
+      continue;
+    }
+
+    const auto& decisions = _encoding_decisions[chunk_id] = _encoding_advisor->advise_chunk(*chunk);
+    ChunkEncoder::encode_chunk(chunk, table->column_data_types(), EncodingAdvisor::to_chunk_encoding_spec(decisions));
   }
 }
 
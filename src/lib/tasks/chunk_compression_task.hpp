@@ -1,9 +1,12 @@
 #pragma once
 
+#include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "scheduler/abstract_task.hpp"
+#include "storage/encoding_advisor.hpp"
 
 namespace opossum {
 
@@ -27,13 +30,21 @@ class Chunk;
  * full and all of their end-cids must be smaller than infinity. This task calls
  * those chunks “completed”.
  *
+ * If an EncodingAdvisor is passed, it chooses the encoding of each segment instead. Its decisions can be
+ * retrieved via encoding_decisions() once the task is done.
+ *
  * Note: Reference segments are not invalidated by this task because the order in which
  *       records are stored does not change.
  */
 class ChunkCompressionTask : public AbstractTask {
  public:
-  explicit ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id);
-  explicit ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids);
+  explicit ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id,
+                                const std::optional<EncodingAdvisor>& encoding_advisor = std::nullopt);
+  explicit ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                const std::optional<EncodingAdvisor>& encoding_advisor = std::nullopt);
+
+  // Decisions of the EncodingAdvisor, one per segment of each compressed chunk
+  const std::map<ChunkID, std::vector<SegmentEncodingDecision>>& encoding_decisions() const;
 
  protected:
   void _on_execute() override;
@@ -49,5 +60,7 @@ class ChunkCompressionTask : public AbstractTask {
  private:
   const std::string _table_name;
   const std::vector<ChunkID> _chunk_ids;
+  const std::optional<EncodingAdvisor> _encoding_advisor;
+  std::map<ChunkID, std::vector<SegmentEncodingDecision>> _encoding_decisions;
 };
 }  // namespace opossum
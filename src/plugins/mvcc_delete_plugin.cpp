@@ -0,0 +1,213 @@
+#include "mvcc_delete_plugin.hpp"
+
+#include "concurrency/transaction_manager.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/update.hpp"
+#include "operators/validate.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns the encoding of the segments of a chunk, so that the chunks that take up its rows can be encoded alike
+ChunkEncodingSpec get_chunk_encoding_spec(const Chunk& chunk) {
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk.get_segment(column_id));
+    if (!encoded_segment) {
+      chunk_encoding_spec.emplace_back(EncodingType::Unencoded);
+      continue;
+    }
+
+    const auto compressed_vector_type = encoded_segment->compressed_vector_type();
+    if (!compressed_vector_type) {
+      chunk_encoding_spec.emplace_back(encoded_segment->encoding_type());
+    } else if (*compressed_vector_type == CompressedVectorType::SimdBp128) {
+      chunk_encoding_spec.emplace_back(encoded_segment->encoding_type(), VectorCompressionType::SimdBp128);
+    } else {
+      chunk_encoding_spec.emplace_back(encoded_segment->encoding_type(), VectorCompressionType::FixedSizeByteAligned);
+    }
+  }
+  return chunk_encoding_spec;
+}
+
+// Full chunks whose rows were all committed do not change anymore, see ChunkCompressionTask
+bool chunk_is_completed(const std::shared_ptr<Chunk>& chunk, const uint32_t max_chunk_size) {
+  if (chunk->size() != max_chunk_size || !chunk->is_mutable()) return false;
+
+  auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+  for (const auto begin_cid : mvcc_data->begin_cids) {
+    if (begin_cid == MvccData::MAX_COMMIT_ID) return false;
+  }
+
+  return true;
+}
+
+// Rows of uncommitted inserts have a begin_cid of MAX_COMMIT_ID, rows of inserts that are still committing a begin_cid
+// above the snapshot. Validate does not see these rows, so compacting the chunk would lose them.
+bool all_inserts_visible(const std::shared_ptr<Chunk>& chunk, const CommitID snapshot_commit_id) {
+  auto mvcc_data = chunk->get_scoped_mvcc_data_lock();
+  for (const auto begin_cid : mvcc_data->begin_cids) {
+    if (begin_cid > snapshot_commit_id) return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+namespace opossum {
+
+const std::string MvccDeletePlugin::description() const {
+  return "Physically deletes invalidated rows by compacting chunks with many invalidated rows";
+}
+
+void MvccDeletePlugin::start() {
+  _loop_thread = std::make_unique<PausableLoopThread>(IDLE_DELAY, [&](size_t) {
+    _physical_delete_loop();
+    _logical_delete_loop();
+  });
+}
+
+void MvccDeletePlugin::stop() {
+  // Joins the thread
+  _loop_thread.reset();
+
+  // Remove the logically deleted chunks that are not visible anymore. The others are kept, so that they are removed
+  // once the plugin is started again.
+  _physical_delete_loop();
+}
+
+void MvccDeletePlugin::_logical_delete_loop() {
+  auto& storage_manager = StorageManager::get();
+
+  for (const auto& table_name : storage_manager.table_names()) {
+    if (!storage_manager.has_table(table_name)) continue;
+
+    const auto table = storage_manager.get_table(table_name);
+    if (table->has_mvcc() == UseMvcc::No) continue;
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+
+      // Only full chunks are compacted, as rows might still be inserted into the others
+      if (!chunk || chunk->get_cleanup_commit_id() || chunk->size() != table->max_chunk_size()) continue;
+
+      const auto invalidated_rows_share = static_cast<double>(chunk->invalid_row_count()) / chunk->size();
+      if (invalidated_rows_share < INVALIDATED_ROWS_THRESHOLD) continue;
+
+      if (_delete_chunk_logically(table_name, chunk_id)) {
+        _logically_deleted_chunks.emplace_back(LogicallyDeletedChunk{table_name, table, chunk_id});
+      }
+    }
+  }
+}
+
+void MvccDeletePlugin::_physical_delete_loop() {
+  auto& storage_manager = StorageManager::get();
+
+  auto chunk_iter = _logically_deleted_chunks.begin();
+  while (chunk_iter != _logically_deleted_chunks.end()) {
+    const auto table = chunk_iter->table.lock();
+
+    // The chunk is gone with the table if the table was dropped or replaced
+    const auto table_exists = table && storage_manager.has_table(chunk_iter->table_name) &&
+                              storage_manager.get_table(chunk_iter->table_name) == table;
+
+    if (!table_exists || _delete_chunk_physically(table, chunk_iter->chunk_id)) {
+      chunk_iter = _logically_deleted_chunks.erase(chunk_iter);
+    } else {
+      ++chunk_iter;
+    }
+  }
+}
+
+bool MvccDeletePlugin::_delete_chunk_logically(const std::string& table_name, const ChunkID chunk_id) {
+  const auto table = StorageManager::get().get_table(table_name);
+  const auto chunk = table->get_chunk(chunk_id);
+  DebugAssert(!chunk->get_cleanup_commit_id(), "Chunk was already deleted logically");
+
+  const auto chunk_encoding_spec = get_chunk_encoding_spec(*chunk);
+  const auto first_target_chunk_id = static_cast<ChunkID>(table->chunk_count() - 1);
+
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+
+  // A full chunk can still hold rows of inserts that did not commit yet
+  if (!all_inserts_visible(chunk, transaction_context->snapshot_commit_id())) {
+    transaction_context->rollback();
+    return false;
+  }
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(_get_referencing_table(table, chunk_id));
+  table_wrapper->execute();
+
+  const auto validate = std::make_shared<Validate>(table_wrapper);
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+
+  // The rows are not changed, so the valid rows are both the rows to delete and the rows to re-insert
+  const auto update = std::make_shared<Update>(table_name, validate, validate);
+  update->set_transaction_context(transaction_context);
+  update->execute();
+
+  if (update->execute_failed()) {
+    transaction_context->rollback();
+    return false;
+  }
+
+  transaction_context->commit();
+  chunk->set_cleanup_commit_id(transaction_context->commit_id());
+
+  // Encode the chunks that were filled up by the re-inserted rows
+  for (auto target_chunk_id = first_target_chunk_id; target_chunk_id < table->chunk_count(); ++target_chunk_id) {
+    const auto target_chunk = table->get_chunk(target_chunk_id);
+    if (chunk_is_completed(target_chunk, table->max_chunk_size())) {
+      ChunkEncoder::encode_chunk(target_chunk, table->column_data_types(), chunk_encoding_spec);
+    }
+  }
+
+  return true;
+}
+
+bool MvccDeletePlugin::_delete_chunk_physically(const std::shared_ptr<Table>& table, const ChunkID chunk_id) {
+  const auto& cleanup_commit_id = table->get_chunk(chunk_id)->get_cleanup_commit_id();
+  Assert(cleanup_commit_id, "Chunk needs to be deleted logically before it can be deleted physically");
+
+  // Transactions with a snapshot before the logical delete might still read the chunk
+  const auto lowest_active_snapshot_commit_id = TransactionManager::get().get_lowest_active_snapshot_commit_id();
+  if (lowest_active_snapshot_commit_id && *lowest_active_snapshot_commit_id < *cleanup_commit_id) return false;
+
+  table->remove_chunk(chunk_id);
+  return true;
+}
+
+std::shared_ptr<const Table> MvccDeletePlugin::_get_referencing_table(const std::shared_ptr<const Table>& table,
+                                                                     const ChunkID chunk_id) {
+  const auto chunk = table->get_chunk(chunk_id);
+
+  auto pos_list = std::make_shared<PosList>();
+  pos_list->reserve(chunk->size());
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+    pos_list->emplace_back(RowID{chunk_id, chunk_offset});
+  }
+  pos_list->guarantee_single_chunk();
+
+  auto segments = Segments{};
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    segments.emplace_back(std::make_shared<ReferenceSegment>(table, column_id, pos_list));
+  }
+
+  const auto referencing_table = std::make_shared<Table>(table->column_definitions(), TableType::References);
+  referencing_table->append_chunk(segments);
+  return referencing_table;
+}
+
+EXPORT_PLUGIN(MvccDeletePlugin)
+
+}  // namespace opossum
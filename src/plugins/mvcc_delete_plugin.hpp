@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/singleton.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Compacts chunks of which most rows were deleted (or updated, which deletes the old versions), so that scans do not
+ * have to look at the invalidated rows anymore and their memory is freed. This happens in a background thread in the
+ * two steps that are described at Chunk::get_cleanup_commit_id():
+ *
+ * 1. Logical delete: In a single transaction, the visible rows of the chunk are deleted and re-inserted at the end of
+ *    the table. The chunk's cleanup commit ID is set to the commit ID of that transaction, so that transactions with a
+ *    later snapshot skip the chunk (see GetTable). The chunks that are filled by the re-inserted rows are encoded like
+ *    the compacted chunk.
+ * 2. Physical delete: Once no active transaction has a snapshot older than the cleanup commit ID, no transaction can
+ *    see the rows of the chunk anymore and it is removed from the table (see Table::remove_chunk()).
+ *
+ * If the logical delete conflicts with a concurrent transaction (i.e., another transaction locked one of the rows),
+ * the chunk is tried again in a later iteration. When the plugin is stopped, logically deleted chunks that are still
+ * visible to active transactions are kept in the list and physically deleted after the next start.
+ */
+class MvccDeletePlugin : public AbstractPlugin, public Singleton<MvccDeletePlugin> {
+  friend class MvccDeletePluginTest;
+
+ public:
+  // Only chunks with at least this share of invalidated rows are compacted
+  static constexpr auto INVALIDATED_ROWS_THRESHOLD = 0.5;
+  static constexpr auto IDLE_DELAY = std::chrono::milliseconds{1000};
+
+  const std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+ private:
+  struct LogicallyDeletedChunk {
+    std::string table_name;
+    std::weak_ptr<Table> table;
+    ChunkID chunk_id;
+  };
+
+  void _logical_delete_loop();
+  void _physical_delete_loop();
+
+  /**
+   * Deletes the visible rows of the chunk and re-inserts them at the end of the table in a single transaction. Returns
+   * false if the transaction conflicted with another one and was rolled back.
+   */
+  static bool _delete_chunk_logically(const std::string& table_name, const ChunkID chunk_id);
+
+  /**
+   * Removes a logically deleted chunk from the table. Returns false if a transaction that might still see the chunk's
+   * rows is active.
+   */
+  static bool _delete_chunk_physically(const std::shared_ptr<Table>& table, const ChunkID chunk_id);
+
+  // Returns a reference table that contains all rows of the chunk
+  static std::shared_ptr<const Table> _get_referencing_table(const std::shared_ptr<const Table>& table,
+                                                             const ChunkID chunk_id);
+
+  std::unique_ptr<PausableLoopThread> _loop_thread;
+  std::vector<LogicallyDeletedChunk> _logically_deleted_chunks;
+};
+
+}  // namespace opossum
@@ -14,6 +14,7 @@
 #include "scheduler/current_scheduler.hpp"
 #include "sql/sql_plan_cache.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/decompressed_segment_cache.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "storage/storage_manager.hpp"
@@ -72,6 +73,9 @@ class BaseTestWithParam
 
     SQLPhysicalPlanCache::get().clear();
     SQLLogicalPlanCache::get().clear();
+    SQLParameterizedPlanCache::get().clear();
+    SQLQueryResultCache::get().clear();
+    DecompressedSegmentCache::get().clear();
   }
 
   static std::shared_ptr<AbstractExpression> get_column_expression(const std::shared_ptr<AbstractOperator>& op,
@@ -0,0 +1,102 @@
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "latency_histogram.hpp"
+
+namespace opossum {
+
+class LatencyHistogramTest : public ::testing::Test {
+ protected:
+  static size_t bucket_index(const uint64_t value) { return LatencyHistogram::_bucket_index(value); }
+
+  static uint64_t bucket_upper_bound(const size_t bucket_index) {
+    return LatencyHistogram::_bucket_upper_bound(bucket_index);
+  }
+
+  static constexpr auto SUB_BUCKET_COUNT = LatencyHistogram::SUB_BUCKET_COUNT;
+  static constexpr auto BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - LatencyHistogram::SUB_BUCKET_BITS + 1);
+};
+
+TEST_F(LatencyHistogramTest, BucketIndex) {
+  // Small values get a bucket each
+  EXPECT_EQ(bucket_index(0), 0u);
+  EXPECT_EQ(bucket_index(1), 1u);
+  EXPECT_EQ(bucket_index(SUB_BUCKET_COUNT - 1), SUB_BUCKET_COUNT - 1);
+  EXPECT_EQ(bucket_index(SUB_BUCKET_COUNT), SUB_BUCKET_COUNT);
+  EXPECT_EQ(bucket_index(2 * SUB_BUCKET_COUNT - 1), 2 * SUB_BUCKET_COUNT - 1);
+
+  // From the next power of two on, two values share a bucket
+  EXPECT_EQ(bucket_index(2 * SUB_BUCKET_COUNT), 2 * SUB_BUCKET_COUNT);
+  EXPECT_EQ(bucket_index(2 * SUB_BUCKET_COUNT + 1), 2 * SUB_BUCKET_COUNT);
+  EXPECT_EQ(bucket_index(2 * SUB_BUCKET_COUNT + 2), 2 * SUB_BUCKET_COUNT + 1);
+
+  // The largest value falls into the last bucket
+  EXPECT_EQ(bucket_index(std::numeric_limits<uint64_t>::max()), BUCKET_COUNT - 1);
+}
+
+TEST_F(LatencyHistogramTest, BucketUpperBound) {
+  EXPECT_EQ(bucket_upper_bound(0), 0u);
+  EXPECT_EQ(bucket_upper_bound(SUB_BUCKET_COUNT - 1), SUB_BUCKET_COUNT - 1);
+  EXPECT_EQ(bucket_upper_bound(2 * SUB_BUCKET_COUNT), 2 * SUB_BUCKET_COUNT + 1);
+  EXPECT_EQ(bucket_upper_bound(bucket_index(std::numeric_limits<uint64_t>::max())),
+            std::numeric_limits<uint64_t>::max());
+
+  // The upper bound of a value's bucket is in the same bucket and exceeds the value by less than 1%
+  for (auto value = uint64_t{1}; value < uint64_t{1} << 40; value = value * 3 + 1) {
+    const auto upper_bound = bucket_upper_bound(bucket_index(value));
+    EXPECT_GE(upper_bound, value);
+    EXPECT_LT(upper_bound - value, value / 100 + 1);
+    EXPECT_EQ(bucket_index(upper_bound), bucket_index(value));
+    EXPECT_EQ(bucket_index(upper_bound + 1), bucket_index(value) + 1);
+  }
+}
+
+TEST_F(LatencyHistogramTest, Empty) {
+  const auto histogram = LatencyHistogram{};
+  EXPECT_EQ(histogram.count(), 0u);
+  EXPECT_EQ(histogram.percentile(0.0), std::chrono::nanoseconds{0});
+  EXPECT_EQ(histogram.percentile(50.0), std::chrono::nanoseconds{0});
+  EXPECT_EQ(histogram.percentile(100.0), std::chrono::nanoseconds{0});
+  EXPECT_EQ(histogram.max(), std::chrono::nanoseconds{0});
+}
+
+TEST_F(LatencyHistogramTest, SingleSample) {
+  auto histogram = LatencyHistogram{};
+  histogram.record(std::chrono::nanoseconds{1'000'000});
+  EXPECT_EQ(histogram.count(), 1u);
+
+  // Every percentile is the bucket of the only sample
+  const auto expected = std::chrono::nanoseconds{bucket_upper_bound(bucket_index(1'000'000))};
+  EXPECT_GE(expected, std::chrono::nanoseconds{1'000'000});
+  EXPECT_EQ(histogram.percentile(0.0), expected);
+  EXPECT_EQ(histogram.percentile(50.0), expected);
+  EXPECT_EQ(histogram.percentile(100.0), expected);
+  EXPECT_EQ(histogram.max(), expected);
+}
+
+TEST_F(LatencyHistogramTest, Percentiles) {
+  auto histogram = LatencyHistogram{};
+  for (auto latency = 1; latency <= 100; ++latency) {
+    histogram.record(std::chrono::nanoseconds{latency});
+  }
+
+  // Negative latencies (e.g., caused by clock adjustments) are recorded as zero
+  histogram.record(std::chrono::nanoseconds{-5});
+  EXPECT_EQ(histogram.count(), 101u);
+
+  // Small values are recorded exactly
+  EXPECT_EQ(histogram.percentile(0.0), std::chrono::nanoseconds{0});
+  EXPECT_EQ(histogram.percentile(50.0), std::chrono::nanoseconds{50});
+  EXPECT_EQ(histogram.percentile(99.0), std::chrono::nanoseconds{99});
+  EXPECT_EQ(histogram.percentile(100.0), std::chrono::nanoseconds{100});
+  EXPECT_EQ(histogram.max(), std::chrono::nanoseconds{100});
+
+  EXPECT_THROW(histogram.percentile(-1.0), std::logic_error);
+  EXPECT_THROW(histogram.percentile(100.1), std::logic_error);
+}
+
+}  // namespace opossum
@@ -1,3 +1,6 @@
+#include <thread>
+#include <vector>
+
 #include "base_test.hpp"
 
 #include "cache/cache.hpp"
@@ -253,6 +256,60 @@ TEST(CachePolicyTest, Iterators) {
   ASSERT_EQ(value_sum, 200);
 }
 
+TEST(CachePolicyTest, Sharding) {
+  // Small caches are not sharded so that they behave exactly like their policy
+  EXPECT_EQ(Cache<int, int>(2).shard_count(), 1u);
+
+  Cache<int, int> cache(1024);
+  EXPECT_EQ(cache.shard_count(), Cache<int, int>::DEFAULT_MAX_SHARD_COUNT);
+  EXPECT_EQ(Cache<int, int>(1024, 4).shard_count(), 4u);
+
+  for (auto key = 0; key < 2048; ++key) {
+    cache.set(key, key);
+  }
+  EXPECT_EQ(cache.size(), 1024u);
+  EXPECT_EQ(cache.capacity(), 1024u);
+
+  auto element_count = size_t{0};
+  for (const auto& [key, value] : cache) {
+    ++element_count;
+    ASSERT_EQ(key, value);
+    ASSERT_TRUE(cache.has(key));
+  }
+  EXPECT_EQ(element_count, 1024u);
+
+  // Shrinking the cache below the capacity of two shards merges the entries into a single shard
+  cache.resize(100);
+  EXPECT_EQ(cache.shard_count(), 1u);
+  EXPECT_EQ(cache.size(), 100u);
+
+  cache.resize(0);
+  cache.set(1, 1);
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_FALSE(cache.try_get(1));
+}
+
+TEST(CachePolicyTest, ConcurrentAccesses) {
+  Cache<int, int> cache(256);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < 8; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto iteration = 0; iteration < 10'000; ++iteration) {
+        const auto key = (iteration * (thread_id + 1)) % 512;
+        cache.set(key, key);
+        const auto value = cache.try_get(key / 2);
+        if (value) ASSERT_EQ(*value, key / 2);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_LE(cache.size(), 256u);
+}
+
 template <typename T>
 class CacheTest : public BaseTest {};
 
@@ -1,4 +1,5 @@
-#include <algorithm>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include "base_test.hpp"
@@ -13,76 +14,107 @@ class TransactionManagerTest : public BaseTest {
  protected:
   void SetUp() override {}
 
-  static std::unordered_multiset<CommitID>& get_active_snapshot_commit_ids() {
-    return TransactionManager::get()._active_snapshot_commit_ids;
-  }
+  static size_t active_transaction_count() { return TransactionManager::get()._active_transaction_count(); }
 
-  static void register_transaction(CommitID snapshot_commit_id) {
-    TransactionManager::get()._register_transaction(snapshot_commit_id);
-  }
-  static void deregister_transaction(CommitID snapshot_commit_id) {
-    TransactionManager::get()._deregister_transaction(snapshot_commit_id);
-  }
+  static size_t snapshot_slot_count() { return TransactionManager::SNAPSHOT_SLOT_COUNT; }
+
+  // Advances the last commit id, so that the following transactions have a different snapshot-commit-id
+  static void commit_empty_transaction() { TransactionManager::get().new_transaction_context()->commit(); }
 };
 
 /** Check if all active snapshot commit ids of uncommitted
  * transaction contexts are tracked correctly.
- * Normally, deregister_transaction() is called in the
- * destructor of the transaction context but is called
- * manually for this test.
  */
 TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   auto& manager = TransactionManager::get();
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
+  EXPECT_EQ(active_transaction_count(), 0);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
 
-  const auto t1_context = manager.new_transaction_context();
-  const auto t2_context = manager.new_transaction_context();
-  const auto t3_context = manager.new_transaction_context();
+  auto t1_context = manager.new_transaction_context();
+  commit_empty_transaction();
+  auto t2_context = manager.new_transaction_context();
+  commit_empty_transaction();
+  auto t3_context = manager.new_transaction_context();
 
-  const CommitID t1_snapshot_commit_id = t1_context->snapshot_commit_id();
-  const CommitID t2_snapshot_commit_id = t2_context->snapshot_commit_id();
-  const CommitID t3_snapshot_commit_id = t3_context->snapshot_commit_id();
-  const auto vec = std::vector<CommitID>{t1_snapshot_commit_id, t2_snapshot_commit_id, t3_snapshot_commit_id};
+  const auto t2_snapshot_commit_id = t2_context->snapshot_commit_id();
+  EXPECT_LT(t1_context->snapshot_commit_id(), t2_snapshot_commit_id);
+  EXPECT_LT(t2_snapshot_commit_id, t3_context->snapshot_commit_id());
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 3);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), *std::min_element(vec.cbegin(), vec.cend()));
+  EXPECT_EQ(active_transaction_count(), 3);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t1_context->snapshot_commit_id());
 
   t1_context->commit();
-  deregister_transaction(t1_context->snapshot_commit_id());
+  t1_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  EXPECT_EQ(active_transaction_count(), 2);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t3_context->commit();
-  deregister_transaction(t3_context->snapshot_commit_id());
+  t3_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  EXPECT_EQ(active_transaction_count(), 1);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t2_context->commit();
-  deregister_transaction(t2_context->snapshot_commit_id());
+  t2_context = nullptr;
+
+  EXPECT_EQ(active_transaction_count(), 0);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+TEST_F(TransactionManagerTest, MoreActiveTransactionsThanSnapshotSlots) {
+  auto& manager = TransactionManager::get();
+
+  auto slot_contexts = std::vector<std::shared_ptr<TransactionContext>>{};
+  for (auto context_id = size_t{0}; context_id < snapshot_slot_count(); ++context_id) {
+    slot_contexts.emplace_back(manager.new_transaction_context());
+  }
+  const auto lowest_snapshot_commit_id = slot_contexts.front()->snapshot_commit_id();
+
+  // The following snapshot-commit-ids do not fit into the slots anymore
+  commit_empty_transaction();
+  auto overflow_contexts = std::vector<std::shared_ptr<TransactionContext>>{};
+  overflow_contexts.emplace_back(manager.new_transaction_context());
+  overflow_contexts.emplace_back(manager.new_transaction_context());
+  const auto overflow_snapshot_commit_id = overflow_contexts.front()->snapshot_commit_id();
+  EXPECT_GT(overflow_snapshot_commit_id, lowest_snapshot_commit_id);
+
+  EXPECT_EQ(active_transaction_count(), snapshot_slot_count() + 2);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), lowest_snapshot_commit_id);
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
+  slot_contexts.clear();
+  EXPECT_EQ(active_transaction_count(), 2);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), overflow_snapshot_commit_id);
+
+  overflow_contexts.clear();
+  EXPECT_EQ(active_transaction_count(), 0);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+TEST_F(TransactionManagerTest, ConcurrentTransactions) {
+  auto& manager = TransactionManager::get();
+  const auto initial_snapshot_commit_id = manager.last_commit_id();
+  const auto long_running_context = manager.new_transaction_context();
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < 8; ++thread_id) {
+    threads.emplace_back([&]() {
+      for (auto transaction_id = 0; transaction_id < 1'000; ++transaction_id) {
+        const auto context = manager.new_transaction_context();
+        EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), initial_snapshot_commit_id);
+        context->commit();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
 
-  // To prevent exceptions in TransactionContext destructor
-  register_transaction(t1_snapshot_commit_id);
-  register_transaction(t2_snapshot_commit_id);
-  register_transaction(t3_snapshot_commit_id);
+  EXPECT_EQ(manager.last_commit_id(), initial_snapshot_commit_id + 8'000);
+  EXPECT_EQ(active_transaction_count(), 1);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), initial_snapshot_commit_id);
 }
 
 }  // namespace opossum
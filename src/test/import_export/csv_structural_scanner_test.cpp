@@ -0,0 +1,65 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "import_export/csv_structural_scanner.hpp"
+
+namespace opossum {
+
+class CsvStructuralScannerTest : public BaseTest {
+ protected:
+  template <bool IncludeSeparators>
+  std::vector<std::pair<size_t, bool>> scan(const std::string& content, const ParseConfig& config = {}) {
+    auto structurals = std::vector<std::pair<size_t, bool>>{};
+    CsvStructuralScanner{config}.scan<IncludeSeparators>(content, [&](const size_t position, const bool is_delimiter) {
+      structurals.emplace_back(position, is_delimiter);
+      return true;
+    });
+    return structurals;
+  }
+};
+
+TEST_F(CsvStructuralScannerTest, PrefixXor) {
+  EXPECT_EQ(CsvStructuralScanner::prefix_xor(0b0), 0b0u);
+  EXPECT_EQ(CsvStructuralScanner::prefix_xor(0b100010), 0b011110u);
+  EXPECT_EQ(CsvStructuralScanner::prefix_xor(0b1001001), 0xFFFFFFFFFFFFFFC7u);
+  EXPECT_EQ(CsvStructuralScanner::prefix_xor(uint64_t{1} << 63), uint64_t{1} << 63);
+}
+
+TEST_F(CsvStructuralScannerTest, SeparatorsAndDelimiters) {
+  const auto expected = std::vector<std::pair<size_t, bool>>{{1, false}, {3, true}, {5, false}, {7, true}};
+  EXPECT_EQ(scan<true>("a,b\nc,d\n"), expected);
+
+  const auto expected_delimiters = std::vector<std::pair<size_t, bool>>{{3, true}, {7, true}};
+  EXPECT_EQ(scan<false>("a,b\nc,d\n"), expected_delimiters);
+}
+
+TEST_F(CsvStructuralScannerTest, QuotesSpanningBlocks) {
+  // The quoted value crosses the boundary between the first and the second block
+  auto content = std::string(60, 'x') + ",\"" + std::string(10, ',') + "\n\"\"" + std::string(60, ',') + "\",y\n";
+
+  const auto expected =
+      std::vector<std::pair<size_t, bool>>{{60, false}, {content.size() - 3, false}, {content.size() - 1, true}};
+  EXPECT_EQ(scan<true>(content), expected);
+}
+
+TEST_F(CsvStructuralScannerTest, EscapedQuotes) {
+  auto config = ParseConfig{};
+  config.escape = '\\';
+
+  // The first escaped quote crosses the block boundary, the second one does not end the quoted value
+  auto content = std::string(63, 'x') + "\\\",a\n\"b\\\",c\",d\n";
+  const auto expected = std::vector<std::pair<size_t, bool>>{{65, false}, {67, true}, {75, false}, {77, true}};
+  EXPECT_EQ(scan<true>(content, config), expected);
+}
+
+TEST_F(CsvStructuralScannerTest, StopEarly) {
+  auto count = size_t{0};
+  CsvStructuralScanner{ParseConfig{}}.scan<true>("a,b,c,d\n", [&](const size_t, const bool) { return ++count < 2; });
+  EXPECT_EQ(count, 2u);
+}
+
+}  // namespace opossum
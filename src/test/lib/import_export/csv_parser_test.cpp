@@ -1,7 +1,11 @@
+#include <optional>
+
 #include "base_test.hpp"
 #include "gtest/gtest.h"
 
+#include "import_export/csv_converter.hpp"
 #include "import_export/csv_parser.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -18,4 +22,68 @@ TEST_F(CsvParserTest, EmptyTableFromMetaFile) {
   EXPECT_TABLE_EQ_UNORDERED(csv_meta_table, expected_table);
 }
 
+TEST_F(CsvParserTest, WindowSmallerThanChunk) {
+  // With a window of a few bytes, chunks have to be assembled from several windows
+  CsvParser parser{7};
+  const auto table = parser.parse("resources/test_data/csv/float_int_large.csv", std::nullopt, ChunkOffset{30});
+
+  const auto expected_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"b", DataType::Float}, {"a", DataType::Int}}, TableType::Data);
+  for (auto i = 0; i < 100; ++i) {
+    expected_table->append({458.7f, 12345});
+  }
+
+  EXPECT_EQ(table->chunk_count(), 4u);
+  EXPECT_EQ(table->get_chunk(ChunkID{3})->size(), 10u);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, WindowEndsWithinQuotes) {
+  CsvParser parser{3};
+  const auto table = parser.parse("resources/test_data/csv/string_escaped.csv", std::nullopt, ChunkOffset{2});
+
+  auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::String}}, TableType::Data);
+  expected_table->append({"aa\"\"aa"});
+  expected_table->append({"xx\"x"});
+  expected_table->append({"yy,y"});
+  expected_table->append({"zz\nz"});
+
+  EXPECT_EQ(table->chunk_count(), 2u);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, EncodeWhileParsing) {
+  CsvParser parser;
+  const auto table = parser.parse("resources/test_data/csv/float_int_large.csv", std::nullopt, ChunkOffset{20},
+                                  ChunkEncodingSpec{2, SegmentEncodingSpec{EncodingType::Dictionary}});
+
+  ASSERT_EQ(table->chunk_count(), 5u);
+  for (ChunkID chunk_id{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(chunk->has_mvcc_data());
+    EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+  EXPECT_EQ(table->row_count(), 100u);
+}
+
+TEST_F(CsvParserTest, NumberFastPaths) {
+  // Numbers that are not handled by the fast paths fall back to the regular conversion in CsvConverter
+  const auto parse_int = opossum::detail::parse_integer_fast_path<int32_t, 9>;
+  EXPECT_EQ(parse_int("-123456789"), -123456789);
+  EXPECT_EQ(parse_int("+42"), 42);
+  EXPECT_EQ(parse_int("1234567890"), std::nullopt);
+  EXPECT_EQ(parse_int(" 1"), std::nullopt);
+  EXPECT_EQ(parse_int("-"), std::nullopt);
+
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<float>("458.7"), 458.7f);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<double>("-0.000123"), -0.000123);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<double>("12."), 12.0);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<double>(".5"), 0.5);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<double>("1e5"), std::nullopt);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<double>("."), std::nullopt);
+  EXPECT_EQ(opossum::detail::parse_floating_point_fast_path<float>("1.23456789"), std::nullopt);
+}
+
 }  // namespace opossum
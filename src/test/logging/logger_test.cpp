@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
+#include "logging/recovery.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/validate.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class LoggerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::remove(log_file_path.c_str());
+    StorageManager::get().add_table("int_float", load_table("resources/test_data/tbl/int_float.tbl", 2u));
+  }
+
+  void TearDown() override {
+    if (Logger::get().is_enabled()) Logger::get().disable();
+    std::remove(log_file_path.c_str());
+  }
+
+  static std::shared_ptr<const Table> execute_sql(const std::string& sql) {
+    auto sql_pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    return sql_pipeline.get_result_table();
+  }
+
+  // Simulates a restart, after which the table is loaded again (e.g., from a checkpoint) and the log is replayed
+  size_t restart_and_recover() {
+    if (Logger::get().is_enabled()) Logger::get().disable();
+
+    StorageManager::reset();
+    TransactionManager::reset();
+    SQLQueryResultCache::get().clear();
+
+    StorageManager::get().add_table("int_float", load_table("resources/test_data/tbl/int_float.tbl", 2u));
+    return recover_from_log(log_file_path);
+  }
+
+  const std::string log_file_path = test_data_path + "logger_test.log";
+};
+
+TEST_F(LoggerTest, RecoverCommittedTransactions) {
+  Logger::get().enable(log_file_path);
+
+  execute_sql("INSERT INTO int_float VALUES (1, 1.5), (2, 2.5)");
+  execute_sql("DELETE FROM int_float WHERE a = 123");
+  execute_sql("UPDATE int_float SET b = 3.5 WHERE a = 1");
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+
+  // The transaction is rolled back and thus not logged
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto sql_pipeline = SQLPipelineBuilder{"DELETE FROM int_float WHERE a = 1234"}
+                          .with_transaction_context(transaction_context)
+                          .create_pipeline();
+  sql_pipeline.get_result_table();
+  transaction_context->rollback();
+
+  EXPECT_GT(Logger::get().written_bytes(), 0u);
+
+  EXPECT_EQ(restart_and_recover(), 3u);
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+}
+
+TEST_F(LoggerTest, LogDeleteOfPrunedTable) {
+  Logger::get().enable(log_file_path);
+
+  // GetTable returns a copy without the first chunk, so the row with a = 1234 is in the first chunk of the copy. The
+  // log must refer to the row in the stored table.
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  const auto get_table = std::make_shared<GetTable>("int_float");
+  get_table->set_excluded_chunk_ids({ChunkID{0}});
+  const auto validate = std::make_shared<Validate>(get_table);
+  const auto table_scan = create_table_scan(validate, ColumnID{0}, PredicateCondition::Equals, 1234);
+  const auto delete_op = std::make_shared<Delete>(table_scan);
+  for (const auto& op : std::vector<std::shared_ptr<AbstractOperator>>{get_table, validate, table_scan, delete_op}) {
+    op->set_transaction_context(transaction_context);
+    op->execute();
+  }
+  transaction_context->commit();
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+  EXPECT_EQ(expected_table->row_count(), 2u);
+
+  EXPECT_EQ(restart_and_recover(), 1u);
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+}
+
+TEST_F(LoggerTest, SkipIncompleteTransactions) {
+  Logger::get().enable(log_file_path);
+  execute_sql("INSERT INTO int_float VALUES (1, 1.5)");
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+
+  // A transaction without commit entry, e.g., because the system crashed before it committed
+  Logger::get().log_value(TransactionID{100}, "int_float", RowID{ChunkID{2}, ChunkOffset{1}}, {2, 2.5f});
+  Logger::get().flush();
+  Logger::get().disable();
+
+  // An entry that was only partially written
+  {
+    auto log_file = std::ofstream{log_file_path, std::ios::binary | std::ios::app};
+    log_file.put(static_cast<char>(LogEntryType::Commit));
+    log_file.put(char{100});
+  }
+
+  EXPECT_EQ(restart_and_recover(), 1u);
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+}
+
+TEST_F(LoggerTest, GroupCommit) {
+  Logger::get().enable(log_file_path);
+
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto TRANSACTIONS_PER_THREAD = 20;
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([thread_id]() {
+      for (auto transaction_id = 0; transaction_id < TRANSACTIONS_PER_THREAD; ++transaction_id) {
+        execute_sql("INSERT INTO int_float VALUES (" + std::to_string(thread_id) + ", 1.0)");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Each commit waits for its flush, but concurrent commits can share one
+  EXPECT_LE(Logger::get().flush_count(), static_cast<size_t>(THREAD_COUNT * TRANSACTIONS_PER_THREAD));
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+
+  EXPECT_EQ(restart_and_recover(), static_cast<size_t>(THREAD_COUNT * TRANSACTIONS_PER_THREAD));
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+}
+
+}  // namespace opossum
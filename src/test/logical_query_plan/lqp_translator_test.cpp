@@ -30,6 +30,7 @@
 #include "operators/aggregate.hpp"
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -380,6 +381,39 @@ TEST_F(LQPTranslatorTest, JoinNonEqui) {
   EXPECT_EQ(get_table_int_float->table_name(), "table_int_float");
 }
 
+TEST_F(LQPTranslatorTest, JoinBand) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * LQP resembles:
+   *   SELECT * FROM int_float JOIN int_float2 ON int_float.a > int_float2.a AND int_float.b <= int_float2.b
+   */
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Left, expression_vector(greater_than_(int_float_a, int_float2_a),
+                                                   less_than_equals_(int_float_b, int_float2_b)),
+    int_float_node, int_float2_node);
+  // clang-format on
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP
+   */
+  const auto join_band = std::dynamic_pointer_cast<JoinBand>(pqp);
+  ASSERT_TRUE(join_band);
+  EXPECT_EQ(join_band->mode(), JoinMode::Left);
+  EXPECT_EQ(join_band->primary_predicate().column_ids, ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(join_band->primary_predicate().predicate_condition, PredicateCondition::GreaterThan);
+  ASSERT_EQ(join_band->secondary_predicates().size(), 1u);
+  EXPECT_EQ(join_band->secondary_predicates().front().column_ids, ColumnIDPair(ColumnID{1}, ColumnID{1}));
+
+  // With an additional equi predicate, the join is not executed as a band join
+  const auto equi_lqp = JoinNode::make(
+      JoinMode::Inner, expression_vector(greater_than_(int_float_a, int_float2_a), equals_(int_float_b, int_float2_b)),
+      int_float_node, int_float2_node);
+  EXPECT_FALSE(std::dynamic_pointer_cast<JoinBand>(LQPTranslator{}.translate_node(equi_lqp)));
+}
+
 TEST_F(LQPTranslatorTest, LimitLiteral) {
   /**
    * Build LQP and translate to PQP
@@ -506,28 +540,35 @@ TEST_F(LQPTranslatorTest, PredicateNodeBinaryIndexScan) {
   EXPECT_EQ(*table_scan_op->predicate(), *between_(b, 42, 1337));
 }
 
-TEST_F(LQPTranslatorTest, PredicateNodeIndexScanFailsWhenNotApplicable) {
-  if (!HYRISE_DEBUG) GTEST_SKIP();
-
+TEST_F(LQPTranslatorTest, PredicateNodeIndexScanOnReferenceInput) {
   /**
    * Build LQP and translate to PQP
    */
   const auto stored_table_node = StoredTableNode::make("int_float_chunked");
 
   const auto table = StorageManager::get().get_table("int_float_chunked");
-  std::vector<ColumnID> index_column_ids = {ColumnID{1}};
-  std::vector<ChunkID> index_chunk_ids = {ChunkID{0}, ChunkID{2}};
-  table->get_chunk(index_chunk_ids[0])->create_index<GroupKeyIndex>(index_column_ids);
-  table->get_chunk(index_chunk_ids[1])->create_index<GroupKeyIndex>(index_column_ids);
+  std::vector<ColumnID> index_column_ids = {ColumnID{0}};
+  table->get_chunk(ChunkID{0})->create_index<GroupKeyIndex>(index_column_ids);
+  table->get_chunk(ChunkID{2})->create_index<GroupKeyIndex>(index_column_ids);
 
   auto predicate_node = PredicateNode::make(equals_(stored_table_node->get_column("b"), 42));
   predicate_node->set_left_input(stored_table_node);
   auto predicate_node2 = PredicateNode::make(less_than_(stored_table_node->get_column("a"), 42));
   predicate_node2->set_left_input(predicate_node);
-
-  // The optimizer should not set this ScanType in this situation
   predicate_node2->scan_type = ScanType::IndexScan;
-  EXPECT_THROW(LQPTranslator{}.translate_node(predicate_node2), std::logic_error);
+  const auto op = LQPTranslator{}.translate_node(predicate_node2);
+
+  /**
+   * Check PQP
+   */
+  // The input chunks are not known yet, so the IndexScan handles the referenced chunks without an index by itself
+  const auto index_scan_op = std::dynamic_pointer_cast<const IndexScan>(op);
+  ASSERT_TRUE(index_scan_op);
+  EXPECT_TRUE(get_included_chunk_ids(index_scan_op).empty());
+
+  const auto table_scan_op = std::dynamic_pointer_cast<const TableScan>(op->input_left());
+  ASSERT_TRUE(table_scan_op);
+  EXPECT_EQ(*table_scan_op->predicate(), *equals_(PQPColumnExpression::from_table(*table, "b"), 42));
 }
 
 TEST_F(LQPTranslatorTest, ProjectionNode) {
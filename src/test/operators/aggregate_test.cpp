@@ -93,6 +93,26 @@ class OperatorsAggregateTest : public BaseTest {
     _table_wrapper_1_1_null_dict = std::make_shared<TableWrapper>(std::move(test_table));
     _table_wrapper_1_1_null_dict->execute();
 
+    // Larger chunks so that the run-length encoded group-by column contains runs longer than one row
+    test_table = load_table("resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/input.tbl", 10);
+    ChunkEncoder::encode_all_chunks(test_table, SegmentEncodingSpec{EncodingType::RunLength});
+
+    _table_wrapper_1_1_run_length = std::make_shared<TableWrapper>(std::move(test_table));
+    _table_wrapper_1_1_run_length->execute();
+
+    test_table = load_table("resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/input_null.tbl", 10);
+    ChunkEncoder::encode_all_chunks(test_table, SegmentEncodingSpec{EncodingType::RunLength});
+
+    _table_wrapper_1_1_null_run_length = std::make_shared<TableWrapper>(std::move(test_table));
+    _table_wrapper_1_1_null_run_length->execute();
+
+    // An int aggregate column with runs that span several groups and chunks, including runs of NULLs
+    test_table = load_table("resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/input_int_runs.tbl", 10);
+    ChunkEncoder::encode_all_chunks(test_table, SegmentEncodingSpec{EncodingType::RunLength});
+
+    _table_wrapper_1_1_int_run_length = std::make_shared<TableWrapper>(std::move(test_table));
+    _table_wrapper_1_1_int_run_length->execute();
+
     _table_wrapper_int_int = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int.tbl", 2));
     _table_wrapper_int_int->execute();
   }
@@ -129,7 +149,8 @@ class OperatorsAggregateTest : public BaseTest {
       _table_wrapper_join_2, _table_wrapper_1_2, _table_wrapper_2_1, _table_wrapper_2_2, _table_wrapper_2_0_null,
       _table_wrapper_3_1, _table_wrapper_3_2, _table_wrapper_3_0_null, _table_wrapper_1_1_string,
       _table_wrapper_1_1_string_null, _table_wrapper_1_1_dict, _table_wrapper_1_1_null_dict, _table_wrapper_2_0_a,
-      _table_wrapper_2_o_b, _table_wrapper_int_int;
+      _table_wrapper_2_o_b, _table_wrapper_int_int, _table_wrapper_1_1_run_length, _table_wrapper_1_1_null_run_length,
+      _table_wrapper_1_1_int_run_length;
 };
 
 TEST_F(OperatorsAggregateTest, OperatorName) {
@@ -496,6 +517,67 @@ TEST_F(OperatorsAggregateTest, DictionarySingleAggregateCountWithNull) {
                     "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/count_null.tbl", 1, false);
 }
 
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateMax) {
+  this->test_output(_table_wrapper_1_1_run_length, {{ColumnID{1}, AggregateFunction::Max}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/max.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateMin) {
+  this->test_output(_table_wrapper_1_1_run_length, {{ColumnID{1}, AggregateFunction::Min}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/min.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateSum) {
+  this->test_output(_table_wrapper_1_1_run_length, {{ColumnID{1}, AggregateFunction::Sum}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/sum.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateAvg) {
+  this->test_output(_table_wrapper_1_1_run_length, {{ColumnID{1}, AggregateFunction::Avg}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/avg.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateCount) {
+  this->test_output(_table_wrapper_1_1_run_length, {{ColumnID{1}, AggregateFunction::Count}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/count.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateMaxWithNull) {
+  this->test_output(_table_wrapper_1_1_null_run_length, {{ColumnID{1}, AggregateFunction::Max}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/max_null.tbl", 1, false);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateSumWithNull) {
+  this->test_output(_table_wrapper_1_1_null_run_length, {{ColumnID{1}, AggregateFunction::Sum}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/sum_null.tbl", 1, false);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateCountWithNull) {
+  this->test_output(_table_wrapper_1_1_null_run_length, {{ColumnID{1}, AggregateFunction::Count}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/count_null.tbl", 1, false);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthSingleAggregateCountDistinctWithNull) {
+  this->test_output(_table_wrapper_1_1_null_run_length, {{ColumnID{1}, AggregateFunction::CountDistinct}},
+                    {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/count_distinct_null.tbl", 1, false);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthIntAggregateSum) {
+  this->test_output(_table_wrapper_1_1_int_run_length, {{ColumnID{1}, AggregateFunction::Sum}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/sum_int_runs.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthIntAggregateAvg) {
+  this->test_output(_table_wrapper_1_1_int_run_length, {{ColumnID{1}, AggregateFunction::Avg}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/avg_int_runs.tbl", 1);
+}
+
+TEST_F(OperatorsAggregateTest, RunLengthIntAggregateCount) {
+  this->test_output(_table_wrapper_1_1_int_run_length, {{ColumnID{1}, AggregateFunction::Count}}, {ColumnID{0}},
+                    "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/count_int_runs.tbl", 1);
+}
+
 /**
  * Tests for empty tables
  */
@@ -347,6 +347,9 @@ TEST_F(OperatorsDeleteTest, PrunedInputTable) {
   EXPECT_EQ(_table2->get_chunk(ChunkID{1})->get_scoped_mvcc_data_lock()->end_cids.at(2u), MvccData::MAX_COMMIT_ID);
   EXPECT_EQ(_table2->get_chunk(ChunkID{2})->get_scoped_mvcc_data_lock()->end_cids.at(0u), MvccData::MAX_COMMIT_ID);
   EXPECT_EQ(_table2->get_chunk(ChunkID{2})->get_scoped_mvcc_data_lock()->end_cids.at(1u), expected_end_cid);
+
+  // The stored table is marked as modified, so that cached results that read it are invalidated
+  EXPECT_EQ(_table2->last_commit_id(), expected_end_cid);
 }
 
 }  // namespace opossum
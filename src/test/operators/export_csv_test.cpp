@@ -1,6 +1,8 @@
 #include <cstdio>
 #include <fstream>
+#include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -11,6 +13,9 @@
 #include "operators/export_csv.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
@@ -210,6 +215,38 @@ TEST_F(OperatorsExportCsvTest, ExportAllTypes) {
   EXPECT_TRUE(compare_file(test_filename, "1,\"Hallo\",3.5,12,2.333\n"));
 }
 
+TEST_F(OperatorsExportCsvTest, ParallelChunksInOrder) {
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int);
+  column_definitions.emplace_back("b", DataType::Long);
+  column_definitions.emplace_back("c", DataType::Double, true);
+
+  auto new_table = std::make_shared<Table>(column_definitions, TableType::Data, 3);
+  auto expected_content = std::string{};
+  for (auto row = int32_t{0}; row < 100; ++row) {
+    const auto c = row % 7 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{row / 4.0};
+    new_table->append({-row, std::numeric_limits<int64_t>::min() + row, c});
+
+    std::stringstream line;
+    line << -row << "," << std::numeric_limits<int64_t>::min() + row << ",";
+    if (row % 7 != 0) line << row / 4.0;
+    expected_content += line.str() + "\n";
+  }
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(new_table));
+  table_wrapper->execute();
+  auto ex = std::make_shared<opossum::ExportCsv>(table_wrapper, test_filename);
+  ex->execute();
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+
+  EXPECT_TRUE(compare_file(test_filename, expected_content));
+}
+
 TEST_F(OperatorsExportCsvTest, NonsensePath) {
   table->append({1, "hello", 3.5f});
   auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
@@ -214,6 +214,62 @@ TYPED_TEST(OperatorsIndexScanTest, SingleColumnScanOnlySomeChunks) {
   }
 }
 
+TYPED_TEST(OperatorsIndexScanTest, SingleColumnScanOnReferenceTable) {
+  // Removes the rows with a < 4
+  const auto table_scan =
+      this->create_table_scan(this->_int_int, ColumnID{1}, PredicateCondition::GreaterThanEquals, 104);
+  table_scan->execute();
+
+  const auto right_values = std::vector<AllTypeVariant>{AllTypeVariant{4}};
+  const auto right_values2 = std::vector<AllTypeVariant>{AllTypeVariant{9}};
+
+  std::map<PredicateCondition, std::vector<AllTypeVariant>> tests;
+  tests[PredicateCondition::Equals] = {104, 104};
+  tests[PredicateCondition::NotEquals] = {106, 108, 110, 112, 106, 108, 110, 112};
+  tests[PredicateCondition::LessThan] = {};
+  tests[PredicateCondition::LessThanEquals] = {104, 104};
+  tests[PredicateCondition::GreaterThan] = {106, 108, 110, 112, 106, 108, 110, 112};
+  tests[PredicateCondition::Between] = {104, 106, 108, 104, 106, 108};
+
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<IndexScan>(table_scan, this->_index_type, this->_column_ids, test.first, right_values,
+                                            right_values2);
+    scan->execute();
+
+    EXPECT_EQ(scan->get_output()->type(), TableType::References);
+    this->ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1u}, test.second);
+  }
+}
+
+TYPED_TEST(OperatorsIndexScanTest, SingleColumnScanOnReferenceTableWithUnindexedChunks) {
+  // Only the first of the two chunks has an index, the second one is scanned without it
+  auto table = load_table("resources/test_data/tbl/int_int_shuffled.tbl", 7);
+  ChunkEncoder::encode_all_chunks(table);
+  table->get_chunk(ChunkID{0})->template create_index<TypeParam>(this->_column_ids);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  const auto table_scan =
+      this->create_table_scan(table_wrapper, ColumnID{1}, PredicateCondition::GreaterThanEquals, 104);
+  table_scan->execute();
+
+  const auto right_values = std::vector<AllTypeVariant>{AllTypeVariant{4}};
+  const auto right_values2 = std::vector<AllTypeVariant>{AllTypeVariant{9}};
+
+  std::map<PredicateCondition, std::vector<AllTypeVariant>> tests;
+  tests[PredicateCondition::Equals] = {104, 104};
+  tests[PredicateCondition::GreaterThanEquals] = {104, 106, 108, 110, 112, 104, 106, 108, 110, 112};
+  tests[PredicateCondition::Between] = {104, 106, 108, 104, 106, 108};
+
+  for (const auto& test : tests) {
+    auto scan = std::make_shared<IndexScan>(table_scan, this->_index_type, this->_column_ids, test.first, right_values,
+                                            right_values2);
+    scan->execute();
+
+    this->ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1u}, test.second);
+  }
+}
+
 TYPED_TEST(OperatorsIndexScanTest, OperatorName) {
   const auto right_values = std::vector<AllTypeVariant>(this->_column_ids.size(), AllTypeVariant{0});
 
@@ -0,0 +1,88 @@
+#include "base_test.hpp"
+#include "logical_query_plan/jit_aware_lqp_translator.hpp"
+#include "operators/jit_operator/jit_execution_advisor.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+
+namespace opossum {
+
+class JitExecutionAdvisorTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    StorageManager::get().add_table("table_a", load_table("resources/test_data/tbl/int_int_int.tbl"));
+    JitExecutionAdvisor::get().clear();
+  }
+
+  std::shared_ptr<AbstractLQPNode> create_lqp(const std::string& sql) const {
+    return SQLPipelineBuilder(sql).create_pipeline_statement(nullptr).get_unoptimized_logical_plan();
+  }
+
+  void record_executions(const std::string& query_template, const bool used_jit, const size_t walltime_per_row) {
+    for (auto execution = size_t{0}; execution < JitExecutionAdvisor::MIN_SAMPLE_COUNT; ++execution) {
+      JitExecutionAdvisor::get().record_execution(query_template, used_jit, 10,
+                                                  std::chrono::nanoseconds{10 * walltime_per_row});
+    }
+  }
+};
+
+TEST_F(JitExecutionAdvisorTest, QueryTemplateIgnoresLiterals) {
+  const auto query_template = JitExecutionAdvisor::query_template(create_lqp("SELECT a + 1 FROM table_a WHERE a > 5"));
+
+  EXPECT_EQ(JitExecutionAdvisor::query_template(create_lqp("SELECT a + 2 FROM table_a WHERE a > 7")), query_template);
+  EXPECT_NE(JitExecutionAdvisor::query_template(create_lqp("SELECT a + 1 FROM table_a WHERE b > 5")), query_template);
+  EXPECT_NE(JitExecutionAdvisor::query_template(create_lqp("SELECT a - 1 FROM table_a WHERE a > 5")), query_template);
+}
+
+TEST_F(JitExecutionAdvisorTest, OnlyLargeOrHotTemplatesAreJittedInitially) {
+  auto& jit_execution_advisor = JitExecutionAdvisor::get();
+
+  EXPECT_TRUE(jit_execution_advisor.should_use_jit("large", JitExecutionAdvisor::MIN_JIT_ROW_COUNT));
+
+  for (auto decision = size_t{1}; decision < JitExecutionAdvisor::HOT_EXECUTION_COUNT; ++decision) {
+    EXPECT_FALSE(jit_execution_advisor.should_use_jit("small", 10));
+  }
+  EXPECT_TRUE(jit_execution_advisor.should_use_jit("small", 10));
+  EXPECT_EQ(jit_execution_advisor.statistics("small").decision_count, JitExecutionAdvisor::HOT_EXECUTION_COUNT);
+
+  // Once the jitted pipeline has been measured, the regular operators are measured for comparison
+  record_executions("large", true, 1);
+  EXPECT_FALSE(jit_execution_advisor.should_use_jit("large", JitExecutionAdvisor::MIN_JIT_ROW_COUNT));
+}
+
+TEST_F(JitExecutionAdvisorTest, FasterVariantIsChosen) {
+  auto& jit_execution_advisor = JitExecutionAdvisor::get();
+
+  record_executions("jit_is_faster", true, 1);
+  record_executions("jit_is_faster", false, 2);
+  record_executions("jit_is_slower", true, 2);
+  record_executions("jit_is_slower", false, 1);
+
+  EXPECT_TRUE(jit_execution_advisor.should_use_jit("jit_is_faster", 10));
+  EXPECT_FALSE(jit_execution_advisor.should_use_jit("jit_is_slower", JitExecutionAdvisor::MIN_JIT_ROW_COUNT));
+
+  // The other variant is executed once in a while
+  for (auto decision = size_t{2}; decision < JitExecutionAdvisor::EXPLORATION_INTERVAL; ++decision) {
+    EXPECT_TRUE(jit_execution_advisor.should_use_jit("jit_is_faster", 10));
+  }
+  EXPECT_FALSE(jit_execution_advisor.should_use_jit("jit_is_faster", 10));
+}
+
+TEST_F(JitExecutionAdvisorTest, AdaptiveExecutionUsesRegularOperatorsForSmallInputs) {
+  const auto lqp = create_lqp("SELECT a + b FROM table_a WHERE a > 0");
+
+  const auto pqp = JitAwareLQPTranslator{JitExecutionMode::Adaptive}.translate_node(lqp);
+  CurrentScheduler::schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp, CleanupTemporaries::No));
+
+  const auto expected_pqp = LQPTranslator{}.translate_node(lqp);
+  CurrentScheduler::schedule_and_wait_for_tasks(
+      OperatorTask::make_tasks_from_operator(expected_pqp, CleanupTemporaries::No));
+
+  EXPECT_TABLE_EQ_UNORDERED(pqp->get_output(), expected_pqp->get_output());
+
+  const auto statistics = JitExecutionAdvisor::get().statistics(JitExecutionAdvisor::query_template(lqp));
+  EXPECT_EQ(statistics.regular.execution_count, 1u);
+  EXPECT_EQ(statistics.jit.execution_count, 0u);
+}
+
+}  // namespace opossum
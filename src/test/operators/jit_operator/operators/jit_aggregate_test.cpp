@@ -1,3 +1,4 @@
+#include <optional>
 #include <random>
 
 #include "base_test.hpp"
@@ -246,6 +247,66 @@ TEST_F(JitAggregateTest, CorrectlyComputesAggregates) {
                                 FloatComparisonMode::AbsoluteDifference));
 }
 
+// Check that the groups and aggregates of multiple workers are merged in the order of the workers.
+TEST_F(JitAggregateTest, MergesWorkerContexts) {
+  const auto tuple_entry_a = JitTupleEntry(DataType::Int, true, 0);
+  const auto tuple_entry_b = JitTupleEntry(DataType::Int, true, 1);
+
+  _aggregate->add_groupby_column("groupby", tuple_entry_a);
+  _aggregate->add_aggregate_column("count", tuple_entry_b, AggregateFunction::Count);
+  _aggregate->add_aggregate_column("sum", tuple_entry_b, AggregateFunction::Sum);
+  _aggregate->add_aggregate_column("max", tuple_entry_b, AggregateFunction::Max);
+  _aggregate->add_aggregate_column("min", tuple_entry_b, AggregateFunction::Min);
+  _aggregate->add_aggregate_column("avg", tuple_entry_b, AggregateFunction::Avg);
+
+  auto output_table = _aggregate->create_output_table(Table{TableColumnDefinitions{}, TableType::Data});
+
+  JitRuntimeContext context;
+  _aggregate->before_query(*output_table, context);
+
+  const auto emit = [&](JitRuntimeContext& worker_context, const std::optional<int32_t> a,
+                        const std::optional<int32_t> b) {
+    tuple_entry_a.set_is_null(!a, worker_context);
+    if (a) tuple_entry_a.set<int32_t>(*a, worker_context);
+    tuple_entry_b.set_is_null(!b, worker_context);
+    if (b) tuple_entry_b.set<int32_t>(*b, worker_context);
+    _source->emit(worker_context);
+  };
+
+  JitRuntimeContext first_worker_context;
+  first_worker_context.tuple.resize(2);
+  _aggregate->before_query(*output_table, first_worker_context);
+  emit(first_worker_context, 1, 1);
+  emit(first_worker_context, std::nullopt, std::nullopt);
+  emit(first_worker_context, 1, 2);
+
+  JitRuntimeContext second_worker_context;
+  second_worker_context.tuple.resize(2);
+  _aggregate->before_query(*output_table, second_worker_context);
+  emit(second_worker_context, 2, 5);
+  emit(second_worker_context, 1, 10);
+  emit(second_worker_context, std::nullopt, 3);
+
+  _aggregate->merge_worker_context(context, first_worker_context);
+  _aggregate->merge_worker_context(context, second_worker_context);
+  _aggregate->after_query(*output_table, context);
+
+  const auto expected_column_definitions = TableColumnDefinitions({{"groupby", DataType::Int, true},
+                                                                   {"count", DataType::Long, false},
+                                                                   {"sum", DataType::Long, true},
+                                                                   {"max", DataType::Int, true},
+                                                                   {"min", DataType::Int, true},
+                                                                   {"avg", DataType::Double, true}});
+
+  auto expected_output_table = std::make_shared<Table>(expected_column_definitions, TableType::Data);
+  expected_output_table->append({1, 3, 13, 10, 1, 13.0 / 3.0});
+  expected_output_table->append({NullValue{}, 1, 3, 3, 3, 3.0});
+  expected_output_table->append({2, 1, 5, 5, 5, 5.0});
+
+  EXPECT_TRUE(check_table_equal(output_table, expected_output_table, OrderSensitivity::Yes, TypeCmpMode::Strict,
+                                FloatComparisonMode::AbsoluteDifference));
+}
+
 // Check the computation of aggregate values when there are no groupby columns.
 TEST_F(JitAggregateTest, NoGroupByColumns) {
   JitRuntimeContext context;
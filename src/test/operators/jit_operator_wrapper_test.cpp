@@ -277,4 +277,91 @@ TEST_F(JitOperatorWrapperTest, JitOperatorsSpecializedWithMultipleInliningOfSame
   ASSERT_EQ(result->get_value<int>(ColumnID(0), 1), 48);
 }
 
+TEST_F(JitOperatorWrapperTest, CompiledPipelinesAreShared) {
+  JitCodeCache::get().clear();
+
+  // Creates a pipeline that computes a+a
+  const auto create_jit_operator_wrapper = [&](const JitExecutionMode execution_mode) {
+    auto read_operator = std::make_shared<JitReadTuples>();
+    auto tuple_entry = read_operator->add_input_column(DataType::Int, false, ColumnID(0));
+    auto column_expression = std::make_shared<JitExpression>(tuple_entry);
+    auto result_tuple_index = read_operator->add_temporary_value();
+    auto expression = std::make_shared<JitExpression>(column_expression, JitExpressionType::Addition,
+                                                      column_expression, result_tuple_index);
+    auto write_operator = std::make_shared<JitWriteTuples>();
+    write_operator->add_output_column_definition("a+a", expression->result_entry());
+
+    auto jit_operator_wrapper = std::make_shared<JitOperatorWrapper>(_int_table_wrapper, execution_mode);
+    jit_operator_wrapper->add_jit_operator(read_operator);
+    jit_operator_wrapper->add_jit_operator(std::make_shared<JitCompute>(expression));
+    jit_operator_wrapper->add_jit_operator(write_operator);
+    return jit_operator_wrapper;
+  };
+
+  const auto first_jit_operator_wrapper = create_jit_operator_wrapper(JitExecutionMode::Compile);
+  first_jit_operator_wrapper->execute();
+  EXPECT_EQ(JitCodeCache::get().size(), 1u);
+
+  // The second pipeline has the same signature and reuses the compiled code
+  const auto second_jit_operator_wrapper = create_jit_operator_wrapper(JitExecutionMode::Compile);
+  second_jit_operator_wrapper->execute();
+  EXPECT_EQ(JitCodeCache::get().size(), 1u);
+  EXPECT_TABLE_EQ_ORDERED(second_jit_operator_wrapper->get_output(), first_jit_operator_wrapper->get_output());
+
+  // Pipelines that are compiled in the background are interpreted until the compiled code is available
+  JitCodeCache::get().clear();
+  const auto background_jit_operator_wrapper = create_jit_operator_wrapper(JitExecutionMode::CompileInBackground);
+  background_jit_operator_wrapper->execute();
+  EXPECT_TABLE_EQ_ORDERED(background_jit_operator_wrapper->get_output(), first_jit_operator_wrapper->get_output());
+
+  JitCodeCache::get().wait_for_background_compilations();
+  EXPECT_EQ(JitCodeCache::get().size(), 1u);
+
+  const auto compiled_jit_operator_wrapper = create_jit_operator_wrapper(JitExecutionMode::CompileInBackground);
+  compiled_jit_operator_wrapper->execute();
+  EXPECT_TABLE_EQ_ORDERED(compiled_jit_operator_wrapper->get_output(), first_jit_operator_wrapper->get_output());
+}
+
+TEST_F(JitOperatorWrapperTest, CompiledPipelinesAreEvicted) {
+  JitCodeCache::get().clear();
+  JitCodeCache::get().resize(1);
+
+  // Creates a pipeline that computes a+a or a*a, which have different signatures
+  const auto create_jit_operator_wrapper = [&](const JitExpressionType expression_type) {
+    auto read_operator = std::make_shared<JitReadTuples>();
+    auto tuple_entry = read_operator->add_input_column(DataType::Int, false, ColumnID(0));
+    auto column_expression = std::make_shared<JitExpression>(tuple_entry);
+    auto result_tuple_index = read_operator->add_temporary_value();
+    auto expression =
+        std::make_shared<JitExpression>(column_expression, expression_type, column_expression, result_tuple_index);
+    auto write_operator = std::make_shared<JitWriteTuples>();
+    write_operator->add_output_column_definition("result", expression->result_entry());
+
+    auto jit_operator_wrapper = std::make_shared<JitOperatorWrapper>(_int_table_wrapper, JitExecutionMode::Compile);
+    jit_operator_wrapper->add_jit_operator(read_operator);
+    jit_operator_wrapper->add_jit_operator(std::make_shared<JitCompute>(expression));
+    jit_operator_wrapper->add_jit_operator(write_operator);
+    return jit_operator_wrapper;
+  };
+
+  const auto addition_jit_operator_wrapper = create_jit_operator_wrapper(JitExpressionType::Addition);
+  addition_jit_operator_wrapper->execute();
+  EXPECT_EQ(JitCodeCache::get().size(), 1u);
+
+  // The pipeline of the addition is evicted, but remains usable by the query that compiled it
+  const auto multiplication_jit_operator_wrapper = create_jit_operator_wrapper(JitExpressionType::Multiplication);
+  multiplication_jit_operator_wrapper->execute();
+  EXPECT_EQ(JitCodeCache::get().size(), 1u);
+  EXPECT_EQ(addition_jit_operator_wrapper->get_output()->get_value<int>(ColumnID(0), 1), 48);
+  EXPECT_EQ(multiplication_jit_operator_wrapper->get_output()->get_value<int>(ColumnID(0), 1), 576);
+
+  // Without capacity, nothing is cached
+  JitCodeCache::get().clear();
+  JitCodeCache::get().resize(0);
+  create_jit_operator_wrapper(JitExpressionType::Addition)->execute();
+  EXPECT_EQ(JitCodeCache::get().size(), 0u);
+
+  JitCodeCache::get().resize(JitCodeCache::DEFAULT_CAPACITY);
+}
+
 }  // namespace opossum
@@ -0,0 +1,203 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "constant_mappings.hpp"
+#include "operators/join_band.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+/**
+ * The results of the JoinBand are compared with those of the JoinNestedLoop, which evaluates all pairs of rows.
+ */
+class JoinBandTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // The events have a point in time and a name
+    const auto events = std::make_shared<Table>(
+        TableColumnDefinitions{{"t", DataType::Int, true}, {"name", DataType::String, false}}, TableType::Data, 32);
+    for (auto row_id = 0; row_id < 300; ++row_id) {
+      const auto name = pmr_string{"event_" + std::to_string(row_id % 17)};
+      if (row_id % 23 == 0) {
+        events->append({NULL_VALUE, name});
+      } else {
+        events->append({(row_id * 37) % 500, name});
+      }
+    }
+
+    // The intervals have a start, an end, and a name. Some of the intervals contain a single point in time.
+    const auto intervals = std::make_shared<Table>(TableColumnDefinitions{{"start", DataType::Int, false},
+                                                                          {"end", DataType::Int, false},
+                                                                          {"name", DataType::String, false}},
+                                                   TableType::Data, 8);
+    for (auto row_id = 0; row_id < 40; ++row_id) {
+      const auto start = (row_id * 53) % 500;
+      intervals->append({start, start + (row_id % 4) * 10, pmr_string{"event_" + std::to_string(row_id % 13)}});
+    }
+
+    _events = std::make_shared<TableWrapper>(events);
+    _events->execute();
+    _intervals = std::make_shared<TableWrapper>(intervals);
+    _intervals->execute();
+  }
+
+  void _test_join(const std::shared_ptr<AbstractOperator>& left, const std::shared_ptr<AbstractOperator>& right,
+                  const JoinMode mode, const OperatorJoinPredicate& primary_predicate,
+                  const std::vector<OperatorJoinPredicate>& secondary_predicates = {}) const {
+    SCOPED_TRACE(join_mode_to_string.at(mode));
+
+    const auto join_band = std::make_shared<JoinBand>(left, right, mode, primary_predicate, secondary_predicates);
+    join_band->execute();
+
+    const auto nested_loop =
+        std::make_shared<JoinNestedLoop>(left, right, mode, primary_predicate, secondary_predicates);
+    nested_loop->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(join_band->get_output(), nested_loop->get_output());
+  }
+
+  std::shared_ptr<TableWrapper> _events;
+  std::shared_ptr<TableWrapper> _intervals;
+
+  const std::vector<JoinMode> _join_modes{JoinMode::Inner,     JoinMode::Left, JoinMode::Right,
+                                          JoinMode::FullOuter, JoinMode::Semi, JoinMode::AntiNullAsFalse};
+};
+
+TEST_F(JoinBandTest, Supports) {
+  EXPECT_TRUE(JoinBand::supports(JoinMode::Inner, PredicateCondition::LessThan, DataType::Int, DataType::Int));
+  EXPECT_TRUE(JoinBand::supports(JoinMode::Semi, PredicateCondition::GreaterThanEquals, DataType::String,
+                                 DataType::String));
+  EXPECT_FALSE(JoinBand::supports(JoinMode::Inner, PredicateCondition::Equals, DataType::Int, DataType::Int));
+  EXPECT_FALSE(JoinBand::supports(JoinMode::Inner, PredicateCondition::NotEquals, DataType::Int, DataType::Int));
+  EXPECT_FALSE(JoinBand::supports(JoinMode::AntiNullAsTrue, PredicateCondition::LessThan, DataType::Int,
+                                  DataType::Int));
+  EXPECT_FALSE(JoinBand::supports(JoinMode::Inner, PredicateCondition::LessThan, DataType::Int, DataType::Float));
+}
+
+TEST_F(JoinBandTest, SingleInequality) {
+  for (const auto predicate_condition : {PredicateCondition::LessThan, PredicateCondition::LessThanEquals,
+                                         PredicateCondition::GreaterThan, PredicateCondition::GreaterThanEquals}) {
+    SCOPED_TRACE(predicate_condition_to_string.left.at(predicate_condition));
+    const auto predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, predicate_condition};
+
+    for (const auto mode : _join_modes) {
+      // As the smaller input is sorted, this covers sorting the right and the left input
+      _test_join(_events, _intervals, mode, predicate);
+      _test_join(_intervals, _events, mode, predicate);
+    }
+  }
+}
+
+TEST_F(JoinBandTest, StringInequality) {
+  const auto predicate = OperatorJoinPredicate{{ColumnID{1}, ColumnID{2}}, PredicateCondition::LessThan};
+  for (const auto mode : _join_modes) {
+    _test_join(_events, _intervals, mode, predicate);
+  }
+}
+
+TEST_F(JoinBandTest, BandJoin) {
+  // events.t BETWEEN intervals.start AND intervals.end, with the events as the sorted side
+  const auto lower_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const auto upper_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThanEquals};
+
+  // The same band, with the events as the right input
+  const auto flipped_lower_bound =
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThanEquals};
+  const auto flipped_upper_bound =
+      OperatorJoinPredicate{{ColumnID{1}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+
+  for (const auto mode : _join_modes) {
+    _test_join(_events, _intervals, mode, lower_bound, {upper_bound});
+    _test_join(_intervals, _events, mode, flipped_lower_bound, {flipped_upper_bound});
+  }
+}
+
+TEST_F(JoinBandTest, BandJoinWithAdditionalPredicates) {
+  const auto lower_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThan};
+  const auto upper_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThan};
+  const auto same_name = OperatorJoinPredicate{{ColumnID{1}, ColumnID{2}}, PredicateCondition::Equals};
+  const auto different_name = OperatorJoinPredicate{{ColumnID{1}, ColumnID{2}}, PredicateCondition::NotEquals};
+
+  for (const auto mode : _join_modes) {
+    _test_join(_events, _intervals, mode, lower_bound, {same_name, upper_bound});
+    _test_join(_events, _intervals, mode, lower_bound, {different_name, upper_bound});
+  }
+}
+
+TEST_F(JoinBandTest, ReferenceSegments) {
+  const auto events_scan = create_table_scan(_events, ColumnID{0}, PredicateCondition::GreaterThan, 100);
+  events_scan->execute();
+  const auto intervals_scan = create_table_scan(_intervals, ColumnID{1}, PredicateCondition::LessThan, 400);
+  intervals_scan->execute();
+
+  const auto lower_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const auto upper_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThanEquals};
+  for (const auto mode : _join_modes) {
+    _test_join(events_scan, intervals_scan, mode, lower_bound, {upper_bound});
+  }
+}
+
+TEST_F(JoinBandTest, EmptyInput) {
+  const auto empty_scan = create_table_scan(_intervals, ColumnID{0}, PredicateCondition::LessThan, 0);
+  empty_scan->execute();
+  ASSERT_EQ(empty_scan->get_output()->row_count(), 0u);
+
+  const auto predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThan};
+  for (const auto mode : _join_modes) {
+    _test_join(_events, empty_scan, mode, predicate);
+    _test_join(empty_scan, _events, mode, predicate);
+  }
+}
+
+TEST_F(JoinBandTest, ParallelExecution) {
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto lower_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const auto upper_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThanEquals};
+  const auto less_than = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThan};
+  for (const auto mode : _join_modes) {
+    _test_join(_events, _intervals, mode, lower_bound, {upper_bound});
+    _test_join(_intervals, _events, mode, less_than);
+  }
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+TEST_F(JoinBandTest, DeepCopy) {
+  const auto lower_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const auto upper_bound = OperatorJoinPredicate{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThanEquals};
+  const auto join = std::make_shared<JoinBand>(_events, _intervals, JoinMode::Inner, lower_bound,
+                                               std::vector<OperatorJoinPredicate>{upper_bound});
+  join->execute();
+
+  const auto copied_join = join->deep_copy();
+  copied_join->mutable_input_left()->execute();
+  copied_join->mutable_input_right()->execute();
+  copied_join->execute();
+  EXPECT_TABLE_EQ_UNORDERED(copied_join->get_output(), join->get_output());
+}
+
+TEST_F(JoinBandTest, UnsupportedJoins) {
+  const auto less_than = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThan};
+  const auto equals = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  EXPECT_THROW(std::make_shared<JoinBand>(_events, _intervals, JoinMode::AntiNullAsTrue, less_than),
+               std::logic_error);
+  EXPECT_THROW(std::make_shared<JoinBand>(_events, _intervals, JoinMode::Inner, equals), std::logic_error);
+
+  // The columns of the primary predicate must have the same data type
+  const auto different_types = OperatorJoinPredicate{{ColumnID{0}, ColumnID{2}}, PredicateCondition::LessThan};
+  const auto join = std::make_shared<JoinBand>(_events, _intervals, JoinMode::Inner, different_types);
+  EXPECT_THROW(join->execute(), std::logic_error);
+}
+
+}  // namespace opossum
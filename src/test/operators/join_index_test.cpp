@@ -9,6 +9,7 @@
 
 #include "all_type_variant.hpp"
 #include "operators/join_index.hpp"
+#include "operators/join_nested_loop.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "storage/chunk_encoder.hpp"
@@ -16,6 +17,8 @@
 #include "storage/index/b_tree/b_tree_index.hpp"
 #include "storage/index/group_key/composite_group_key_index.hpp"
 #include "storage/index/group_key/group_key_index.hpp"
+#include "storage/index/table_hash_index.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
@@ -101,10 +104,21 @@ class JoinIndexTest : public BaseTest {
 
     EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
     const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
-    if (using_index && right->get_output()->type() == TableType::Data) {
-      // We can't execute the index join on referencing tables
-      EXPECT_EQ(performance_data.chunks_scanned_with_index, static_cast<size_t>(right->get_output()->chunk_count()));
-      EXPECT_EQ(performance_data.chunks_scanned_without_index, 0);
+    if (using_index) {
+      // On referencing tables, the index of the referenced chunk can only be used if all positions point into it
+      const auto right_table = right->get_output();
+      auto indexed_chunk_count = size_t{0};
+      for (ChunkID chunk_id{0}; chunk_id < right_table->chunk_count(); ++chunk_id) {
+        if (right_table->type() == TableType::Data) {
+          ++indexed_chunk_count;
+          continue;
+        }
+        const auto segment = std::static_pointer_cast<const ReferenceSegment>(
+            right_table->get_chunk(chunk_id)->get_segment(primary_predicate.column_ids.second));
+        if (segment->pos_list()->references_single_chunk() && !segment->pos_list()->empty()) ++indexed_chunk_count;
+      }
+      EXPECT_EQ(performance_data.chunks_scanned_with_index, indexed_chunk_count);
+      EXPECT_EQ(performance_data.chunks_scanned_without_index, right_table->chunk_count() - indexed_chunk_count);
     } else {
       EXPECT_EQ(performance_data.chunks_scanned_with_index, 0);
       EXPECT_EQ(performance_data.chunks_scanned_without_index, static_cast<size_t>(right->get_output()->chunk_count()));
@@ -191,6 +205,27 @@ TYPED_TEST(JoinIndexTest, InnerRefJoinFiltered) {
                          "resources/test_data/tbl/join_operators/int_inner_join_filtered.tbl", 1);
 }
 
+TYPED_TEST(JoinIndexTest, InnerJoinOnFilteredReferenceRight) {
+  // Removes (123, 458.7), which the index of the referenced chunk still contains
+  auto scan_b = this->create_table_scan(this->_table_wrapper_b, ColumnID{1}, PredicateCondition::LessThan, 458.0f);
+  scan_b->execute();
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  auto join = std::make_shared<JoinIndex>(this->_table_wrapper_a, scan_b, JoinMode::Inner, primary_predicate);
+  join->execute();
+
+  const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
+  EXPECT_EQ(performance_data.chunks_scanned_with_index, 2u);
+  EXPECT_EQ(performance_data.chunks_scanned_without_index, 0u);
+
+  auto reference_join =
+      std::make_shared<JoinNestedLoop>(this->_table_wrapper_a, scan_b, JoinMode::Inner, primary_predicate);
+  reference_join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 2u);
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), reference_join->get_output());
+}
+
 TYPED_TEST(JoinIndexTest, InnerDictJoin) {
   this->test_join_output(this->_table_wrapper_a, this->_table_wrapper_b,
                          {{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals}, JoinMode::Inner,
@@ -533,4 +568,39 @@ TYPED_TEST(JoinIndexTest, LeftJoinEmptyRefSegment) {
                          JoinMode::Left, "resources/test_data/tbl/join_operators/int_join_empty_left.tbl", 1);
 }
 
+class JoinIndexHashIndexTest : public BaseTest {};
+
+TEST_F(JoinIndexHashIndexTest, SkipRowsIndexedAfterInputWasProduced) {
+  // int_int2.tbl holds (7, 0), (2, 5), (6, 16) in the first and (2, 5) in the second chunk
+  const auto table = load_table("resources/test_data/tbl/int_int2.tbl", 3);
+  const auto hash_index = table->create_hash_index({ColumnID{0}});
+
+  const auto left = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int3.tbl", 3));
+  left->execute();
+  const auto right = std::make_shared<TableWrapper>(table);
+  right->execute();
+
+  // An Insert indexes its rows before the join reads the input, but the rows are not part of the input: (7, 2, 6) are
+  // indexed past the end of the second chunk and in a third chunk that does not exist yet
+  const auto pending_rows = load_table("resources/test_data/tbl/int_int2.tbl", 3);
+  hash_index->insert(ChunkID{1}, *pending_rows->get_chunk(ChunkID{0}), ChunkOffset{1}, ChunkOffset{3});
+  hash_index->insert(ChunkID{2}, *pending_rows->get_chunk(ChunkID{0}), ChunkOffset{0}, ChunkOffset{3});
+
+  const auto reference_right = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int2.tbl", 3));
+  reference_right->execute();
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  for (const auto mode : {JoinMode::Inner, JoinMode::Right, JoinMode::FullOuter}) {
+    const auto join = std::make_shared<JoinIndex>(left, right, mode, primary_predicate);
+    join->execute();
+
+    const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
+    EXPECT_EQ(performance_data.chunks_scanned_without_index, 0u);
+
+    const auto reference_join = std::make_shared<JoinNestedLoop>(left, reference_right, mode, primary_predicate);
+    reference_join->execute();
+    EXPECT_TABLE_EQ_UNORDERED(join->get_output(), reference_join->get_output());
+  }
+}
+
 }  // namespace opossum
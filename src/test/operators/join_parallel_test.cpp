@@ -0,0 +1,120 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "constant_mappings.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+/**
+ * Compares the results of the JoinSortMerge and the JoinNestedLoop executed by multiple workers with those of the
+ * single-threaded JoinNestedLoop. The left input is large enough to be split into several clusters by the
+ * JoinSortMerge.
+ */
+class JoinParallelTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // The left table contains the values 0..10'239 (and some NULLs) in a random order
+    const auto left_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}},
+                                                    TableType::Data, 1'000);
+    for (auto row_id = 0; row_id < 8'192; ++row_id) {
+      if (row_id % 97 == 0) {
+        left_table->append({NULL_VALUE});
+      } else {
+        left_table->append({(row_id * 7'919) % 10'240});
+      }
+    }
+
+    // Each row of the right table describes a band [low, high] of six values
+    const auto right_table = std::make_shared<Table>(
+        TableColumnDefinitions{{"low", DataType::Int, false}, {"high", DataType::Int, false}}, TableType::Data, 100);
+    for (auto row_id = 0; row_id < 256; ++row_id) {
+      right_table->append({row_id * 41, row_id * 41 + 5});
+    }
+
+    _table_wrapper_left = std::make_shared<TableWrapper>(left_table);
+    _table_wrapper_left->execute();
+    _table_wrapper_right = std::make_shared<TableWrapper>(right_table);
+    _table_wrapper_right->execute();
+  }
+
+  template <typename JoinType>
+  std::shared_ptr<const Table> _join(const JoinMode mode, const OperatorJoinPredicate& primary_predicate,
+                                     const std::vector<OperatorJoinPredicate>& secondary_predicates = {}) const {
+    const auto join = std::make_shared<JoinType>(_table_wrapper_left, _table_wrapper_right, mode, primary_predicate,
+                                                 secondary_predicates);
+    join->execute();
+    return join->get_output();
+  }
+
+  template <typename JoinType>
+  void _test_parallel_join(const JoinMode mode, const OperatorJoinPredicate& primary_predicate,
+                           const std::vector<OperatorJoinPredicate>& secondary_predicates = {}) const {
+    const auto expected_result = _join<JoinNestedLoop>(mode, primary_predicate, secondary_predicates);
+
+    Topology::use_fake_numa_topology(8, 4);
+    CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+    const auto result = _join<JoinType>(mode, primary_predicate, secondary_predicates);
+
+    CurrentScheduler::get()->finish();
+    CurrentScheduler::set(nullptr);
+
+    // The output is written in parallel, one chunk per job
+    EXPECT_GT(result->chunk_count(), 1u);
+    EXPECT_TABLE_EQ_UNORDERED(result, expected_result);
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_left;
+  std::shared_ptr<TableWrapper> _table_wrapper_right;
+
+  // a = low
+  const OperatorJoinPredicate _equals_predicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+
+  // a BETWEEN low AND high
+  const OperatorJoinPredicate _lower_band_predicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const std::vector<OperatorJoinPredicate> _upper_band_predicates{
+      {{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThanEquals}};
+};
+
+TEST_F(JoinParallelTest, SortMergeEquiJoin) {
+  for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Right, JoinMode::FullOuter}) {
+    SCOPED_TRACE(join_mode_to_string.at(mode));
+    _test_parallel_join<JoinSortMerge>(mode, _equals_predicate);
+  }
+}
+
+TEST_F(JoinParallelTest, SortMergeBandJoin) {
+  for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Right, JoinMode::FullOuter}) {
+    SCOPED_TRACE(join_mode_to_string.at(mode));
+    _test_parallel_join<JoinSortMerge>(mode, _lower_band_predicate, _upper_band_predicates);
+  }
+}
+
+TEST_F(JoinParallelTest, NestedLoopBandJoin) {
+  for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Right, JoinMode::FullOuter, JoinMode::Semi,
+                          JoinMode::AntiNullAsFalse}) {
+    SCOPED_TRACE(join_mode_to_string.at(mode));
+    _test_parallel_join<JoinNestedLoop>(mode, _lower_band_predicate, _upper_band_predicates);
+  }
+}
+
+TEST_F(JoinParallelTest, NestedLoopDeepCopyKeepsSecondaryPredicates) {
+  const auto join = std::make_shared<JoinNestedLoop>(_table_wrapper_left, _table_wrapper_right, JoinMode::Inner,
+                                                     _lower_band_predicate, _upper_band_predicates);
+  const auto copied_join = join->deep_copy();
+  copied_join->mutable_input_left()->execute();
+  copied_join->mutable_input_right()->execute();
+  copied_join->execute();
+  join->execute();
+  EXPECT_TABLE_EQ_UNORDERED(copied_join->get_output(), join->get_output());
+}
+
+}  // namespace opossum
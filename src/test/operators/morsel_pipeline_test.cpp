@@ -0,0 +1,140 @@
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/morsel_aware_lqp_translator.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/union_node.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+#include "scheduler/topology.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class MorselPipelineTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    StorageManager::get().add_table("table_a", load_table("resources/test_data/tbl/int_int_int.tbl", 2));
+  }
+
+  std::shared_ptr<AbstractLQPNode> create_lqp(const std::string& sql) const {
+    return SQLPipelineBuilder(sql).create_pipeline_statement(nullptr).get_unoptimized_logical_plan();
+  }
+
+  std::shared_ptr<const Table> execute_pqp(const std::shared_ptr<AbstractOperator>& pqp) const {
+    CurrentScheduler::schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp, CleanupTemporaries::No));
+    return pqp->get_output();
+  }
+};
+
+TEST_F(MorselPipelineTest, ChainsArePipelined) {
+  const auto lqp = create_lqp("SELECT a + b AS sum FROM table_a WHERE a > 9 AND c < 12");
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(lqp);
+
+  // Everything above the GetTable operator is pipelined
+  const auto morsel_pipeline = std::dynamic_pointer_cast<MorselPipeline>(pqp);
+  ASSERT_TRUE(morsel_pipeline);
+  EXPECT_EQ(morsel_pipeline->input_left()->type(), OperatorType::GetTable);
+
+  const auto expected_result = execute_pqp(LQPTranslator{}.translate_node(lqp));
+  EXPECT_TABLE_EQ_ORDERED(execute_pqp(pqp), expected_result);
+}
+
+TEST_F(MorselPipelineTest, ChainsAreExecutedInParallel) {
+  const auto lqp = create_lqp("SELECT a * 2 FROM table_a WHERE b >= 10");
+  const auto expected_result = execute_pqp(LQPTranslator{}.translate_node(lqp));
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(lqp);
+  ASSERT_EQ(pqp->type(), OperatorType::MorselPipeline);
+  const auto result = execute_pqp(pqp);
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+
+  EXPECT_TABLE_EQ_ORDERED(result, expected_result);
+}
+
+TEST_F(MorselPipelineTest, EmptyInput) {
+  StorageManager::get().add_table("empty_table", Table::create_dummy_table({{"a", DataType::Int, false}}));
+
+  const auto lqp = create_lqp("SELECT a + 1 FROM empty_table WHERE a > 0");
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(lqp);
+  ASSERT_EQ(pqp->type(), OperatorType::MorselPipeline);
+
+  const auto result = execute_pqp(pqp);
+  EXPECT_EQ(result->row_count(), 0u);
+  EXPECT_EQ(result->column_count(), 1u);
+}
+
+TEST_F(MorselPipelineTest, DeepCopySharesPipeline) {
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(create_lqp("SELECT a + 1 FROM table_a WHERE a > 9"));
+  const auto copied_pqp = pqp->deep_copy();
+  ASSERT_EQ(copied_pqp->type(), OperatorType::MorselPipeline);
+  EXPECT_EQ(std::static_pointer_cast<MorselPipeline>(copied_pqp)->pipeline_root(),
+            std::static_pointer_cast<MorselPipeline>(pqp)->pipeline_root());
+
+  EXPECT_TABLE_EQ_ORDERED(execute_pqp(copied_pqp), execute_pqp(pqp));
+}
+
+TEST_F(MorselPipelineTest, JoinAbovePipeline) {
+  const auto left_node = StoredTableNode::make("table_a");
+  const auto right_node = StoredTableNode::make("table_a");
+
+  // Each morsel contains a single chunk, but the join must see the RowIDs of the input table. The second morsel would
+  // otherwise reference the first chunk.
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(left_node->get_column("a"), right_node->get_column("c")),
+    PredicateNode::make(greater_than_(left_node->get_column("a"), 8),
+      PredicateNode::make(greater_than_(left_node->get_column("c"), 9),
+        left_node)),
+    right_node);
+  // clang-format on
+
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(lqp);
+  ASSERT_EQ(pqp->input_left()->type(), OperatorType::MorselPipeline);
+
+  const auto result = execute_pqp(pqp);
+  EXPECT_TABLE_EQ_UNORDERED(result, execute_pqp(LQPTranslator{}.translate_node(lqp)));
+  EXPECT_EQ(result->row_count(), 4u);
+}
+
+TEST_F(MorselPipelineTest, SingleOperatorsAreNotPipelined) {
+  const auto stored_table_node = StoredTableNode::make("table_a");
+  const auto a = stored_table_node->get_column("a");
+  const auto b = stored_table_node->get_column("b");
+  const auto c = stored_table_node->get_column("c");
+
+  const auto single_predicate_lqp = PredicateNode::make(greater_than_(a, 9), stored_table_node);
+  EXPECT_EQ(MorselAwareLQPTranslator{}.translate_node(single_predicate_lqp)->type(), OperatorType::TableScan);
+
+  // UnionPositions compares the RowIDs of the stored table, which the MorselPipelines preserve
+  // clang-format off
+  const auto union_lqp =
+  UnionNode::make(UnionMode::Positions,
+    PredicateNode::make(greater_than_(a, 9),
+      PredicateNode::make(less_than_(c, 12),
+        stored_table_node)),
+    PredicateNode::make(less_than_(b, 11),
+      PredicateNode::make(greater_than_(c, 9),
+        stored_table_node)));
+  // clang-format on
+
+  const auto pqp = MorselAwareLQPTranslator{}.translate_node(union_lqp);
+  ASSERT_EQ(pqp->type(), OperatorType::UnionPositions);
+  EXPECT_EQ(pqp->input_left()->type(), OperatorType::MorselPipeline);
+  EXPECT_EQ(pqp->input_right()->type(), OperatorType::MorselPipeline);
+
+  EXPECT_TABLE_EQ_UNORDERED(execute_pqp(pqp), execute_pqp(LQPTranslator{}.translate_node(union_lqp)));
+}
+
+}  // namespace opossum
@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 #include "base_test.hpp"
@@ -7,6 +9,7 @@
 #include "expression/expression_functional.hpp"
 #include "operators/difference.hpp"
 #include "operators/get_table.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/join_mpsm.hpp"
 #include "operators/join_nested_loop.hpp"
@@ -55,18 +58,22 @@ template <typename T>
 class DeepCopyTestJoin : public OperatorDeepCopyTest {};
 
 // here we define all Join types
-using JoinTypes = ::testing::Types<JoinNestedLoop, JoinHash, JoinSortMerge, JoinMPSM>;
+using JoinTypes = ::testing::Types<JoinNestedLoop, JoinHash, JoinSortMerge, JoinMPSM, JoinBand>;
 TYPED_TEST_CASE(DeepCopyTestJoin, JoinTypes, );  // NOLINT(whitespace/parens)
 
 TYPED_TEST(DeepCopyTestJoin, DeepCopyJoin) {
-  std::shared_ptr<Table> expected_result =
-      load_table("resources/test_data/tbl/join_operators/int_left_join_equals.tbl", 1);
+  // JoinBand only supports inequality predicates
+  const auto is_band_join = std::is_same_v<TypeParam, JoinBand>;
+  const auto predicate_condition = is_band_join ? PredicateCondition::LessThan : PredicateCondition::Equals;
+  const auto expected_result_path = std::string{"resources/test_data/tbl/join_operators/"} +
+                                    (is_band_join ? "int_left_join_lt.tbl" : "int_left_join_equals.tbl");
+
+  std::shared_ptr<Table> expected_result = load_table(expected_result_path, 1);
   EXPECT_NE(expected_result, nullptr) << "Could not load expected result table";
 
   // build and execute join
-  auto join =
-      std::make_shared<TypeParam>(this->_table_wrapper_a, this->_table_wrapper_b, JoinMode::Left,
-                                  OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  auto join = std::make_shared<TypeParam>(this->_table_wrapper_a, this->_table_wrapper_b, JoinMode::Left,
+                                          OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, predicate_condition});
   EXPECT_NE(join, nullptr) << "Could not build Join";
   join->execute();
   EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
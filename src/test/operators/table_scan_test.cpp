@@ -27,6 +27,7 @@
 #include "storage/encoding_type.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
+#include "type_comparison.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -891,4 +892,52 @@ TEST_P(OperatorsTableScanTest, TwoBigScans) {
   }
 }
 
+TEST_P(OperatorsTableScanTest, ScanOnMultipleBlocksAndRuns) {
+  // The chunk spans several frame-of-reference blocks (2048 rows each) with far apart minima and contains runs of
+  // three equal values. Every eleventh row is NULL. The scan results are checked against the rows' values.
+  auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+  const auto data_table = std::make_shared<Table>(column_definitions, TableType::Data, 5'000);
+
+  const auto value_of_row = [](const int32_t row) { return (row / 2'048) * 1'000'000 + row / 3; };
+  for (auto row = 0; row < 5'000; ++row) {
+    if (row % 11 == 10) {
+      data_table->append({NullValue{}});
+    } else {
+      data_table->append({value_of_row(row)});
+    }
+  }
+  ChunkEncoder::encode_all_chunks(data_table, SegmentEncodingSpec{_encoding_type});
+
+  auto data_table_wrapper = std::make_shared<TableWrapper>(data_table);
+  data_table_wrapper->execute();
+
+  const auto predicate_conditions =
+      std::vector<PredicateCondition>{PredicateCondition::Equals,      PredicateCondition::NotEquals,
+                                      PredicateCondition::LessThan,    PredicateCondition::LessThanEquals,
+                                      PredicateCondition::GreaterThan, PredicateCondition::GreaterThanEquals};
+  const auto search_values = std::vector<int32_t>{-1, 0, 300, 1'000'682, 1'500'000, 2'001'000, 3'000'000};
+
+  for (const auto predicate_condition : predicate_conditions) {
+    for (const auto search_value : search_values) {
+      auto expected_row_count = size_t{0};
+      with_comparator(predicate_condition, [&](auto comparator) {
+        for (auto row = 0; row < 5'000; ++row) {
+          if (row % 11 != 10 && comparator(value_of_row(row), search_value)) ++expected_row_count;
+        }
+      });
+
+      auto scan = create_table_scan(data_table_wrapper, ColumnID{0}, predicate_condition, search_value);
+      scan->execute();
+
+      const auto& result_table = scan->get_output();
+      EXPECT_EQ(result_table->row_count(), expected_row_count);
+      for (auto row = size_t{0}; row < result_table->row_count(); ++row) {
+        with_comparator(predicate_condition, [&](auto comparator) {
+          EXPECT_TRUE(comparator(result_table->get_value<int32_t>(ColumnID{0}, row), search_value));
+        });
+      }
+    }
+  }
+}
+
 }  // namespace opossum
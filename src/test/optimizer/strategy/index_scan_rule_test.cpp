@@ -9,9 +9,12 @@
 
 #include "expression/abstract_expression.hpp"
 #include "expression/expression_functional.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
 #include "logical_query_plan/mock_node.hpp"
 #include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
 #include "optimizer/strategy/index_scan_rule.hpp"
 #include "optimizer/strategy/strategy_base_test.hpp"
 #include "statistics/column_statistics.hpp"
@@ -168,4 +171,44 @@ TEST_F(IndexScanRuleTest, IndexScanOnlyOnOutputOfStoredTableNode) {
   EXPECT_EQ(predicate_node_1->scan_type, ScanType::TableScan);
 }
 
+TEST_F(IndexScanRuleTest, IndexScanAboveOtherPredicate) {
+  table->create_index<GroupKeyIndex>({ColumnID{2}});
+
+  auto statistics_mock = generate_mock_statistics(1'000'000);
+  table->set_table_statistics(statistics_mock);
+
+  auto predicate_node_0 = PredicateNode::make(less_than_(b, 15));
+  predicate_node_0->set_left_input(stored_table_node);
+
+  auto predicate_node_1 = PredicateNode::make(greater_than_(c, 19'900));
+  predicate_node_1->set_left_input(predicate_node_0);
+
+  // The index yields ~5'000 rows of the stored table, which are intersected with the ~750'000 input rows
+  auto reordered = StrategyBaseTest::apply_rule(rule, predicate_node_1);
+  EXPECT_EQ(predicate_node_0->scan_type, ScanType::TableScan);
+  EXPECT_EQ(predicate_node_1->scan_type, ScanType::IndexScan);
+}
+
+TEST_F(IndexScanRuleTest, NoIndexScanAboveAggregateOrProjection) {
+  table->create_hash_index({ColumnID{0}});
+
+  // The group-by column of the aggregate and the column forwarded by the projection originate from the stored table,
+  // but their rows are not those of the stored table
+  const auto aggregate_node =
+      AggregateNode::make(expression_vector(a), expression_vector(count_star_()), stored_table_node);
+  const auto predicate_node_0 = PredicateNode::make(equals_(a, 5), aggregate_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_0);
+  EXPECT_EQ(predicate_node_0->scan_type, ScanType::TableScan);
+
+  const auto projection_node = ProjectionNode::make(expression_vector(b, a), stored_table_node);
+  const auto predicate_node_1 = PredicateNode::make(equals_(a, 5), projection_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_1);
+  EXPECT_EQ(predicate_node_1->scan_type, ScanType::TableScan);
+
+  // Below a ValidateNode, the stored table's rows are still referenced
+  const auto predicate_node_2 = PredicateNode::make(equals_(a, 5), ValidateNode::make(stored_table_node));
+  StrategyBaseTest::apply_rule(rule, predicate_node_2);
+  EXPECT_EQ(predicate_node_2->scan_type, ScanType::IndexScan);
+}
+
 }  // namespace opossum
@@ -0,0 +1,163 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "../../plugins/mvcc_delete_plugin.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/base_encoded_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class MvccDeletePluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _table = load_table("resources/test_data/tbl/int_float.tbl", 3u);
+    StorageManager::get().add_table("int_float", _table);
+
+    // Fill a second chunk, so that the first one can be compacted into a new one
+    _execute_sql("INSERT INTO int_float VALUES (1, 1.0), (2, 2.0), (3, 3.0)");
+  }
+
+ protected:
+  static void _execute_sql(const std::string& sql) {
+    auto sql_pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    sql_pipeline.get_result_table();
+  }
+
+  static bool _delete_chunk_logically(const std::string& table_name, const ChunkID chunk_id) {
+    return MvccDeletePlugin::_delete_chunk_logically(table_name, chunk_id);
+  }
+
+  static bool _delete_chunk_physically(const std::shared_ptr<Table>& table, const ChunkID chunk_id) {
+    return MvccDeletePlugin::_delete_chunk_physically(table, chunk_id);
+  }
+
+  static void _run_logical_delete_loop() { MvccDeletePlugin::get()._logical_delete_loop(); }
+
+  static void _add_logically_deleted_chunk(const std::string& table_name, const std::shared_ptr<Table>& table,
+                                           const ChunkID chunk_id) {
+    MvccDeletePlugin::get()._logically_deleted_chunks.emplace_back(
+        MvccDeletePlugin::LogicallyDeletedChunk{table_name, table, chunk_id});
+  }
+
+  static size_t _logically_deleted_chunk_count() { return MvccDeletePlugin::get()._logically_deleted_chunks.size(); }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(MvccDeletePluginTest, LogicalAndPhysicalDelete) {
+  _execute_sql("DELETE FROM int_float WHERE a = 123 OR a = 1234");
+  ASSERT_EQ(_table->chunk_count(), 2u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{0})->invalid_row_count(), 2u);
+
+  // A transaction that started before the logical delete might still read the old chunk
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+
+  // The remaining row of the first chunk is moved to the end of the table
+  EXPECT_TRUE(_delete_chunk_logically("int_float", ChunkID{0}));
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  ASSERT_EQ(_table->chunk_count(), 3u);
+  EXPECT_TRUE(chunk->get_cleanup_commit_id());
+  EXPECT_EQ(chunk->invalid_row_count(), chunk->size());
+  EXPECT_EQ(_table->get_chunk(ChunkID{2})->size(), 1u);
+
+  EXPECT_FALSE(_delete_chunk_physically(_table, ChunkID{0}));
+  EXPECT_NE(_table->get_chunk(ChunkID{0}), nullptr);
+
+  transaction_context->commit();
+  transaction_context = nullptr;
+  EXPECT_TRUE(_delete_chunk_physically(_table, ChunkID{0}));
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}), nullptr);
+
+  auto sql_pipeline = SQLPipelineBuilder{"SELECT * FROM int_float"}.create_pipeline();
+  const auto expected_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  expected_table->append({12345, 458.7f});
+  expected_table->append({1, 1.0f});
+  expected_table->append({2, 2.0f});
+  expected_table->append({3, 3.0f});
+  EXPECT_TABLE_EQ_UNORDERED(sql_pipeline.get_result_table(), expected_table);
+}
+
+TEST_F(MvccDeletePluginTest, LogicalDeleteConflict) {
+  _execute_sql("DELETE FROM int_float WHERE a = 123 OR a = 1234");
+
+  // An uncommitted delete of the remaining row prevents moving it
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto sql_pipeline = SQLPipelineBuilder{"DELETE FROM int_float WHERE a = 12345"}
+                          .with_transaction_context(transaction_context)
+                          .create_pipeline();
+  sql_pipeline.get_result_table();
+
+  EXPECT_FALSE(_delete_chunk_logically("int_float", ChunkID{0}));
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->get_cleanup_commit_id());
+  EXPECT_EQ(_table->chunk_count(), 2u);
+
+  transaction_context->rollback();
+}
+
+TEST_F(MvccDeletePluginTest, NoLogicalDeleteWithUncommittedInsert) {
+  _execute_sql("INSERT INTO int_float VALUES (4, 4.0), (5, 5.0)");
+  _execute_sql("DELETE FROM int_float WHERE a = 4 OR a = 5");
+
+  // The uncommitted insert fills up the third chunk, two thirds of which are invalidated
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto sql_pipeline = SQLPipelineBuilder{"INSERT INTO int_float VALUES (6, 6.0)"}
+                          .with_transaction_context(transaction_context)
+                          .create_pipeline();
+  sql_pipeline.get_result_table();
+  ASSERT_EQ(_table->chunk_count(), 3u);
+  ASSERT_EQ(_table->get_chunk(ChunkID{2})->size(), 3u);
+  ASSERT_EQ(_table->get_chunk(ChunkID{2})->invalid_row_count(), 2u);
+
+  EXPECT_FALSE(_delete_chunk_logically("int_float", ChunkID{2}));
+  _run_logical_delete_loop();
+  EXPECT_FALSE(_table->get_chunk(ChunkID{2})->get_cleanup_commit_id());
+  EXPECT_EQ(_logically_deleted_chunk_count(), 0u);
+
+  transaction_context->commit();
+  MvccDeletePlugin::get().stop();
+
+  auto select_pipeline = SQLPipelineBuilder{"SELECT * FROM int_float WHERE a = 6"}.create_pipeline();
+  EXPECT_EQ(select_pipeline.get_result_table()->row_count(), 1u);
+}
+
+TEST_F(MvccDeletePluginTest, CompactedChunksAreEncodedAlike) {
+  ChunkEncoder::encode_chunks(_table, {ChunkID{0}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  _execute_sql("DELETE FROM int_float WHERE a = 123");
+  _execute_sql("INSERT INTO int_float VALUES (4, 4.0)");
+
+  // The moved rows fill up the third chunk, which is then encoded like the first one
+  EXPECT_TRUE(_delete_chunk_logically("int_float", ChunkID{0}));
+  ASSERT_EQ(_table->chunk_count(), 3u);
+  const auto chunk = _table->get_chunk(ChunkID{2});
+  EXPECT_EQ(chunk->size(), 3u);
+  EXPECT_FALSE(chunk->is_mutable());
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(ColumnID{0})));
+}
+
+TEST_F(MvccDeletePluginTest, StopDeletesLogicallyDeletedChunks) {
+  _execute_sql("DELETE FROM int_float WHERE a = 123 OR a = 1234");
+
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  ASSERT_TRUE(_delete_chunk_logically("int_float", ChunkID{0}));
+  _add_logically_deleted_chunk("int_float", _table, ChunkID{0});
+
+  // The chunk is still visible to the active transaction, so it is kept for the next start
+  MvccDeletePlugin::get().stop();
+  EXPECT_NE(_table->get_chunk(ChunkID{0}), nullptr);
+  EXPECT_EQ(_logically_deleted_chunk_count(), 1u);
+
+  transaction_context->commit();
+  transaction_context = nullptr;
+  MvccDeletePlugin::get().stop();
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}), nullptr);
+  EXPECT_EQ(_logically_deleted_chunk_count(), 0u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/ordered_job_window.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+class OrderedJobWindowTest : public BaseTest {
+ protected:
+  // Adds 100 items whose tasks store their index and checks that they are finished in order with a bounded number of
+  // items in flight
+  static void test_ordered_and_bounded() {
+    auto added_count = size_t{0};
+    auto finished_items = std::vector<size_t>{};
+    auto max_in_flight_count = size_t{0};
+
+    auto window = OrderedJobWindow<size_t>{[&](size_t& item) {
+      max_in_flight_count = std::max(max_in_flight_count, added_count - finished_items.size());
+      finished_items.emplace_back(item);
+    }};
+
+    for (auto index = size_t{0}; index < 100; ++index) {
+      ++added_count;
+      window.add(size_t{0}, [&, index](size_t& item) {
+        const auto task = std::make_shared<JobTask>([&item, index]() { item = index; });
+        return std::vector<std::shared_ptr<AbstractTask>>{task};
+      });
+    }
+    window.finish_all();
+
+    ASSERT_EQ(finished_items.size(), 100u);
+    for (auto index = size_t{0}; index < 100; ++index) {
+      EXPECT_EQ(finished_items[index], index);
+    }
+    EXPECT_EQ(max_in_flight_count, window.max_pending_items() + 1);
+  }
+};
+
+TEST_F(OrderedJobWindowTest, WithoutScheduler) {
+  test_ordered_and_bounded();
+  EXPECT_EQ(OrderedJobWindow<size_t>{[](size_t&) {}}.max_pending_items(),
+            OrderedJobWindow<size_t>::MAX_PENDING_ITEMS_PER_WORKER);
+}
+
+TEST_F(OrderedJobWindowTest, WithScheduler) {
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  test_ordered_and_bounded();
+  EXPECT_EQ(OrderedJobWindow<size_t>{[](size_t&) {}}.max_pending_items(),
+            OrderedJobWindow<size_t>::MAX_PENDING_ITEMS_PER_WORKER * Topology::get().num_cpus());
+
+  CurrentScheduler::get()->finish();
+}
+
+}  // namespace opossum
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include "cache/cache.hpp"
+#include "concurrency/transaction_manager.hpp"
 #include "logical_query_plan/join_node.hpp"
 #include "operators/abstract_join_operator.hpp"
 #include "operators/print.hpp"
@@ -555,6 +556,170 @@ TEST_F(SQLPipelineStatementTest, CacheQueryPlan) {
   EXPECT_TRUE(cache.has(_select_query_a));
 }
 
+TEST_F(SQLPipelineStatementTest, ParameterizedPlanCache) {
+  auto statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 9 AND b > 5"}
+                       .with_parameterized_plan_cache(UseParameterizedPlanCache::Yes)
+                       .create_pipeline_statement();
+  statement.get_result_table();
+  EXPECT_FALSE(statement.metrics()->parameterized_plan_cache_hit);
+  EXPECT_EQ(SQLParameterizedPlanCache::get().size(), 1u);
+
+  // Only the literals differ, so the generic plan is reused without optimizing the query again
+  auto other_statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 10 AND b > 7"}
+                             .with_parameterized_plan_cache(UseParameterizedPlanCache::Yes)
+                             .create_pipeline_statement();
+  const auto& table = other_statement.get_result_table();
+  EXPECT_TRUE(other_statement.metrics()->parameterized_plan_cache_hit);
+  EXPECT_FALSE(other_statement.metrics()->query_plan_cache_hit);
+  EXPECT_EQ(other_statement.metrics()->optimization_duration, std::chrono::nanoseconds::zero());
+  EXPECT_EQ(SQLParameterizedPlanCache::get().size(), 1u);
+
+  auto expected_table = std::make_shared<Table>(_int_int_int_column_definitions, TableType::Data);
+  expected_table->append({10, 10, 10});
+  EXPECT_TABLE_EQ_UNORDERED(table, expected_table);
+
+  // Without the SQLParameterizedPlanCache, a query with new literals is optimized again
+  auto uncached_statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 11 AND b > 7"}
+                                .create_pipeline_statement();
+  uncached_statement.get_result_table();
+  EXPECT_FALSE(uncached_statement.metrics()->parameterized_plan_cache_hit);
+  EXPECT_GT(uncached_statement.metrics()->optimization_duration, std::chrono::nanoseconds::zero());
+}
+
+TEST_F(SQLPipelineStatementTest, ParameterizedPlanCacheInvalidation) {
+  const auto run_statement = [](const std::string& sql) {
+    auto statement = SQLPipelineBuilder{sql}
+                         .with_parameterized_plan_cache(UseParameterizedPlanCache::Yes)
+                         .create_pipeline_statement();
+    const auto row_count = statement.get_result_table()->row_count();
+    return std::make_pair(statement.metrics()->parameterized_plan_cache_hit, row_count);
+  };
+
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 9"), std::make_pair(false, uint64_t{2}));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(true, uint64_t{1}));
+
+  // Replacing the table invalidates the plan
+  StorageManager::get().drop_table("table_int");
+  StorageManager::get().add_table("table_int", load_table("resources/test_data/tbl/int_int_int.tbl", 2));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 11"), std::make_pair(false, uint64_t{1}));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 12"), std::make_pair(true, uint64_t{0}));
+
+  // So does a row count that more than doubled
+  for (auto row = 0; row < 5; ++row) {
+    SQLPipelineBuilder{"INSERT INTO table_int VALUES (12, 12, 12)"}.create_pipeline_statement().get_result_table();
+  }
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 12"), std::make_pair(false, uint64_t{5}));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 9"), std::make_pair(true, uint64_t{2}));
+}
+
+TEST_F(SQLPipelineStatementTest, DDLClearsPlanCaches) {
+  SQLPipelineBuilder{_select_query_a}.create_pipeline_statement().get_result_table();
+  EXPECT_EQ(SQLPhysicalPlanCache::get().size(), 1u);
+
+  auto create_view_statement =
+      SQLPipelineBuilder{"CREATE VIEW table_a_view AS SELECT * FROM table_a"}.create_pipeline_statement();
+  create_view_statement.get_result_table();
+  EXPECT_EQ(SQLPhysicalPlanCache::get().size(), 0u);
+  EXPECT_EQ(SQLLogicalPlanCache::get().size(), 0u);
+}
+
+TEST_F(SQLPipelineStatementTest, ResultCache) {
+  auto statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 10"}
+                       .with_result_cache(UseResultCache::Yes)
+                       .create_pipeline_statement();
+  const auto table = statement.get_result_table();
+  EXPECT_FALSE(statement.metrics()->result_cache_hit);
+  EXPECT_EQ(SQLQueryResultCache::get().size(), 1u);
+
+  // Statements that only differ in their formatting share the result, which is returned without creating a plan
+  auto cached_statement = SQLPipelineBuilder{"SELECT *  FROM table_int\nWHERE a = 10"}
+                              .with_result_cache(UseResultCache::Yes)
+                              .create_pipeline_statement();
+  EXPECT_EQ(cached_statement.get_result_table(), table);
+  EXPECT_TRUE(cached_statement.metrics()->result_cache_hit);
+  EXPECT_FALSE(cached_statement.transaction_context());
+  EXPECT_EQ(cached_statement.metrics()->plan_execution_duration, std::chrono::nanoseconds::zero());
+
+  // Different literals, disabled result caches, and explicit transactions do not use the cached result
+  auto other_statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 9"}
+                             .with_result_cache(UseResultCache::Yes)
+                             .create_pipeline_statement();
+  EXPECT_EQ(other_statement.get_result_table()->row_count(), 2u);
+  EXPECT_FALSE(other_statement.metrics()->result_cache_hit);
+
+  auto uncached_statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 10"}.create_pipeline_statement();
+  uncached_statement.get_result_table();
+  EXPECT_FALSE(uncached_statement.metrics()->result_cache_hit);
+
+  auto transaction_statement = SQLPipelineBuilder{"SELECT * FROM table_int WHERE a = 10"}
+                                   .with_result_cache(UseResultCache::Yes)
+                                   .with_transaction_context(TransactionManager::get().new_transaction_context())
+                                   .create_pipeline_statement();
+  transaction_statement.get_result_table();
+  EXPECT_FALSE(transaction_statement.metrics()->result_cache_hit);
+
+  // Results of statements with side effects are not cached
+  SQLPipelineBuilder{"INSERT INTO table_a VALUES (1, 2.0)"}
+      .with_result_cache(UseResultCache::Yes)
+      .create_pipeline_statement()
+      .get_result_table();
+  EXPECT_EQ(SQLQueryResultCache::get().size(), 2u);
+
+  // Floating-point literals that only differ beyond the sixth digit do not share a result
+  auto float_statement = SQLPipelineBuilder{"SELECT * FROM table_a WHERE b < 0.1234567"}
+                             .with_result_cache(UseResultCache::Yes)
+                             .create_pipeline_statement();
+  float_statement.get_result_table();
+  auto other_float_statement = SQLPipelineBuilder{"SELECT * FROM table_a WHERE b < 0.1234568"}
+                                   .with_result_cache(UseResultCache::Yes)
+                                   .create_pipeline_statement();
+  other_float_statement.get_result_table();
+  EXPECT_FALSE(other_float_statement.metrics()->result_cache_hit);
+}
+
+TEST_F(SQLPipelineStatementTest, ResultCacheInvalidation) {
+  const auto run_statement = [](const std::string& sql) {
+    auto statement = SQLPipelineBuilder{sql}.with_result_cache(UseResultCache::Yes).create_pipeline_statement();
+    const auto row_count = statement.get_result_table()->row_count();
+    return std::make_pair(statement.metrics()->result_cache_hit, row_count);
+  };
+  const auto subquery = std::string{"SELECT * FROM table_a WHERE a IN (SELECT a FROM table_int)"};
+
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(false, uint64_t{1}));
+  EXPECT_EQ(run_statement(subquery), std::make_pair(false, uint64_t{0}));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(true, uint64_t{1}));
+  EXPECT_EQ(run_statement(subquery), std::make_pair(true, uint64_t{0}));
+
+  // Modifying another table does not invalidate the result
+  SQLPipelineBuilder{"INSERT INTO table_b VALUES (1, 2.0)"}.create_pipeline_statement().get_result_table();
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(true, uint64_t{1}));
+
+  // Inserting into a table invalidates the results that read it, also in subqueries
+  SQLPipelineBuilder{"INSERT INTO table_int VALUES (10, 1, 1)"}.create_pipeline_statement().get_result_table();
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(false, uint64_t{2}));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(true, uint64_t{2}));
+  EXPECT_EQ(run_statement(subquery), std::make_pair(false, uint64_t{0}));
+
+  // So does deleting from it
+  SQLPipelineBuilder{"DELETE FROM table_int WHERE b = 1"}.create_pipeline_statement().get_result_table();
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(false, uint64_t{1}));
+
+  // Uncommitted modifications do not invalidate the result
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  SQLPipelineBuilder{"DELETE FROM table_int WHERE a = 10"}
+      .with_transaction_context(transaction_context)
+      .create_pipeline_statement()
+      .get_result_table();
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(true, uint64_t{1}));
+  transaction_context->commit();
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(false, uint64_t{0}));
+
+  // Replacing the table invalidates the result
+  StorageManager::get().drop_table("table_int");
+  StorageManager::get().add_table("table_int", load_table("resources/test_data/tbl/int_int_int.tbl", 2));
+  EXPECT_EQ(run_statement("SELECT * FROM table_int WHERE a = 10"), std::make_pair(false, uint64_t{1}));
+}
+
 TEST_F(SQLPipelineStatementTest, CopySubselectFromCache) {
   const auto subquery_query = "SELECT * FROM table_int WHERE a = (SELECT MAX(b) FROM table_int)";
 
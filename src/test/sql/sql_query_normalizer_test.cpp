@@ -0,0 +1,83 @@
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "sql/sql_query_normalizer.hpp"
+
+namespace opossum {
+
+class SQLQueryNormalizerTest : public BaseTest {};
+
+TEST_F(SQLQueryNormalizerTest, ExtractsComparisonLiterals) {
+  const auto normalized_query = normalize_sql_query("SELECT a FROM t WHERE a = 1 AND b >= 'it''s' OR c<>2.5");
+  ASSERT_TRUE(normalized_query);
+
+  EXPECT_EQ(normalized_query->sql, "SELECT a FROM t WHERE a = ? AND b >= ? OR c<>?");
+  ASSERT_EQ(normalized_query->parameter_values.size(), 3u);
+  EXPECT_EQ(normalized_query->parameter_values[0], AllTypeVariant{int32_t{1}});
+  EXPECT_EQ(normalized_query->parameter_values[1], AllTypeVariant{pmr_string{"it's"}});
+  EXPECT_EQ(normalized_query->parameter_values[2], AllTypeVariant{2.5});
+}
+
+TEST_F(SQLQueryNormalizerTest, ExtractsBetweenBounds) {
+  const auto normalized_query = normalize_sql_query("SELECT * FROM t WHERE a BETWEEN 1 AND 3000000000 AND b = 'x'");
+  ASSERT_TRUE(normalized_query);
+
+  EXPECT_EQ(normalized_query->sql, "SELECT * FROM t WHERE a BETWEEN ? AND ? AND b = ?");
+  ASSERT_EQ(normalized_query->parameter_values.size(), 3u);
+  EXPECT_EQ(normalized_query->parameter_values[0], AllTypeVariant{int32_t{1}});
+  EXPECT_EQ(normalized_query->parameter_values[1], AllTypeVariant{int64_t{3'000'000'000}});
+  EXPECT_EQ(normalized_query->parameter_values[2], AllTypeVariant{pmr_string{"x"}});
+}
+
+TEST_F(SQLQueryNormalizerTest, KeepsOtherLiterals) {
+  const auto normalized_query = normalize_sql_query(
+      "SELECT a + 1, 'x' FROM t JOIN u ON t.a = u.a AND u.b > 3 WHERE a IN (1, 2) AND b = c + 3 AND d > 4 * e AND "
+      "f = -5 AND g < '1995-01-01' + INTERVAL '1' DAY LIMIT 10");
+  ASSERT_TRUE(normalized_query);
+
+  EXPECT_EQ(normalized_query->sql,
+            "SELECT a + 1, 'x' FROM t JOIN u ON t.a = u.a AND u.b > ? WHERE a IN (1, 2) AND b = c + 3 AND d > 4 * e "
+            "AND f = -5 AND g < '1995-01-01' + INTERVAL '1' DAY LIMIT 10");
+  ASSERT_EQ(normalized_query->parameter_values.size(), 1u);
+  EXPECT_EQ(normalized_query->parameter_values[0], AllTypeVariant{int32_t{3}});
+}
+
+TEST_F(SQLQueryNormalizerTest, IgnoresFormatting) {
+  const auto normalized_query_a = normalize_sql_query("SELECT *  FROM t -- comment\n WHERE a = 1");
+  const auto normalized_query_b = normalize_sql_query("SELECT * /* comment */ FROM t\tWHERE a = 2");
+  ASSERT_TRUE(normalized_query_a);
+  ASSERT_TRUE(normalized_query_b);
+
+  EXPECT_EQ(normalized_query_a->sql, "SELECT * FROM t WHERE a = ?");
+  EXPECT_EQ(normalized_query_a->cache_key(), normalized_query_b->cache_key());
+}
+
+TEST_F(SQLQueryNormalizerTest, CacheKeyContainsDataTypes) {
+  const auto normalized_query_a = normalize_sql_query("SELECT * FROM t WHERE a = 1");
+  const auto normalized_query_b = normalize_sql_query("SELECT * FROM t WHERE a = 1.0");
+  ASSERT_TRUE(normalized_query_a);
+  ASSERT_TRUE(normalized_query_b);
+
+  EXPECT_EQ(normalized_query_a->sql, normalized_query_b->sql);
+  EXPECT_NE(normalized_query_a->cache_key(), normalized_query_b->cache_key());
+}
+
+TEST_F(SQLQueryNormalizerTest, UnsupportedQueries) {
+  // Nothing to extract
+  EXPECT_FALSE(normalize_sql_query("SELECT * FROM t"));
+  EXPECT_FALSE(normalize_sql_query("SELECT * FROM t WHERE a = b LIMIT 1"));
+
+  // No SELECT statement
+  EXPECT_FALSE(normalize_sql_query("DELETE FROM t WHERE a = 1"));
+  EXPECT_FALSE(normalize_sql_query("UPDATE t SET a = 1 WHERE b = 2"));
+
+  // Already contains placeholders
+  EXPECT_FALSE(normalize_sql_query("SELECT * FROM t WHERE a = ? AND b = 1"));
+
+  // Unterminated literals
+  EXPECT_FALSE(normalize_sql_query("SELECT * FROM t WHERE a = 'x"));
+}
+
+}  // namespace opossum
@@ -7,6 +7,10 @@
 #include "gtest/gtest.h"
 
 #include "all_type_variant.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "statistics/chunk_statistics/chunk_statistics.hpp"
 #include "storage/base_encoded_segment.hpp"
 #include "storage/base_value_segment.hpp"
 #include "storage/chunk.hpp"
@@ -146,4 +150,28 @@ TEST_F(ChunkEncoderTest, EncodeMultipleChunksUsingSameEncoding) {
   verify_encoding(_table->get_chunk(ChunkID{1u}), unencoded_chunk_spec);
 }
 
+TEST_F(ChunkEncoderTest, EncodeWholeTableInParallel) {
+  const auto chunk_encoding_specs = std::vector<ChunkEncodingSpec>{
+      {{EncodingType::Unencoded}, {EncodingType::RunLength}, {EncodingType::Dictionary}},
+      {{EncodingType::RunLength}, {EncodingType::FrameOfReference}, {EncodingType::Dictionary}},
+      {{EncodingType::Dictionary}, {EncodingType::RunLength}, {EncodingType::LZ4}}};
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  ChunkEncoder::encode_all_chunks(_table, chunk_encoding_specs);
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+
+  for (auto chunk_id = ChunkID{0u}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    const auto chunk = _table->get_chunk(chunk_id);
+    verify_encoding(chunk, chunk_encoding_specs.at(chunk_id));
+
+    EXPECT_FALSE(chunk->is_mutable());
+    ASSERT_NE(chunk->statistics(), nullptr);
+    EXPECT_EQ(chunk->statistics()->statistics().size(), chunk->column_count());
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,168 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "cache/gdfs_cache.hpp"
+#include "cache/lru_k_cache.hpp"
+#include "storage/decompressed_segment_cache.hpp"
+#include "storage/lz4_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class DecompressedSegmentCacheTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto& cache = DecompressedSegmentCache::get();
+    cache.resize(DecompressedSegmentCache::DEFAULT_CAPACITY);
+    cache.reset_metrics();
+  }
+
+  void TearDown() override {
+    auto& cache = DecompressedSegmentCache::get();
+    cache.replace_cache_impl<GDFSCache<DecompressedBlockKey, DecompressedSegmentCache::Block>>(
+        DecompressedSegmentCache::DEFAULT_CAPACITY);
+    cache.reset_metrics();
+  }
+
+  // Returns a decompression function that counts its invocations and fills the block with the given value
+  static auto decompress_with(const char value, size_t& decompression_count) {
+    return [value, &decompression_count](std::vector<char>& block) {
+      ++decompression_count;
+      block.assign(16, value);
+    };
+  }
+
+  // Accounted size of the blocks created by decompress_with
+  static constexpr auto block_size = 16 + DecompressedSegmentCache::BLOCK_OVERHEAD;
+};
+
+TEST_F(DecompressedSegmentCacheTest, HitsAndMisses) {
+  auto& cache = DecompressedSegmentCache::get();
+  auto decompression_count = size_t{0};
+
+  const auto block_a = cache.get_or_decompress({1, 0}, decompress_with('a', decompression_count));
+  const auto block_b = cache.get_or_decompress({1, 1}, decompress_with('b', decompression_count));
+  const auto block_a_again = cache.get_or_decompress({1, 0}, decompress_with('x', decompression_count));
+
+  EXPECT_EQ(decompression_count, 2u);
+  EXPECT_EQ(block_a, block_a_again);
+  EXPECT_EQ(block_a->at(0), 'a');
+  EXPECT_EQ(block_b->at(0), 'b');
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.size_in_bytes(), 2 * block_size);
+
+  const auto metrics = cache.metrics();
+  EXPECT_EQ(metrics.hits, 1u);
+  EXPECT_EQ(metrics.misses, 2u);
+  EXPECT_EQ(metrics.evictions, 0u);
+}
+
+TEST_F(DecompressedSegmentCacheTest, Eviction) {
+  auto& cache = DecompressedSegmentCache::get();
+  cache.replace_cache_impl<LRUKCache<2, DecompressedBlockKey, DecompressedSegmentCache::Block>>(4 * block_size);
+  EXPECT_EQ(cache.shard_count(), 1u);
+  auto decompression_count = size_t{0};
+
+  const auto block = cache.get_or_decompress({1, 0}, decompress_with('a', decompression_count));
+  cache.get_or_decompress({1, 1}, decompress_with('b', decompression_count));
+  cache.get_or_decompress({1, 2}, decompress_with('c', decompression_count));
+  cache.get_or_decompress({1, 0}, decompress_with('a', decompression_count));
+  cache.get_or_decompress({1, 3}, decompress_with('d', decompression_count));
+  EXPECT_EQ(cache.size(), 4u);
+  EXPECT_EQ(cache.metrics().evictions, 0u);
+
+  // Exceeding the capacity evicts blocks until the cache is filled to the eviction threshold. LRU-2 evicts the blocks
+  // that were accessed once, the oldest first.
+  cache.get_or_decompress({1, 4}, decompress_with('e', decompression_count));
+  EXPECT_EQ(cache.size(), 3u);
+  EXPECT_EQ(cache.size_in_bytes(), 3 * block_size);
+  EXPECT_EQ(cache.metrics().evictions, 2u);
+
+  // Evicted blocks remain valid for their readers
+  EXPECT_EQ(block->at(0), 'a');
+
+  cache.resize(block_size);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.metrics().evictions, 4u);
+  cache.get_or_decompress({1, 0}, decompress_with('x', decompression_count));
+  EXPECT_EQ(cache.metrics().hits, 2u);
+}
+
+TEST_F(DecompressedSegmentCacheTest, BoundedByBytes) {
+  auto& cache = DecompressedSegmentCache::get();
+  cache.resize(10 * block_size + block_size / 2);
+  auto decompression_count = size_t{0};
+
+  for (auto block_index = size_t{0}; block_index < 100; ++block_index) {
+    cache.get_or_decompress({1, block_index}, decompress_with('a', decompression_count));
+    EXPECT_LE(cache.size_in_bytes(), cache.capacity());
+  }
+  EXPECT_EQ(cache.size_in_bytes(), cache.size() * block_size);
+  EXPECT_EQ(cache.metrics().evictions, 100 - cache.size());
+
+  // Blocks that exceed the capacity of their shard are not cached
+  const auto large_block = cache.get_or_decompress({2, 0}, [](std::vector<char>& block) { block.resize(1'000); });
+  EXPECT_EQ(large_block->size(), 1'000u);
+  EXPECT_LE(cache.size_in_bytes(), cache.capacity());
+}
+
+TEST_F(DecompressedSegmentCacheTest, Sharding) {
+  auto& cache = DecompressedSegmentCache::get();
+  EXPECT_EQ(cache.shard_count(), DecompressedSegmentCache::MAX_SHARD_COUNT);
+
+  auto decompression_count = size_t{0};
+  for (auto block_index = size_t{0}; block_index < 100; ++block_index) {
+    cache.get_or_decompress({1, block_index}, decompress_with('a', decompression_count));
+  }
+  EXPECT_EQ(cache.size(), 100u);
+
+  // Changing the number of shards drops the cached blocks
+  cache.resize(DecompressedSegmentCache::MIN_SHARD_CAPACITY);
+  EXPECT_EQ(cache.shard_count(), 1u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(DecompressedSegmentCacheTest, Disabled) {
+  auto& cache = DecompressedSegmentCache::get();
+  cache.resize(0);
+  EXPECT_FALSE(cache.is_enabled());
+
+  auto decompression_count = size_t{0};
+  cache.get_or_decompress({1, 0}, decompress_with('a', decompression_count));
+  cache.get_or_decompress({1, 0}, decompress_with('a', decompression_count));
+
+  EXPECT_EQ(decompression_count, 2u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(DecompressedSegmentCacheTest, LZ4PointAccess) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  for (auto row = 0; row < 20'000; ++row) {
+    value_segment->append(row);
+  }
+
+  const auto segment = encode_segment(EncodingType::LZ4, DataType::Int, value_segment);
+  const auto& lz4_segment = static_cast<const LZ4Segment<int32_t>&>(*segment);
+
+  EXPECT_EQ(lz4_segment.get_typed_value(ChunkOffset{10}), 10);
+  EXPECT_EQ(lz4_segment.get_typed_value(ChunkOffset{11}), 11);
+  EXPECT_EQ(lz4_segment.get_typed_value(ChunkOffset{19'999}), 19'999);
+
+  const auto metrics = DecompressedSegmentCache::get().metrics();
+  EXPECT_EQ(metrics.misses, 2u);
+  EXPECT_EQ(metrics.hits, 1u);
+
+  // Decompressing the whole segment bypasses the cache
+  ASSERT_GT(lz4_segment.lz4_blocks().size(), 2u);
+  const auto values = lz4_segment.decompress();
+  EXPECT_EQ(values[12'345], 12'345);
+  EXPECT_EQ(DecompressedSegmentCache::get().metrics().hits, 1u);
+  EXPECT_EQ(DecompressedSegmentCache::get().metrics().misses, 2u);
+  EXPECT_EQ(DecompressedSegmentCache::get().size(), 2u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/chunk.hpp"
+#include "storage/decompressed_segment_cache.hpp"
+#include "storage/encoding_advisor.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class EncodingAdvisorTest : public BaseTest {
+ protected:
+  // 100'000 rows with runs of 1'000 equal values
+  static std::shared_ptr<ValueSegment<int32_t>> create_runs_segment() {
+    auto values = std::vector<int32_t>(100'000);
+    for (auto row = size_t{0}; row < values.size(); ++row) {
+      values[row] = static_cast<int32_t>(row / 1'000);
+    }
+    return std::make_shared<ValueSegment<int32_t>>(std::move(values));
+  }
+
+  static bool contains_encoding(const SegmentEncodingDecision& decision, const EncodingType encoding_type) {
+    return std::any_of(decision.candidates.cbegin(), decision.candidates.cend(),
+                       [&](const auto& candidate) { return candidate.spec.encoding_type == encoding_type; });
+  }
+};
+
+TEST_F(EncodingAdvisorTest, ConsidersSupportedEncodings) {
+  const auto int_decision = EncodingAdvisor{}.advise_segment(create_runs_segment());
+
+  EXPECT_TRUE(contains_encoding(int_decision, EncodingType::Unencoded));
+  EXPECT_TRUE(contains_encoding(int_decision, EncodingType::Dictionary));
+  EXPECT_TRUE(contains_encoding(int_decision, EncodingType::RunLength));
+  EXPECT_TRUE(contains_encoding(int_decision, EncodingType::FrameOfReference));
+  EXPECT_TRUE(contains_encoding(int_decision, EncodingType::LZ4));
+  EXPECT_FALSE(contains_encoding(int_decision, EncodingType::FixedStringDictionary));
+
+  // Dictionary and FrameOfReference are evaluated with both vector compression types
+  EXPECT_EQ(int_decision.candidates.size(), 7u);
+
+  const auto string_segment = std::make_shared<ValueSegment<pmr_string>>(std::vector<pmr_string>{"a", "b", "a"});
+  const auto string_decision = EncodingAdvisor{}.advise_segment(string_segment);
+
+  EXPECT_TRUE(contains_encoding(string_decision, EncodingType::FixedStringDictionary));
+  EXPECT_FALSE(contains_encoding(string_decision, EncodingType::FrameOfReference));
+}
+
+TEST_F(EncodingAdvisorTest, ScanTimeOfLZ4IsMeasuredWithoutCache) {
+  auto& cache = DecompressedSegmentCache::get();
+  cache.reset_metrics();
+
+  // If the sample's blocks were cached, all but the first scan would hit the cache and LZ4 would appear as fast as
+  // an unencoded segment
+  const auto decision = EncodingAdvisor{}.advise_segment(create_runs_segment());
+  EXPECT_TRUE(contains_encoding(decision, EncodingType::LZ4));
+
+  const auto metrics = cache.metrics();
+  EXPECT_EQ(metrics.hits, 0u);
+  EXPECT_EQ(metrics.misses, 0u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(EncodingAdvisorTest, MemoryWeight) {
+  const auto segment = create_runs_segment();
+
+  const auto smallest_decision = EncodingAdvisor{1.0f}.advise_segment(segment);
+  for (const auto& candidate : smallest_decision.candidates) {
+    EXPECT_LE(smallest_decision.chosen.memory_usage, candidate.memory_usage);
+  }
+
+  const auto fastest_decision = EncodingAdvisor{0.0f}.advise_segment(segment);
+  for (const auto& candidate : fastest_decision.candidates) {
+    EXPECT_LE(fastest_decision.chosen.scan_time, candidate.scan_time);
+  }
+
+  // Runs of equal values are best stored using RunLength
+  EXPECT_EQ(smallest_decision.chosen.spec.encoding_type, EncodingType::RunLength);
+}
+
+TEST_F(EncodingAdvisorTest, EstimatesAreExtrapolated) {
+  const auto segment = create_runs_segment();
+  const auto decision = EncodingAdvisor{0.5f, 1'000}.advise_segment(segment);
+
+  // The unencoded candidate's memory usage scales with the number of rows
+  const auto unencoded = std::find_if(decision.candidates.cbegin(), decision.candidates.cend(), [](const auto& c) {
+    return c.spec.encoding_type == EncodingType::Unencoded;
+  });
+  ASSERT_NE(unencoded, decision.candidates.cend());
+  EXPECT_GE(unencoded->memory_usage, segment->size() * sizeof(int32_t));
+}
+
+TEST_F(EncodingAdvisorTest, AdviseChunk) {
+  const auto nullable_segment =
+      std::make_shared<ValueSegment<int32_t>>(std::vector<int32_t>{1, 0, 3}, std::vector<bool>{false, true, false});
+  const auto chunk = std::make_shared<Chunk>(Segments{create_runs_segment(), nullable_segment});
+
+  const auto decisions = EncodingAdvisor{}.advise_chunk(*chunk);
+  ASSERT_EQ(decisions.size(), 2u);
+
+  const auto chunk_encoding_spec = EncodingAdvisor::to_chunk_encoding_spec(decisions);
+  ASSERT_EQ(chunk_encoding_spec.size(), 2u);
+  EXPECT_EQ(chunk_encoding_spec[0].encoding_type, decisions[0].chosen.spec.encoding_type);
+  EXPECT_EQ(chunk_encoding_spec[1].encoding_type, decisions[1].chosen.spec.encoding_type);
+}
+
+}  // namespace opossum
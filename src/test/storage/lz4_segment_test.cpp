@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 
 #include "storage/chunk_encoder.hpp"
+#include "storage/lz4/lz4_iterable.hpp"
 #include "storage/lz4_segment.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "storage/value_segment.hpp"
@@ -146,4 +147,79 @@ TEST_F(StorageLZ4SegmentTest, CompressSingleCharSegmentString) {
   EXPECT_EQ((*offsets)[5], 0);
 }
 
+TEST_F(StorageLZ4SegmentTest, CompressMultipleBlocksInt) {
+  // 20'000 integers take up 80'000 bytes and are thus split into several blocks
+  auto vs_int = std::make_shared<ValueSegment<int32_t>>(true);
+  for (auto row = 0; row < 20'000; ++row) {
+    if (row % 7 == 0) {
+      vs_int->append(NULL_VALUE);
+    } else {
+      vs_int->append(row % 1'000);
+    }
+  }
+
+  auto segment = encode_segment(EncodingType::LZ4, DataType::Int, vs_int);
+  auto lz4_segment = std::dynamic_pointer_cast<LZ4Segment<int32_t>>(segment);
+
+  EXPECT_EQ(lz4_segment->size(), 20'000u);
+  EXPECT_GT(lz4_segment->lz4_blocks().size(), 1u);
+  EXPECT_FALSE(lz4_segment->dictionary().empty());
+
+  const auto decompressed_data = lz4_segment->decompress();
+  ASSERT_EQ(decompressed_data.size(), 20'000u);
+
+  for (auto row = ChunkOffset{0}; row < 20'000; ++row) {
+    if (row % 7 == 0) {
+      EXPECT_FALSE(lz4_segment->get_typed_value(row));
+    } else {
+      EXPECT_EQ(decompressed_data[row], static_cast<int32_t>(row % 1'000));
+      EXPECT_EQ(*lz4_segment->get_typed_value(row), static_cast<int32_t>(row % 1'000));
+    }
+  }
+
+  // Access a few positions from different blocks, some of them repeatedly
+  auto position_filter = std::make_shared<PosList>();
+  for (const auto row : {ChunkOffset{19'999}, ChunkOffset{1}, ChunkOffset{2}, ChunkOffset{7}, ChunkOffset{10'001},
+                         ChunkOffset{2}}) {
+    position_filter->emplace_back(RowID{ChunkID{0}, row});
+  }
+  position_filter->guarantee_single_chunk();
+
+  auto values = std::vector<std::optional<int32_t>>{};
+  LZ4Iterable<int32_t>{*lz4_segment}.with_iterators(position_filter, [&](auto it, const auto end) {
+    for (; it != end; ++it) {
+      values.emplace_back(it->is_null() ? std::nullopt : std::optional<int32_t>{it->value()});
+    }
+  });
+
+  const auto expected_values = std::vector<std::optional<int32_t>>{std::nullopt, 1, 2, std::nullopt, 1, 2};
+  EXPECT_EQ(values, expected_values);
+}
+
+TEST_F(StorageLZ4SegmentTest, CompressMultipleBlocksString) {
+  // Strings of growing length, so that some of them span block boundaries
+  auto expected_values = std::vector<pmr_string>{};
+  for (auto row = 0; row < 1'000; ++row) {
+    expected_values.emplace_back(pmr_string(row % 100, static_cast<char>('a' + row % 26)));
+    vs_str->append(expected_values.back());
+  }
+  // A single string that is larger than a block
+  expected_values.emplace_back(pmr_string(40'000, 'z'));
+  vs_str->append(expected_values.back());
+
+  auto segment = encode_segment(EncodingType::LZ4, DataType::String, vs_str);
+  auto lz4_segment = std::dynamic_pointer_cast<LZ4Segment<pmr_string>>(segment);
+
+  EXPECT_GT(lz4_segment->lz4_blocks().size(), 1u);
+  EXPECT_EQ(lz4_segment->decompress(), std::vector<pmr_string>(expected_values.begin(), expected_values.end()));
+
+  auto cached_block = std::shared_ptr<const std::vector<char>>{};
+  auto cached_block_index = std::optional<size_t>{};
+  for (auto row = ChunkOffset{0}; row < expected_values.size(); ++row) {
+    const auto [value, block_index] = lz4_segment->decompress(row, cached_block_index, cached_block);
+    EXPECT_EQ(value, expected_values[row]);
+    cached_block_index = block_index;
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/get_table.hpp"
+#include "operators/index_scan.hpp"
+#include "operators/insert.hpp"
+#include "operators/join_index.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/index/table_hash_index.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class TableHashIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // int_int2.tbl holds (7, 0), (2, 5) in the first and (6, 16), (2, 5) in the second chunk
+    _table = load_table("resources/test_data/tbl/int_int2.tbl", 2);
+    StorageManager::get().add_table("table", _table);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(TableHashIndexTest, LookupExistingRows) {
+  const auto hash_index = _table->create_hash_index({ColumnID{0}});
+  EXPECT_EQ(_table->get_hash_index({ColumnID{0}}), hash_index);
+  EXPECT_EQ(_table->get_hash_index({ColumnID{1}}), nullptr);
+  EXPECT_EQ(hash_index->size(), 4u);
+
+  EXPECT_EQ(hash_index->lookup({7}), PosList({RowID{ChunkID{0}, ChunkOffset{0}}}));
+  EXPECT_EQ(hash_index->lookup({6}), PosList({RowID{ChunkID{1}, ChunkOffset{0}}}));
+  EXPECT_TRUE(hash_index->lookup({3}).empty());
+  EXPECT_TRUE(hash_index->lookup({NullValue{}}).empty());
+
+  auto matches = hash_index->lookup({2});
+  std::sort(matches.begin(), matches.end());
+  EXPECT_EQ(matches, PosList({RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{1}}}));
+
+  // Values of a different type are cast to the column's type
+  EXPECT_EQ(hash_index->lookup({int64_t{7}}), PosList({RowID{ChunkID{0}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableHashIndexTest, CompositeKey) {
+  const auto hash_index = _table->create_hash_index({ColumnID{0}, ColumnID{1}});
+  EXPECT_EQ(hash_index->lookup({6, 16}), PosList({RowID{ChunkID{1}, ChunkOffset{0}}}));
+  EXPECT_EQ(hash_index->lookup({2, 5}).size(), 2u);
+  EXPECT_TRUE(hash_index->lookup({2, 0}).empty());
+}
+
+TEST_F(TableHashIndexTest, NullsAreNotIndexed) {
+  const auto table = load_table("resources/test_data/tbl/int_int_w_null_8_rows.tbl", 3);
+
+  EXPECT_EQ(table->create_hash_index({ColumnID{0}})->size(), 7u);
+  EXPECT_EQ(table->create_hash_index({ColumnID{0}, ColumnID{1}})->size(), 5u);
+}
+
+TEST_F(TableHashIndexTest, MaintainedByAppendAndInsert) {
+  const auto hash_index = _table->create_hash_index({ColumnID{0}});
+
+  _table->append({9, 9});
+  EXPECT_EQ(hash_index->lookup({9}), PosList({RowID{ChunkID{2}, ChunkOffset{0}}}));
+
+  const auto values = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int2.tbl"));
+  values->execute();
+
+  // A rolled back insert removes its rows from the index
+  const auto rolled_back_insert = std::make_shared<Insert>("table", values);
+  auto context = TransactionManager::get().new_transaction_context();
+  rolled_back_insert->set_transaction_context(context);
+  rolled_back_insert->execute();
+  EXPECT_EQ(hash_index->lookup({6}).size(), 2u);
+  context->rollback();
+  EXPECT_EQ(hash_index->lookup({6}).size(), 1u);
+
+  const auto insert = std::make_shared<Insert>("table", values);
+  context = TransactionManager::get().new_transaction_context();
+  insert->set_transaction_context(context);
+  insert->execute();
+  context->commit();
+
+  EXPECT_EQ(hash_index->lookup({6}).size(), 2u);
+  EXPECT_EQ(hash_index->size(), 9u);
+}
+
+TEST_F(TableHashIndexTest, IndexScanUsesHashIndex) {
+  _table->create_hash_index({ColumnID{0}});
+
+  const auto get_table = std::make_shared<GetTable>("table");
+  get_table->execute();
+
+  // No chunk index exists, so the scan can only succeed by using the hash index
+  const auto index_scan = std::make_shared<IndexScan>(get_table, SegmentIndexType::Invalid, std::vector{ColumnID{0}},
+                                                      PredicateCondition::Equals, std::vector<AllTypeVariant>{6});
+  index_scan->execute();
+
+  const auto& output = index_scan->get_output();
+  ASSERT_EQ(output->row_count(), 1u);
+  EXPECT_EQ(output->chunk_count(), 1u);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{1}, 0u), 16);
+}
+
+TEST_F(TableHashIndexTest, IndexScanWithoutHashIndexScansChunks) {
+  _table->create_hash_index({ColumnID{0}});
+
+  // The plan is built for the hash index, but the stored table is replaced by one without it before the plan runs
+  const auto get_table = std::make_shared<GetTable>("table");
+  const auto index_scan = std::make_shared<IndexScan>(get_table, SegmentIndexType::Invalid, std::vector{ColumnID{0}},
+                                                      PredicateCondition::Equals, std::vector<AllTypeVariant>{2});
+  index_scan->set_stored_table_name("table");
+
+  StorageManager::get().drop_table("table");
+  StorageManager::get().add_table("table", load_table("resources/test_data/tbl/int_int2.tbl", 2));
+
+  get_table->execute();
+  index_scan->execute();
+
+  const auto& output = index_scan->get_output();
+  ASSERT_EQ(output->row_count(), 2u);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{1}, 0u), 5);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{1}, 1u), 5);
+}
+
+TEST_F(TableHashIndexTest, IndexScanUsesHashIndexOfPrunedTable) {
+  _table->create_hash_index({ColumnID{0}});
+
+  // The pruned copy returned by GetTable has no hash index, so the one of the stored table is used
+  const auto get_table = std::make_shared<GetTable>("table");
+  get_table->set_excluded_chunk_ids({ChunkID{0}});
+  get_table->execute();
+  EXPECT_EQ(get_table->get_output()->get_hash_index({ColumnID{0}}), nullptr);
+
+  const auto index_scan = std::make_shared<IndexScan>(get_table, SegmentIndexType::Invalid, std::vector{ColumnID{0}},
+                                                      PredicateCondition::Equals, std::vector<AllTypeVariant>{2});
+  index_scan->set_stored_table_name("table");
+  index_scan->execute();
+
+  // Only the row of the second chunk remains. It is referenced as part of the first chunk of the pruned table.
+  const auto& output = index_scan->get_output();
+  ASSERT_EQ(output->row_count(), 1u);
+  EXPECT_EQ(output->get_value<int32_t>(ColumnID{1}, 0u), 5);
+  const auto reference_segment =
+      std::static_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  EXPECT_EQ(reference_segment->referenced_table(), get_table->get_output());
+  EXPECT_EQ(reference_segment->pos_list()->front(), RowID(ChunkID{0}, ChunkOffset{1}));
+
+  // The same holds for a reference input
+  const auto table_scan = create_table_scan(get_table, ColumnID{1}, PredicateCondition::GreaterThan, 0);
+  table_scan->execute();
+  const auto reference_index_scan = std::make_shared<IndexScan>(
+      table_scan, SegmentIndexType::Invalid, std::vector{ColumnID{0}}, PredicateCondition::Equals,
+      std::vector<AllTypeVariant>{6});
+  reference_index_scan->set_stored_table_name("table");
+  reference_index_scan->execute();
+  ASSERT_EQ(reference_index_scan->get_output()->row_count(), 1u);
+  EXPECT_EQ(reference_index_scan->get_output()->get_value<int32_t>(ColumnID{1}, 0u), 16);
+}
+
+TEST_F(TableHashIndexTest, JoinIndexUsesHashIndex) {
+  _table->create_hash_index({ColumnID{0}});
+
+  const auto left = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int3.tbl", 3));
+  left->execute();
+  const auto right = std::make_shared<GetTable>("table");
+  right->execute();
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  const auto join = std::make_shared<JoinIndex>(left, right, JoinMode::Left, primary_predicate);
+  join->execute();
+
+  const auto& performance_data = static_cast<const JoinIndex::PerformanceData&>(join->performance_data());
+  EXPECT_EQ(performance_data.chunks_scanned_without_index, 0u);
+
+  // Compare to the nested loop join using the same table without a hash index
+  const auto reference_right = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int_int2.tbl", 2));
+  reference_right->execute();
+  const auto reference_join =
+      std::make_shared<JoinNestedLoop>(left, reference_right, JoinMode::Left, primary_predicate);
+  reference_join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), reference_join->get_output());
+}
+
+}  // namespace opossum
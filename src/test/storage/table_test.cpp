@@ -180,6 +180,24 @@ TEST_F(StorageTableTest, MemoryUsageEstimation) {
             empty_memory_usage + 2 * (sizeof(int) + sizeof(pmr_string)) + sizeof(TransactionID) + 2 * sizeof(CommitID));
 }
 
+TEST_F(StorageTableTest, RemovedChunks) {
+  t->append({4, "Hello,"});
+  t->append({6, "world"});
+  t->append({3, "!"});
+  const auto memory_usage = t->estimate_memory_usage();
+
+  const auto chunk = t->get_chunk(ChunkID{0});
+  chunk->increase_invalid_row_count(chunk->size());
+  t->remove_chunk(ChunkID{0});
+
+  // The removed chunk keeps its ChunkID, but is skipped by functions that iterate over all chunks
+  EXPECT_EQ(t->chunk_count(), 2u);
+  EXPECT_EQ(t->get_chunk(ChunkID{0}), nullptr);
+  EXPECT_EQ(t->row_count(), 1u);
+  EXPECT_LT(t->estimate_memory_usage(), memory_usage);
+  EXPECT_EQ(t->get_value<int32_t>(ColumnID{0}, 0u), 3);
+}
+
 TEST_F(StorageTableTest, StableChunks) {
   // Tests that pointers to a chunk remain valid even if the table grows (#1463)
   auto table = std::make_shared<Table>(column_definitions, TableType::Data, 1);
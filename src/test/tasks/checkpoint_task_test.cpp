@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_manager.hpp"
+#include "logging/logger.hpp"
+#include "logging/recovery.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "sql/sql_plan_cache.hpp"
+#include "storage/base_dictionary_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "tasks/checkpoint_task.hpp"
+#include "utils/filesystem.hpp"
+
+namespace opossum {
+
+class CheckpointTaskTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = load_table("resources/test_data/tbl/int_float.tbl", 2u);
+    ChunkEncoder::encode_chunks(_table, {ChunkID{0}}, SegmentEncodingSpec{EncodingType::Dictionary});
+    StorageManager::get().add_table("int_float", _table);
+  }
+
+  void TearDown() override {
+    if (Logger::get().is_enabled()) Logger::get().disable();
+    filesystem::remove_all(checkpoint_directory);
+    std::remove(log_file_path.c_str());
+  }
+
+  static std::shared_ptr<const Table> execute_sql(const std::string& sql) {
+    auto sql_pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    return sql_pipeline.get_result_table();
+  }
+
+  static void restart() {
+    if (Logger::get().is_enabled()) Logger::get().disable();
+
+    StorageManager::reset();
+    TransactionManager::reset();
+    SQLQueryResultCache::get().clear();
+  }
+
+  const std::string checkpoint_directory = test_data_path + "checkpoint_test";
+  const std::string log_file_path = test_data_path + "checkpoint_test.log";
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(CheckpointTaskTest, WriteAndLoadCheckpoint) {
+  execute_sql("INSERT INTO int_float VALUES (1, 1.5)");
+  execute_sql("DELETE FROM int_float WHERE a = 123");
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+
+  // An insert that has not committed when the checkpoint is taken is not part of it
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto sql_pipeline = SQLPipelineBuilder{"INSERT INTO int_float VALUES (2, 2.5)"}
+                          .with_transaction_context(transaction_context)
+                          .create_pipeline();
+  sql_pipeline.get_result_table();
+
+  auto checkpoint_task = std::make_shared<CheckpointTask>(checkpoint_directory);
+  checkpoint_task->execute();
+  const auto snapshot_commit_id = checkpoint_task->snapshot_commit_id();
+  EXPECT_EQ(snapshot_commit_id, transaction_context->snapshot_commit_id());
+  transaction_context->commit();
+
+  const auto chunk_count = _table->chunk_count();
+  restart();
+
+  EXPECT_EQ(CheckpointTask::load_checkpoint(checkpoint_directory), snapshot_commit_id);
+  EXPECT_GE(TransactionManager::get().last_commit_id(), snapshot_commit_id);
+
+  const auto table = StorageManager::get().get_table("int_float");
+  EXPECT_EQ(table->chunk_count(), chunk_count);
+  const auto segment = table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BaseDictionarySegment>(segment));
+  EXPECT_FALSE(table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+}
+
+TEST_F(CheckpointTaskTest, RecoverLogTail) {
+  Logger::get().enable(log_file_path);
+  execute_sql("INSERT INTO int_float VALUES (1, 1.5)");
+
+  auto checkpoint_task = std::make_shared<CheckpointTask>(checkpoint_directory);
+  checkpoint_task->execute();
+
+  // Only these transactions have to be replayed from the log
+  execute_sql("INSERT INTO int_float VALUES (2, 2.5)");
+  execute_sql("DELETE FROM int_float WHERE a = 123 OR a = 1");
+  const auto expected_table = execute_sql("SELECT * FROM int_float");
+
+  restart();
+
+  const auto snapshot_commit_id = CheckpointTask::load_checkpoint(checkpoint_directory);
+  EXPECT_EQ(recover_from_log(log_file_path, snapshot_commit_id), 2u);
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table);
+
+  // New transactions commit after the recovered ones, so that a later recovery can tell them apart
+  Logger::get().enable(log_file_path);
+  execute_sql("INSERT INTO int_float VALUES (3, 3.5)");
+  const auto expected_table_after_restart = execute_sql("SELECT * FROM int_float");
+
+  restart();
+
+  CheckpointTask::load_checkpoint(checkpoint_directory);
+  EXPECT_EQ(recover_from_log(log_file_path, snapshot_commit_id), 3u);
+  EXPECT_TABLE_EQ_UNORDERED(execute_sql("SELECT * FROM int_float"), expected_table_after_restart);
+}
+
+TEST_F(CheckpointTaskTest, IncompleteCheckpoint) {
+  filesystem::create_directories(checkpoint_directory);
+  EXPECT_THROW(CheckpointTask::load_checkpoint(checkpoint_directory), std::logic_error);
+}
+
+}  // namespace opossum
@@ -9,7 +9,9 @@
 #include "operators/get_table.hpp"
 #include "operators/insert.hpp"
 #include "operators/validate.hpp"
+#include "storage/base_encoded_segment.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/encoding_advisor.hpp"
 #include "storage/storage_manager.hpp"
 #include "tasks/chunk_compression_task.hpp"
 
@@ -110,4 +112,35 @@ TEST_F(ChunkCompressionTaskTest, CompressionWithAbortedInsert) {
   EXPECT_EQ(validate->get_output()->row_count(), 12u);
 }
 
+TEST_F(ChunkCompressionTaskTest, CompressionUsingEncodingAdvisor) {
+  auto table = load_table("resources/test_data/tbl/compression_input.tbl", 6u);
+
+  auto table_advised = load_table("resources/test_data/tbl/compression_input.tbl", 6u);
+  StorageManager::get().add_table("table_advised", table_advised);
+
+  auto compression = std::make_unique<ChunkCompressionTask>("table_advised", std::vector<ChunkID>{ChunkID{0}},
+                                                            EncodingAdvisor{1.0f});
+  compression->execute();
+
+  ASSERT_TRUE(check_table_equal(table, table_advised, OrderSensitivity::No, TypeCmpMode::Strict,
+                                FloatComparisonMode::AbsoluteDifference));
+
+  const auto& decisions = compression->encoding_decisions();
+  ASSERT_EQ(decisions.size(), 1u);
+  ASSERT_EQ(decisions.at(ChunkID{0}).size(), 2u);
+
+  const auto chunk = table_advised->get_chunk(ChunkID{0});
+  EXPECT_FALSE(chunk->is_mutable());
+  for (ColumnID column_id{0}; column_id < chunk->column_count(); ++column_id) {
+    const auto& decision = decisions.at(ChunkID{0})[column_id];
+    const auto encoded_segment = std::dynamic_pointer_cast<const BaseEncodedSegment>(chunk->get_segment(column_id));
+    if (decision.chosen.spec.encoding_type == EncodingType::Unencoded) {
+      EXPECT_EQ(encoded_segment, nullptr);
+    } else {
+      ASSERT_NE(encoded_segment, nullptr);
+      EXPECT_EQ(encoded_segment->encoding_type(), decision.chosen.spec.encoding_type);
+    }
+  }
+}
+
 }  // namespace opossum
@@ -80,7 +80,12 @@ TEST_P(TPCHTest, Test) {
    */
   std::shared_ptr<LQPTranslator> lqp_translator;
   if (use_jit) {
+#if HYRISE_JIT_SUPPORT
+    // Compile the pipelines before executing them, so that the compiled code is tested
+    lqp_translator = std::make_shared<JitAwareLQPTranslator>(JitExecutionMode::Compile);
+#else
     lqp_translator = std::make_shared<JitAwareLQPTranslator>();
+#endif
   } else {
     lqp_translator = std::make_shared<LQPTranslator>();
   }